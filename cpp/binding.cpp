@@ -1,5 +1,9 @@
 #include <napi.h>
+#include <sstream>
 #include "include/utils/Logger.h"
+#include "include/utils/handle_diagnostics.h"
+#include "include/common/executor_pool.h"
+#include "include/odbc/async_poller.h"
 #include "include/js/Connection.h"
 #include "include/common/platform.h"
 
@@ -54,6 +58,81 @@ static Napi::Value SetLogFile(const Napi::CallbackInfo &info)
   return env.Undefined();
 }
 
+// setHandleDiagnostics(enabled, sampleEvery, capacity)
+static Napi::Value SetHandleDiagnostics(const Napi::CallbackInfo &info)
+{
+  const Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBoolean())
+  {
+    Napi::TypeError::New(env, "Boolean expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const bool enabled = info[0].As<Napi::Boolean>().Value();
+  const auto sampleEvery = info.Length() > 1 && info[1].IsNumber()
+                               ? info[1].As<Napi::Number>().Uint32Value()
+                               : 1;
+  const auto capacity = info.Length() > 2 && info[2].IsNumber()
+                            ? info[2].As<Napi::Number>().Uint32Value()
+                            : mssql::HandleDiagnostics::default_capacity;
+  mssql::HandleDiagnostics::GetInstance().Configure(enabled, sampleEvery, capacity);
+  return env.Undefined();
+}
+
+static Napi::Value GetHandleEvents(const Napi::CallbackInfo &info)
+{
+  const Napi::Env env = info.Env();
+  const auto events = mssql::HandleDiagnostics::GetInstance().Events();
+  auto result = Napi::Array::New(env, events.size());
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    const auto &event = events[i];
+    std::ostringstream handle;
+    handle << event.handle;
+    auto o = Napi::Object::New(env);
+    o.Set("sequence", Napi::Number::New(env, static_cast<double>(event.sequence)));
+    o.Set("kind", Napi::String::New(env, mssql::HandleDiagnostics::KindName(event.kind)));
+    o.Set("name", Napi::String::New(env, event.name));
+    o.Set("handle", Napi::String::New(env, handle.str()));
+    o.Set("timestamp", Napi::Number::New(env, static_cast<double>(event.timestamp_ms)));
+    o.Set("thread", Napi::String::New(env, event.thread));
+    o.Set("stack", Napi::String::New(env, event.stack));
+    result.Set(static_cast<uint32_t>(i), o);
+  }
+  return result;
+}
+
+// setExecutorThreads(count) - the most threads running ODBC calls at once
+static Napi::Value SetExecutorThreads(const Napi::CallbackInfo &info)
+{
+  const Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber() || info[0].As<Napi::Number>().Int32Value() < 1)
+  {
+    Napi::TypeError::New(env, "Positive number expected for thread count").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto &pool = mssql::ExecutorPool::GetInstance();
+  pool.SetMaxThreads(info[0].As<Napi::Number>().Uint32Value());
+  return Napi::Number::New(env, static_cast<double>(pool.MaxThreads()));
+}
+
+// getExecutorStats() - threads started and busy, and statements left polling
+static Napi::Value GetExecutorStats(const Napi::CallbackInfo &info)
+{
+  const Napi::Env env = info.Env();
+  const auto &pool = mssql::ExecutorPool::GetInstance();
+  auto stats = Napi::Object::New(env);
+  stats.Set("maxThreads", Napi::Number::New(env, static_cast<double>(pool.MaxThreads())));
+  stats.Set("threads", Napi::Number::New(env, static_cast<double>(pool.Threads())));
+  stats.Set("busy", Napi::Number::New(env, static_cast<double>(pool.Busy())));
+  stats.Set("polling",
+            Napi::Number::New(env, static_cast<double>(mssql::AsyncPoller::GetInstance().Pending())));
+  return stats;
+}
+
 // Initialize the module
 Napi::Object InitModule(Napi::Env env, Napi::Object exports)
 {
@@ -65,6 +144,10 @@ Napi::Object InitModule(Napi::Env env, Napi::Object exports)
   exports.Set("setLogLevel", Napi::Function::New(env, SetLogLevel));
   exports.Set("enableConsoleLogging", Napi::Function::New(env, EnableConsoleLogging));
   exports.Set("setLogFile", Napi::Function::New(env, SetLogFile));
+  exports.Set("setHandleDiagnostics", Napi::Function::New(env, SetHandleDiagnostics));
+  exports.Set("getHandleEvents", Napi::Function::New(env, GetHandleEvents));
+  exports.Set("setExecutorThreads", Napi::Function::New(env, SetExecutorThreads));
+  exports.Set("getExecutorStats", Napi::Function::New(env, GetExecutorStats));
   return exports;
 }
 
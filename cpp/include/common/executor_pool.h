@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mssql {
+
+/**
+ * @brief Threads for blocking ODBC calls, kept apart from the libuv pool
+ *
+ * Tasks are submitted against a key, normally the connection, and tasks
+ * sharing a key run one at a time in submit order. Any idle thread takes
+ * the next key with work waiting, so one busy connection never holds up
+ * another while a thread is free. Threads are started on demand up to the
+ * limit and then stay parked until the process exits.
+ *
+ * The limit is read from MSNODESQLV8_EXECUTOR_THREADS when first used, or
+ * set with setExecutorThreads, see lib/sql.js.
+ */
+class ExecutorPool {
+ public:
+  using Task = std::function<void()>;
+
+  static constexpr size_t default_threads = 32;
+
+  static ExecutorPool& GetInstance();
+
+  explicit ExecutorPool(size_t max_threads);
+  ~ExecutorPool();
+
+  ExecutorPool(const ExecutorPool&) = delete;
+  ExecutorPool& operator=(const ExecutorPool&) = delete;
+
+  void Submit(const void* key, Task task);
+
+  // a lower limit stops new threads starting, running ones are kept
+  void SetMaxThreads(size_t max_threads);
+  size_t MaxThreads() const;
+  size_t Threads() const;
+  // threads running a task now, for tests and logging
+  size_t Busy() const;
+
+ private:
+  struct Serial {
+    std::deque<Task> tasks;
+    bool scheduled = false;
+  };
+
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_;
+  std::unordered_map<const void*, Serial> serials_;
+  // keys with a task waiting and none running, oldest first
+  std::deque<const void*> ready_;
+  std::vector<std::thread> threads_;
+  size_t max_threads_;
+  size_t idle_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace mssql
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <algorithm>
 
@@ -18,6 +19,29 @@ class NumericUtils {
                                     SQL_NUMERIC_STRUCT& numeric);
 
   static double decode_numeric_struct(const SQL_NUMERIC_STRUCT& numeric);
+
+  // exact conversions for decimal values js cannot hold in a double. the
+  // value is accumulated base 10 into 128 bits and written little endian
+  // straight into val, rounding half away from zero beyond scale. a scale
+  // below zero keeps the digits given. false with error set when the text
+  // is malformed or the value needs more than 38 digits.
+  static bool parse_numeric_string(const char* text,
+                                   size_t len,
+                                   int scale,
+                                   SQL_NUMERIC_STRUCT& numeric,
+                                   const char*& error);
+
+  // a BigInt already multiplied by 10^scale, as its sign and 64 bit words
+  static bool encode_numeric_words(bool negative,
+                                   const uint64_t* words,
+                                   size_t word_count,
+                                   int scale,
+                                   SQL_NUMERIC_STRUCT& numeric,
+                                   const char*& error);
+
+  // raise the scale of an encoded value keeping its value, so a column of
+  // values parsed at their own scale can be bound at the widest one
+  static bool rescale_numeric_struct(SQL_NUMERIC_STRUCT& numeric, int scale, const char*& error);
 };
 
 }  // namespace mssql
\ No newline at end of file
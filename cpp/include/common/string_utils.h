@@ -27,6 +27,8 @@ class StringUtils {
   // Convert between UTF-8 and std::u16string (proper C++11 Unicode strings)
   static std::u16string Utf8ToU16String(const std::string& utf8Str);
   static std::string U16StringToUtf8(const std::u16string& u16Str);
+  // Append UTF-16 code units to an existing UTF-8 buffer without an intermediate string
+  static void AppendUtf16AsUtf8(const uint16_t* str, size_t length, std::string& out);
 
   // Convert SQLWCHAR array to UTF-8 string
   static std::string WideToUtf8(const SQLWCHAR* wideStr, SQLSMALLINT length);
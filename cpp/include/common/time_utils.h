@@ -41,6 +41,21 @@ namespace mssql
         int32_t offset_minutes,
         SQL_SS_TIMESTAMPOFFSET_STRUCT &result);
 
+    // Column forms of the conversions above for epoch milliseconds, e.g. read
+    // from a Float64Array. NaN entries (null) are left untouched. Dates come
+    // from integer civil-from-days arithmetic and the offset is applied once
+    // per column rather than per element.
+    static void toDateStructs(const double *milliseconds, size_t count, int32_t offset_minutes,
+                              SQL_DATE_STRUCT *out);
+    static void toTimeStructs(const double *milliseconds, size_t count, int32_t offset_minutes,
+                              SQL_SS_TIME2_STRUCT *out);
+    static void toTimestampStructs(const double *milliseconds, size_t count, int32_t offset_minutes,
+                                   SQL_TIMESTAMP_STRUCT *out);
+    // the offset is only recorded in the timezone fields, as createTimestampOffsetStruct
+    static void toTimestampOffsetStructs(const double *milliseconds, size_t count,
+                                         int32_t offset_minutes,
+                                         SQL_SS_TIMESTAMPOFFSET_STRUCT *out);
+
   private:
     // Days per month in a normal year (0-based for month indexes 0-12)
     static constexpr int normalYearMonthDays[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
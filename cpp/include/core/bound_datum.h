@@ -29,14 +29,40 @@
 #include <cfloat>
 #endif
 #include "bound_datum_helper.h"
+#include <core/param_stream.h>
 
 namespace mssql {
 using namespace std;
 class QueryOperationParams;
 
+// one parameter of the Int32Array js may attach to a parameter array as
+// "descriptors", see lib/param-descriptor.js. a typed entry replaces the
+// sql_type, precision, scale ... properties of a user typed parameter.
+enum PackedDescriptor : int32_t {
+  packed_kind = 0,
+  packed_sql_type,
+  packed_precision,
+  packed_scale,
+  packed_max_length,
+  packed_offset,
+  packed_flags,
+  packed_stride
+};
+
+enum PackedKind : int32_t { packed_generic = 0, packed_typed = 1 };
+
+enum PackedFlags : int32_t {
+  packed_has_precision = 1,
+  packed_has_scale = 2,
+  packed_has_max_length = 4,
+  packed_has_offset = 8,
+  packed_money = 16
+};
+
 class BoundDatum {
  public:
   bool bind(const Napi::Object& p);
+  bool bind_packed(const Napi::Value& value, const int32_t* descriptor);
   void reserve_column_type(SQLSMALLINT type, size_t& len, const size_t row_count);
 
   bool get_defined_precision() const {
@@ -62,6 +88,34 @@ class BoundDatum {
     return _storage;
   }
 
+  // round a column size taken from the value length up to the first bucket
+  // that holds it, so the server sees one signature for a range of lengths.
+  void apply_size_bucket(const vector<SQLULEN>& buckets);
+
+  // true when next is a single input value of the same type and size which
+  // fits the buffer bound here, so take_value can stand in for a rebind.
+  bool can_take_value(const BoundDatum& next) const;
+  void take_value(BoundDatum& next);
+
+  // a streamed value is sent with SQLPutData after execute asks for it, the
+  // bound buffer is only the token SQLParamData hands back.
+  bool is_data_at_exec() const {
+    return _stream != nullptr;
+  }
+
+  shared_ptr<ParamStream> get_stream() const {
+    return _stream;
+  }
+
+  // a streamed table parameter, the column bindings are reserved for a batch
+  // of rows which the stream refills each time the driver asks for the table.
+  bool bind_tvp_stream(const Napi::Object& p, const vector<shared_ptr<BoundDatum>>& columns);
+
+  // rows the last batch of a streamed table placed in its column buffers
+  SQLLEN get_stream_rows() const {
+    return _streamRows;
+  }
+
   BoundDatum()
       : js_type(JS_UNKNOWN),
         c_type(0),
@@ -80,6 +134,7 @@ class BoundDatum {
         is_tvp(false),
         is_money(false),
         tvp_no_cols(0),
+        sized_from_value(false),
         definedPrecision(false),
         definedScale(false),
         err(nullptr) {
@@ -124,12 +179,16 @@ class BoundDatum {
   bool is_tvp;
   bool is_money;
   int tvp_no_cols;
+  bool sized_from_value;
   wstring name;
 
  private:
   vector<SQLLEN> _indvec;
   shared_ptr<DatumStorageLegacy> _storage;
   shared_ptr<QueryOperationParams> _params;
+  shared_ptr<ParamStream> _stream;
+  vector<char> _rowBuffer;
+  SQLLEN _streamRows = 0;
   bool definedPrecision;
   bool definedScale;
 
@@ -159,6 +218,9 @@ class BoundDatum {
   void bind_numeric_struct(double d, SQL_NUMERIC_STRUCT& ns);
   void bind_numeric_array(const Napi::Object& p);
   void reserve_numeric(SQLLEN len);
+  bool encode_exact_numeric(const Napi::Value& v, int scale, SQL_NUMERIC_STRUCT& ns);
+  void bind_exact_numeric(const Napi::Value& p);
+  void bind_exact_numeric_array(const Napi::Array& arr);
 
   void bind_int8(const Napi::Object& p);
   void reserve_int8(SQLLEN len);
@@ -193,6 +255,9 @@ class BoundDatum {
   void reserve_double(SQLLEN len);
   void bind_double_array(const Napi::Object& p);
 
+  static const double* epoch_ms_column(const Napi::Object& p, vector<double>& scratch, size_t& len);
+  void set_date_indicators(const double* ms, size_t len, SQLLEN width);
+
   void bind_time(const Napi::Object& p);
   void bind_time_array(const Napi::Object& p);
   void reserve_time(SQLLEN len);
@@ -213,6 +278,11 @@ class BoundDatum {
   void bind_number_array(const Napi::Object& p);
 
   void bind_tvp(const Napi::Object& p);
+  bool bind_data_at_exec(const Napi::Object& p);
+  size_t element_size() const;
+  bool is_var_length() const;
+  bool reserve_rows(size_t rows, size_t width);
+  bool take_rows(const BoundDatum& next, string& error);
 
   void bind_binary(const Napi::Object& p);
   void bind_binary_array(const Napi::Object& p);
@@ -237,6 +307,7 @@ class BoundDatum {
   void bind_var_char(const Napi::Object& p, int precision);
   void reserve_var_char_array(size_t precision, size_t array_len);
   bool user_bind(const Napi::Object& p, const Napi::Object& v);
+  bool bind_typed_value(const Napi::Value& pp);
   void assign_precision(Napi::Object& pv);
 
   void sql_longvarbinary(const Napi::Object pp);
@@ -225,6 +225,7 @@ class DatumStorageLegacy {
 
   wstring schema;
   wstring table;
+  wstring bcp_hints;
 
  private:
 };
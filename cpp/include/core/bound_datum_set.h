@@ -44,6 +44,15 @@ class BoundDatumSet {
   bool reserve(const std::vector<ColumnDefinition>& set, size_t row_count) const;
   bool bind(const Napi::Array& node_params);
   Napi::Array unbind(Napi::Env& env) const;
+  void apply_size_buckets(const std::vector<SQLULEN>& buckets);
+  size_t signature_hash() const;
+  // copy the values of next into the buffers already bound for this set,
+  // false (and nothing copied) when next needs its own SQLBindParameter pass.
+  bool take_values(BoundDatumSet& next);
+  // any parameter streamed in after execute with SQLPutData
+  bool has_data_at_exec() const;
+  // the streamed binding SQLParamData returned token for, nullptr if none
+  std::shared_ptr<BoundDatum> data_at_exec(SQLPOINTER token) const;
   void clear() {
     _bindings->clear();
   }
@@ -77,6 +86,8 @@ class BoundDatumSet {
 
  private:
   bool tvp(Napi::Object& v) const;
+  bool tvp_stream(const std::shared_ptr<BoundDatum>& table, const Napi::Object& v);
+  static const int32_t* packed_descriptors(const Napi::Array& node_params);
   int _output_param_count;
   std::shared_ptr<param_bindings> _bindings;
   std::shared_ptr<QueryOperationParams> _params;
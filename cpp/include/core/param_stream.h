@@ -0,0 +1,79 @@
+#pragma once
+
+#include <platform.h>
+#include <napi.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mssql {
+
+/**
+ * @brief Source of a data at execution parameter, see sql.Stream in lib/user.js
+ *
+ * Wraps the js pull function of a streamed parameter. The statement asks for
+ * chunks from the worker thread once execute returns SQL_NEED_DATA, each call
+ * to Next runs pull on the js thread and waits for it to deliver a buffer, so
+ * only one chunk of the value is held in native memory at a time.
+ *
+ * A sink takes the place of the buffer copy for values which are not bytes,
+ * e.g. a batch of table rows. It runs on the js thread while the worker
+ * waits, so it may write into buffers the driver has bound.
+ *
+ * Created on the js thread when the parameter is bound. A wait for js is
+ * woken every poll interval to ask the caller whether to give up, see Abort,
+ * so a stalled source cannot hold the worker thread for ever.
+ */
+class ParamStream {
+ public:
+  // false with error set rejects the delivered value and fails the stream
+  using Sink = std::function<bool(const Napi::Value& value, std::string& error)>;
+  // true with reason set ends a wait for js and fails the stream
+  using Abort = std::function<bool(std::string& reason)>;
+
+  static constexpr std::chrono::milliseconds poll_interval{100};
+
+  ParamStream(Napi::Env env, Napi::Function pull);
+  ParamStream(Napi::Env env, Napi::Function pull, Sink sink);
+  ~ParamStream();
+
+  ParamStream(const ParamStream&) = delete;
+  ParamStream& operator=(const ParamStream&) = delete;
+
+  /**
+   * @brief Wait for the next chunk of the value
+   * @return false once the stream has ended or failed, see Error
+   */
+  bool Next(std::vector<char>& chunk, const Abort& abort = nullptr);
+
+  /**
+   * @brief Wait for the sink to take the next value
+   * @return false once the stream has ended or failed, see Error
+   */
+  bool Next(const Abort& abort = nullptr);
+
+  bool HasError() const;
+  std::string Error() const;
+
+ private:
+  struct Channel {
+    std::mutex mutex;
+    std::condition_variable ready_cv;
+    bool ready = false;
+    bool done = false;
+    std::string error;
+    std::vector<char> chunk;
+    Sink sink;
+  };
+
+  bool pull_next(const Abort& abort);
+
+  std::shared_ptr<Channel> _channel;
+  Napi::ThreadSafeFunction _pull;
+};
+}  // namespace mssql
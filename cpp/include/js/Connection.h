@@ -43,13 +43,26 @@ class Connection : public Napi::ObjectWrap<Connection> {
   Napi::Value Query(const Napi::CallbackInfo& info);
   Napi::Value FetchRows(const Napi::CallbackInfo& info);
   Napi::Value NextResultSet(const Napi::CallbackInfo& info);
+  Napi::Value Pipeline(const Napi::CallbackInfo& info);
   Napi::Value ReleaseStatement(const Napi::CallbackInfo& info);
+  Napi::Value AbandonStatement(const Napi::CallbackInfo& info);
   Napi::Value CancelQuery(const Napi::CallbackInfo& info);
   Napi::Value CallProc(const Napi::CallbackInfo& info);
   Napi::Value Unbind(const Napi::CallbackInfo& info);
   Napi::Value BeginTransaction(const Napi::CallbackInfo& info);
   Napi::Value Commit(const Napi::CallbackInfo& info);
   Napi::Value Rollback(const Napi::CallbackInfo& info);
+  Napi::Value BcpFile(const Napi::CallbackInfo& info);
+  Napi::Value ExportQuery(const Napi::CallbackInfo& info);
+  Napi::Value ExecuteMany(const Napi::CallbackInfo& info);
+  Napi::Value Transaction(const Napi::CallbackInfo& info);
+  Napi::Value Batch(const Napi::CallbackInfo& info);
+  Napi::Value SetParamSizeBuckets(const Napi::CallbackInfo& info);
+  Napi::Value GetParamSignatureCount(const Napi::CallbackInfo& info);
+  Napi::Value SetStatementCache(const Napi::CallbackInfo& info);
+  Napi::Value GetStatementCacheStats(const Napi::CallbackInfo& info);
+  Napi::Value SetStatementPoolSize(const Napi::CallbackInfo& info);
+  Napi::Value GetStatementPoolStats(const Napi::CallbackInfo& info);
 
   // Generic worker factory for callback/promise handling
   template <typename WorkerType, typename... Args>
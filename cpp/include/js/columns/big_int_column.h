@@ -31,6 +31,14 @@ class BigIntColumn : public Column {
     return Napi::BigInt::New(env, static_cast<int64_t>(value)).As<Napi::Object>();
   }
 
+  inline void AppendText(std::string& out) const override {
+    out += std::to_string(value);
+  }
+
+  inline bool IsTextual() const override {
+    return false;
+  }
+
  private:
   DatumStorageLegacy::bigint_t value;
 };
@@ -16,8 +16,14 @@ class BinaryColumn : public Column {
  public:
   BinaryColumn(const int id, shared_ptr<DatumStorageLegacy> s, size_t l);
   BinaryColumn(const int id, shared_ptr<DatumStorageLegacy> s, size_t offset, size_t l);
+  BinaryColumn(const int id, shared_ptr<DatumStorageLegacy::char_vec_t> s, size_t l);
   Napi::Object ToNative(Napi::Env env) override;
   Napi::Object ToString(Napi::Env env) override;
+  void AppendText(std::string& out) const override;
+  size_t ByteSize() const override {
+    return len;
+  }
+  std::shared_ptr<Column> Detached() const override;
 
  private:
   shared_ptr<DatumStorageLegacy::char_vec_t> storage;
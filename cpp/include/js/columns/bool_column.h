@@ -27,6 +27,14 @@ class BoolColumn : public Column {
     return Napi::Boolean::New(env, value).As<Napi::Object>();
   }
 
+  inline void AppendText(std::string& out) const override {
+    out += value ? "true" : "false";
+  }
+
+  inline bool IsTextual() const override {
+    return false;
+  }
+
  private:
   bool value;
 };
@@ -34,6 +34,23 @@ class CharColumn : public Column {
     return s.As<Napi::Object>();
   }
 
+  inline void AppendText(std::string& out) const override {
+    out.append(storage->data() + offset, size);
+  }
+
+  inline size_t ByteSize() const override {
+    return size;
+  }
+
+  inline std::shared_ptr<Column> Detached() const override {
+    if (!Borrowed()) {
+      return nullptr;
+    }
+    const auto* const begin = storage->data() + offset;
+    auto owned = std::make_shared<DatumStorageLegacy::char_vec_t>(begin, begin + size);
+    return std::make_shared<CharColumn>(Id(), owned, size);
+  }
+
  private:
   size_t size;
   shared_ptr<DatumStorageLegacy::char_vec_t> storage;
@@ -13,7 +13,7 @@ namespace mssql {
 
 class Column {
  public:
-  Column(int id) : _id(id), _asNative(true), _asBigInt(false) {}
+  Column(int id) : _id(id), _asNative(true), _asBigInt(false), _borrowed(false) {}
   virtual ~Column();
 
   virtual Napi::Object ToNative(Napi::Env env) = 0;
@@ -28,6 +28,33 @@ class Column {
 
   virtual Napi::Object ToString(Napi::Env env) = 0;
 
+  // text rendering used by the native export, called on the worker thread so
+  // must not touch the js heap.
+  virtual void AppendText(std::string& out) const = 0;
+  virtual bool IsNull() const {
+    return false;
+  }
+  // numbers and booleans are written unquoted in json
+  virtual bool IsTextual() const {
+    return true;
+  }
+  // rough size of the value held, used to cap rows read ahead for js
+  virtual size_t ByteSize() const {
+    return sizeof(double);
+  }
+  // a copy owning its value for a borrowed column, null when already owned
+  virtual std::shared_ptr<Column> Detached() const {
+    return nullptr;
+  }
+  // the value is viewed in buffers bound to a prepared statement, which the
+  // next fetch or execute overwrites
+  void SetBorrowed() {
+    _borrowed = true;
+  }
+  bool Borrowed() const {
+    return _borrowed;
+  }
+
   int Id() const {
     return _id;
   }
@@ -49,5 +76,6 @@ class Column {
   int _id;
   bool _asNative;
   bool _asBigInt;
+  bool _borrowed;
 };
 }  // namespace mssql
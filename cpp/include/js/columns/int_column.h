@@ -26,6 +26,14 @@ class IntColumn : public Column {
     return Napi::Number::New(env, value).As<Napi::Object>();
   }
 
+  inline void AppendText(std::string& out) const override {
+    out += std::to_string(value);
+  }
+
+  inline bool IsTextual() const override {
+    return false;
+  }
+
  private:
   int64_t value;
 };
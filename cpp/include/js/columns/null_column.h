@@ -22,6 +22,12 @@ class NullColumn : public Column {
     return env.Null().As<Napi::Object>();
   }
 
+  inline void AppendText(std::string&) const override {}
+
+  inline bool IsNull() const override {
+    return true;
+  }
+
  private:
 };
 
@@ -3,6 +3,8 @@
 #include <napi.h>
 
 #include <atomic>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -26,6 +28,20 @@ class NumberColumn : public Column {
     return Napi::Number::New(env, value).As<Napi::Object>();
   }
 
+  // shortest of 15 or 17 significant digits that reads back to the same double
+  inline void AppendText(std::string& out) const override {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.15g", value);
+    if (strtod(buf, nullptr) != value) {
+      snprintf(buf, sizeof(buf), "%.17g", value);
+    }
+    out += buf;
+  }
+
+  inline bool IsTextual() const override {
+    return false;
+  }
+
  private:
   double value;
 };
@@ -43,6 +43,10 @@ class ResultSet {
   size_t get_result_count() const {
     return _rows.size();
   }
+  // rough size of the rows held, see Column::ByteSize
+  size_t byte_size() const;
+  // rows kept past the next fetch own their values, see Column::Detached
+  void detach();
 
   SQLLEN row_count() const {
     return _row_count;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <platform.h>
+#include <common/odbc_common.h>
+#include <odbc/odbc_driver_types.h>
+#include <js/columns/result_set.h>
+
+#include <string>
+#include <vector>
+
+namespace mssql {
+
+// renders fetched rows as csv, tsv or ndjson into a bounded buffer which is
+// flushed to a file descriptor once full. runs entirely on the worker thread.
+class ResultSetWriter {
+ public:
+  ResultSetWriter(const ExportOptions& options);
+
+  // captures the column names and writes the header line when requested
+  bool Start(const std::vector<ColumnDefinition>& metadata);
+  bool WriteRows(const ResultSet& resultset);
+  bool Flush();
+
+  int64_t RowsWritten() const {
+    return _rows;
+  }
+
+  int64_t BytesWritten() const {
+    return _bytes;
+  }
+
+  const std::string& LastError() const {
+    return _error;
+  }
+
+ private:
+  void append_field(const Column& column);
+  void append_csv(const std::string& text);
+  void append_tsv(const std::string& text);
+  void append_json(const std::string& text, std::string& out);
+  char separator() const;
+
+  ExportOptions _options;
+  std::vector<std::string> _names;
+  std::string _buffer;
+  std::string _scratch;
+  int64_t _rows;
+  int64_t _bytes;
+  std::string _error;
+};
+}  // namespace mssql
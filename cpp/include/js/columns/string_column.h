@@ -8,6 +8,7 @@
 #include <mutex>
 #include <string>
 #include <js/columns/column.h>
+#include <common/string_utils.h>
 #include <core/bound_datum_helper.h>
 
 namespace mssql {
@@ -35,6 +36,23 @@ class StringColumn : public Column {
     return Napi::String::New(env, reinterpret_cast<const char16_t*>(sptr), size).As<Napi::Object>();
   }
 
+  inline void AppendText(std::string& out) const override {
+    StringUtils::AppendUtf16AsUtf8(storage->data() + offset, size, out);
+  }
+
+  inline size_t ByteSize() const override {
+    return size * sizeof(uint16_t);
+  }
+
+  inline std::shared_ptr<Column> Detached() const override {
+    if (!Borrowed()) {
+      return nullptr;
+    }
+    const auto* const begin = storage->data() + offset;
+    auto owned = std::make_shared<DatumStorageLegacy::uint16_t_vec_t>(begin, begin + size);
+    return std::make_shared<StringColumn>(Id(), owned, size);
+  }
+
  private:
   size_t size;
   shared_ptr<DatumStorageLegacy::uint16_t_vec_t> storage;
@@ -43,6 +43,9 @@ class TimestampColumn : public Column {
     return AsString(env, milliseconds);
   }
 
+  // iso 8601 in utc with the full 100ns precision of the server
+  void AppendText(std::string& out) const override;
+
   Napi::Object ToNative(Napi::Env env) override {
     auto date = Napi::Date::New(env, milliseconds).As<Napi::Object>();
     date.Set("nanosecondsDelta", nanoseconds_delta / 1e9);
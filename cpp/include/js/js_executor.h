@@ -0,0 +1,54 @@
+#pragma once
+
+#include <platform.h>
+#include <napi.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace mssql {
+
+/**
+ * @brief Runs worker jobs on the ExecutorPool and brings results back to js
+ *
+ * One per env, shared between its instance data and the workers queued on
+ * it, so a pool thread finishing after the env is torn down still holds a
+ * live executor. Every completion is posted through the one thread safe
+ * function held here, which keeps the event loop alive only while work is in
+ * flight. Once the env closes that function, Post drops the completion.
+ */
+class JsExecutor {
+ public:
+  using Job = std::function<void()>;
+
+  static std::shared_ptr<JsExecutor> ForEnv(Napi::Env env);
+
+  explicit JsExecutor(Napi::Env env);
+
+  JsExecutor(const JsExecutor&) = delete;
+  JsExecutor& operator=(const JsExecutor&) = delete;
+
+  // js thread - run job on the pool, in order with others for the same key
+  void Queue(const void* key, Job job);
+  // any thread - run complete on the js thread
+  void Post(Job complete);
+  // js thread - a job queued earlier has delivered its result
+  void Done();
+
+ private:
+  // set under the mutex when the env finalizes completion_, which is then
+  // freed, so a Post holding the mutex never calls into a freed function
+  struct Closing {
+    std::mutex mutex;
+    bool closed = false;
+  };
+
+  Napi::Env env_;
+  std::shared_ptr<Closing> closing_;
+  // closed along with the env, so never released here
+  Napi::ThreadSafeFunction completion_;
+  size_t in_flight_ = 0;
+};
+
+}  // namespace mssql
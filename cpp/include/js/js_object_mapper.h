@@ -70,6 +70,11 @@ class JsObjectMapper {
   // Main mapping methods
   static ProcedureParamMeta toProcedureParamMeta(const Napi::Object& jsObject);
   static QueryOptions toQueryOptions(const Napi::Object& jsObject);
+  static std::shared_ptr<BcpFileOptions> toBcpFileOptions(const Napi::Object& jsObject);
+  static std::shared_ptr<ExportOptions> toExportOptions(const Napi::Object& jsObject);
+  static std::shared_ptr<ExecuteManyOptions> toExecuteManyOptions(const Napi::Object& jsObject);
+  static std::shared_ptr<TransactionOptions> toTransactionOptions(const Napi::Object& jsObject);
+  static std::shared_ptr<BatchOptions> toBatchOptions(const Napi::Object& jsObject);
   static std::shared_ptr<SqlParameter> toSqlParameter(const Napi::Object& jsObject);
   static StatementHandle toStatementHandle(const Napi::Object& jsObject);
   static NativeParam toNativeParam(const Napi::Object& jsObject);
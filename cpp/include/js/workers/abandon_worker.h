@@ -0,0 +1,31 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <odbc/odbc_driver_types.h>
+
+namespace mssql {
+
+/**
+ * @brief Drops what is left of a statement's results without reading them
+ *
+ * The cursor is closed on the worker thread, so the remaining rows and
+ * result sets are never fetched, and unless the statement is kept prepared
+ * it is then released for its handle to be recycled. Used when a reader
+ * stops part way, see Query.abandon in lib/reader.js.
+ */
+class AbandonWorker : public OdbcAsyncWorker {
+ public:
+  AbandonWorker(Napi::Function& callback,
+                IOdbcConnection* connection,
+                const StatementHandle& statementHandle,
+                bool release);
+
+  void Execute() override;
+  void OnOK() override;
+
+ private:
+  StatementHandle statementHandle_;
+  bool release_;
+  bool released_ = false;
+};
+}  // namespace mssql
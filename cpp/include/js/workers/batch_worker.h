@@ -0,0 +1,60 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <js/workers/statement_steps.h>
+#include <odbc/odbc_driver_types.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mssql {
+class BoundDatumSet;
+
+/**
+ * @brief Runs several statements sent as one batch and splits the results
+ *
+ * js joins the statements with a marker result after each, so the batch is
+ * one execute and one round trip. The results are read here and handed to
+ * the statement they belong to, moving on at each marker. A message with a
+ * line number in the batch goes to the statement on that line, otherwise to
+ * the statement being read. After a statement error the server goes on with
+ * the batch and so does the reading, only an aborted batch leaves statements
+ * reported as not run.
+ */
+class BatchWorker : public OdbcAsyncWorker {
+ public:
+  BatchWorker(Napi::Function& callback,
+              IOdbcConnection* connection,
+              const std::shared_ptr<QueryOperationParams> query,
+              const Napi::Array& params,
+              const std::shared_ptr<BatchOptions> options);
+
+  void Execute() override;
+  void OnOK() override;
+
+ private:
+  struct StatementOutcome {
+    bool executed = false;
+    // first result of the statement, none when it returned nothing
+    std::shared_ptr<QueryResult> metadata;
+    std::vector<std::shared_ptr<OdbcError>> errors;
+    // fetches and later results of the statement, see StatementSteps
+    std::unique_ptr<StatementSteps> steps;
+  };
+
+  void read_results(const std::shared_ptr<IOdbcStatement>& statement, bool errored);
+  static bool continues(const std::vector<std::shared_ptr<OdbcError>>& errors);
+  bool is_marker(const QueryResult& result) const;
+  void route(const std::vector<std::shared_ptr<OdbcError>>& errors, size_t current);
+  void ended_at(size_t current);
+  Napi::Object to_value(Napi::Env env, const StatementOutcome& outcome) const;
+
+  std::shared_ptr<QueryOperationParams> query_;
+  std::shared_ptr<BoundDatumSet> parameters_;
+  std::shared_ptr<BatchOptions> options_;
+  std::shared_ptr<QueryResult> result_;
+  std::vector<StatementOutcome> outcomes_;
+  bool has_error_ = false;
+};
+}  // namespace mssql
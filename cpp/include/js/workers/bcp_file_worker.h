@@ -0,0 +1,20 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <odbc/odbc_driver_types.h>
+
+namespace mssql {
+class BcpFileWorker : public OdbcAsyncWorker {
+ public:
+  BcpFileWorker(Napi::Function& callback,
+                IOdbcConnection* connection,
+                const std::shared_ptr<BcpFileOptions> options);
+
+  void Execute() override;
+  void OnOK() override;
+
+ private:
+  std::shared_ptr<BcpFileOptions> options_;
+  int64_t rowsCopied_ = 0;
+};
+}  // namespace mssql
@@ -31,6 +31,11 @@ class CancelWorker : public OdbcAsyncWorker {
     }
   }
 
+  // has to reach a query still running on the connection
+  const void* SerialKey() const override {
+    return this;
+  }
+
   void OnOK() override {
     Napi::Env env = Env();
     Callback().Call({env.Null(), Napi::Boolean::New(env, success_)});
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <js/columns/result_set.h>
+#include <odbc/odbc_driver_types.h>
+
+#include <string>
+#include <vector>
+
+namespace mssql {
+class BoundDatumSet;
+
+class ExecuteManyWorker : public OdbcAsyncWorker {
+ public:
+  ExecuteManyWorker(Napi::Function& callback,
+                    IOdbcConnection* connection,
+                    const int queryId,
+                    const Napi::Array& paramSets,
+                    const std::shared_ptr<ExecuteManyOptions> options);
+
+  void Execute() override;
+  void OnOK() override;
+
+ private:
+  // what one parameter set produced - rows are held until the js callback
+  struct SetOutcome {
+    std::shared_ptr<BoundDatumSet> parameters;
+    std::string bind_error;
+    bool executed = false;
+    SQLLEN row_count = 0;
+    std::vector<ResultSet::t_row> rows;
+    std::vector<std::shared_ptr<OdbcError>> errors;
+  };
+
+  bool execute_set(SetOutcome& outcome);
+  bool read_rows(const std::shared_ptr<IOdbcStatement>& statement, SetOutcome& outcome);
+  Napi::Object to_value(Napi::Env env, const SetOutcome& outcome) const;
+
+  int queryId_;
+  std::shared_ptr<ExecuteManyOptions> options_;
+  std::vector<SetOutcome> outcomes_;
+};
+}  // namespace mssql
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <odbc/odbc_driver_types.h>
+
+#include <chrono>
+
+namespace mssql {
+class BoundDatumSet;
+
+class ExportWorker : public OdbcAsyncWorker {
+ public:
+  ExportWorker(Napi::Function& callback,
+               IOdbcConnection* connection,
+               const std::shared_ptr<QueryOperationParams> q,
+               const Napi::Array& params,
+               const std::shared_ptr<ExportOptions> options,
+               Napi::Function progressCallback = Napi::Function());
+
+  ~ExportWorker();
+
+  void Execute() override;
+  void OnOK() override;
+
+ private:
+  bool set_connection_error(const char* fallback);
+  bool first_result_with_columns(const std::shared_ptr<IOdbcStatement>& statement);
+  void notify_progress(int64_t rows, int64_t bytes);
+
+  std::shared_ptr<QueryOperationParams> queryParams_;
+  std::shared_ptr<BoundDatumSet> parameters_;
+  std::shared_ptr<ExportOptions> options_;
+  Napi::ThreadSafeFunction progress_;
+  bool has_progress_ = false;
+  // the first batch is reported at once, later ones once the interval has passed
+  std::chrono::steady_clock::time_point next_progress_{};
+  bool has_error_ = false;
+  int64_t rows_ = 0;
+  int64_t bytes_ = 0;
+};
+}  // namespace mssql
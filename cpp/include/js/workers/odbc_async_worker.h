@@ -6,6 +6,15 @@
 #include <odbc/odbc_connection.h>
 
 namespace mssql {
+class JsExecutor;
+
+/**
+ * @brief Base for the connection workers, run on the ExecutorPool
+ *
+ * Queue hides the AsyncWorker version: Execute runs on a pool thread in
+ * order with the other work for the same connection, and OnOK or OnError
+ * is called back on the js thread through the JsExecutor for the env.
+ */
 class OdbcAsyncWorker : public Napi::AsyncWorker {
  public:
   OdbcAsyncWorker(Napi::Function& callback, IOdbcConnection* connection)
@@ -15,7 +24,21 @@ class OdbcAsyncWorker : public Napi::AsyncWorker {
 
   virtual ~OdbcAsyncWorker() = default;
 
+  void Queue();
+
  protected:
+  void SetError(const std::string& error);
+
+  // work sharing a key runs one at a time, in the order it was queued
+  virtual const void* SerialKey() const {
+    return connection_;
+  }
+
+  // called from OnOK - the result is delivered later through Resume
+  void Defer();
+  // any thread - deliver a deferred result, OnOK or OnError is called again
+  void Resume();
+
   IOdbcConnection* connection_;
   std::shared_ptr<QueryResult> result_;
   std::vector<std::shared_ptr<OdbcError>> errorDetails_;
@@ -32,5 +55,13 @@ class OdbcAsyncWorker : public Napi::AsyncWorker {
   void OnOK() override = 0;
 
   // Common implementation of OnError that can be overridden if needed
+
+ private:
+  void Run();
+  void Complete();
+
+  std::shared_ptr<JsExecutor> executor_;
+  std::string error_;
+  bool deferred_ = false;  // js thread only
 };
 }  // namespace mssql
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <js/workers/statement_steps.h>
+#include <odbc/odbc_driver_types.h>
+
+#include <string>
+#include <vector>
+
+namespace mssql {
+
+/**
+ * @brief Runs a sequence of statement steps in one trip to the worker thread
+ *
+ * The js reader asks for fetchRows, nextResultSet and release together at
+ * the end of a result. A step only runs when the one before has left the
+ * statement where it would have been called anyway - rows are read to the
+ * end, the next result has no rows of its own - so the chain stops at the
+ * first point js has something to act on. One result per step run is
+ * returned, see Query.dispatch in lib/reader.js.
+ */
+class PipelineWorker : public OdbcAsyncWorker {
+ public:
+  PipelineWorker(Napi::Function& callback,
+                 IOdbcConnection* connection,
+                 const StatementHandle& statementHandle,
+                 const QueryOptions& options,
+                 std::vector<PipelineStep> steps);
+
+  void Execute() override;
+  void OnOK() override;
+
+  static bool ParseStep(const std::string& name, PipelineStep& step);
+
+ private:
+  StatementHandle statementHandle_;
+  QueryOptions options_;
+  std::vector<PipelineStep> steps_;
+  StatementSteps results_;
+};
+}  // namespace mssql
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <js/workers/odbc_async_worker.h>
+#include <js/workers/statement_steps.h>
 #include <odbc/parameter_set.h>
 #include <odbc/odbc_state_notifier.h>
 #include <js/js_state_notifier.h>
 
+#include <memory>
+
 namespace mssql {
 class BoundDatumSet;
 
@@ -20,9 +23,17 @@ class QueryWorker : public OdbcAsyncWorker {
   void OnOK() override;
 
  private:
+  // a polled query still running is finished from the AsyncPoller thread
+  void defer_completion();
+  void complete(const std::shared_ptr<IOdbcStatement>& statement, SQLRETURN ret);
+  // the fetches js would make next, run before leaving the worker thread
+  void read_ahead();
+
   std::shared_ptr<QueryOperationParams> queryParams_;
   std::shared_ptr<BoundDatumSet> parameters_;
   bool has_error_ = false;
+  std::shared_ptr<IOdbcStatement> pending_;
   std::shared_ptr<IOdbcStateNotifier> stateNotifier_;
+  std::unique_ptr<StatementSteps> readAhead_;
 };
 }  // namespace mssql
\ No newline at end of file
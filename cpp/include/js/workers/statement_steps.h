@@ -0,0 +1,87 @@
+#pragma once
+
+#include <napi.h>
+#include <common/odbc_common.h>
+#include <core/query_result.h>
+#include <odbc/odbc_connection.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mssql {
+class BoundDatumSet;
+class IOdbcStatement;
+class ResultSet;
+
+enum class PipelineStep { FetchRows, NextResultSet, Unbind, Release };
+
+/**
+ * @brief Statement calls made on the worker thread on behalf of js
+ *
+ * Each step keeps what js would have been given by the fetchRows,
+ * nextResultSet, unbind or releaseStatement call it stands in for. The
+ * PipelineWorker runs the steps js asks for; the QueryWorker reads ahead
+ * past the execute in the order Query in lib/reader.js would. Either way
+ * js receives one array and replays it, see Query.acceptReadAhead.
+ */
+class StatementSteps {
+ public:
+  StatementSteps(IOdbcConnection* connection, const StatementHandle& statementHandle);
+
+  // true when the rows are read to the end, see Failed for an error
+  bool FetchRows(const std::shared_ptr<IOdbcStatement>& statement, size_t batch_size);
+  // true when the statement has nothing further to read
+  bool NextResultSet();
+  // a next result read by the caller, whose messages it has routed itself
+  void NextResultSet(const std::shared_ptr<QueryResult>& next);
+  void Unbind(int queryId);
+  void Release();
+
+  // every fetch and next result js makes for a statement, stopping at an
+  // error or once more than max_bytes of rows are held. true when the
+  // statement has been read to its end.
+  bool ReadAhead(const std::shared_ptr<IOdbcStatement>& statement,
+                 bool has_columns,
+                 size_t batch_size,
+                 size_t max_bytes);
+
+  bool Empty() const {
+    return steps_.empty();
+  }
+  // the last fetch failed, its errors are those of the last step
+  bool Failed() const {
+    return failed_;
+  }
+  // the last fetch reached the end of the results, no next result to read
+  bool FetchedToEnd() const;
+  // the last next result has info messages or errors for js to route
+  bool HasMessages() const;
+  const std::vector<std::shared_ptr<OdbcError>>& LastErrors() const;
+
+  Napi::Array ToValue(const Napi::Env& env) const;
+
+  // a message js routes as info rather than an error, as Query.isInfo
+  static bool is_info(const OdbcError& error);
+
+ private:
+  struct StepResult {
+    PipelineStep step;
+    // fetchRows - a copy of the rows read, flags as they were after the read
+    std::shared_ptr<ResultSet> rows;
+    // nextResultSet - metadata of the next result
+    std::shared_ptr<QueryResult> next;
+    std::vector<std::shared_ptr<OdbcError>> errors;
+    // unbind
+    std::shared_ptr<BoundDatumSet> output;
+    // release
+    bool released = false;
+  };
+
+  IOdbcConnection* connection_;
+  StatementHandle statementHandle_;
+  std::vector<StepResult> steps_;
+  size_t bytes_ = 0;
+  bool failed_ = false;
+};
+}  // namespace mssql
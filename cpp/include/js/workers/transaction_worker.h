@@ -0,0 +1,59 @@
+#pragma once
+
+#include <js/workers/odbc_async_worker.h>
+#include <js/workers/statement_steps.h>
+#include <odbc/odbc_driver_types.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mssql {
+class BoundDatumSet;
+
+/**
+ * @brief Runs a batch of statements in one transaction on the worker thread
+ *
+ * Auto commit is turned off, each statement is executed with its parameters
+ * and every result read, then the transaction is committed - or rolled back
+ * at the first statement with an error, leaving the rest unrun. js is called
+ * back once with what each statement returned, so locks are held only as
+ * long as the statements take rather than over several trips to js.
+ */
+class TransactionWorker : public OdbcAsyncWorker {
+ public:
+  TransactionWorker(Napi::Function& callback,
+                    IOdbcConnection* connection,
+                    const Napi::Array& statements,
+                    const std::shared_ptr<TransactionOptions> options);
+
+  void Execute() override;
+  void OnOK() override;
+
+ private:
+  struct StatementOutcome {
+    std::shared_ptr<QueryOperationParams> query;
+    std::shared_ptr<BoundDatumSet> parameters;
+    std::string bind_error;
+    bool executed = false;
+    // metadata of the first result, as QueryWorker returns
+    std::shared_ptr<QueryResult> metadata;
+    std::vector<std::shared_ptr<OdbcError>> errors;
+    // every fetch and next result after the execute, see StatementSteps
+    std::unique_ptr<StatementSteps> steps;
+  };
+
+  bool execute_statement(StatementOutcome& outcome);
+  static bool has_error(const std::vector<std::shared_ptr<OdbcError>>& errors);
+  Napi::Object to_value(Napi::Env env, const StatementOutcome& outcome) const;
+
+  std::shared_ptr<TransactionOptions> options_;
+  std::vector<StatementOutcome> outcomes_;
+  // index of the statement that failed, -1 when all ran
+  int failed_ = -1;
+  bool committed_ = false;
+  bool rolled_back_ = false;
+  // from the commit or rollback itself
+  std::vector<std::shared_ptr<OdbcError>> endErrors_;
+};
+}  // namespace mssql
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <common/odbc_common.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace mssql {
+
+/**
+ * @brief One native thread which polls every statement left executing async
+ *
+ * A polled query returns SQL_STILL_EXECUTING from its first execute call, the
+ * worker then hands the statement here and gives its libuv thread back. Each
+ * pending statement is re-checked on its own backoff, starting short so quick
+ * queries complete promptly and growing to max_interval for long ones, so an
+ * idle wait costs a wakeup every few ms however many queries are in flight.
+ *
+ * poll must not block, it is called until it returns anything but
+ * SQL_STILL_EXECUTING, which is then passed to done. Both run on the poller
+ * thread.
+ */
+class AsyncPoller {
+ public:
+  using Poll = std::function<SQLRETURN()>;
+  using Done = std::function<void(SQLRETURN)>;
+
+  static constexpr std::chrono::microseconds min_interval{100};
+  static constexpr std::chrono::microseconds max_interval{10000};
+
+  static AsyncPoller& GetInstance();
+
+  void Submit(Poll poll, Done done);
+
+  // statements waiting on the driver, for tests and logging
+  size_t Pending() const;
+
+  ~AsyncPoller();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    Clock::time_point due;
+    std::chrono::microseconds interval;
+    Poll poll;
+    Done done;
+  };
+
+  struct Later {
+    bool operator()(const Entry& a, const Entry& b) const {
+      return a.due > b.due;
+    }
+  };
+
+  AsyncPoller() = default;
+  AsyncPoller(const AsyncPoller&) = delete;
+  AsyncPoller& operator=(const AsyncPoller&) = delete;
+
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::priority_queue<Entry, std::vector<Entry>, Later> queue_;
+  size_t active_ = 0;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace mssql
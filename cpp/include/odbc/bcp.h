@@ -21,6 +21,7 @@ class BoundDatumSet;
 class DatumStorage;
 class ConnectionHandles;
 class OdbcConnectionHandle;
+struct BcpFileOptions;
 
 struct plugin_bcp {
   ~plugin_bcp();
@@ -45,6 +46,12 @@ struct plugin_bcp {
   inline RETCODE bcp_init(HDBC const, const LPCWSTR, const LPCWSTR, const LPCWSTR, const INT) const;
   inline DBINT bcp_sendrow(HDBC const) const;
   inline DBINT bcp_done(HDBC const) const;
+  inline RETCODE bcp_control(HDBC const, const INT, void*) const;
+  inline RETCODE bcp_columns(HDBC const, const INT) const;
+  inline RETCODE bcp_colfmt(
+      HDBC const, const INT, const BYTE, const INT, const DBINT, const LPCBYTE, const INT, const INT)
+      const;
+  inline RETCODE bcp_exec(HDBC const, LPDBINT) const;
 
   typedef RETCODE(__cdecl* plug_bcp_bind)(HDBC const,
                                           const LPCBYTE,
@@ -57,10 +64,18 @@ struct plugin_bcp {
   typedef RETCODE(__cdecl* plug_bcp_init)(HDBC, LPCWSTR, LPCWSTR, LPCWSTR, INT);
   typedef DBINT(__cdecl* plug_bcp_sendrow)(HDBC);
   typedef DBINT(__cdecl* plug_bcp_done)(HDBC);
+  typedef RETCODE(__cdecl* plug_bcp_control)(HDBC, INT, void*);
+  typedef RETCODE(__cdecl* plug_bcp_columns)(HDBC, INT);
+  typedef RETCODE(__cdecl* plug_bcp_colfmt)(HDBC, INT, BYTE, INT, DBINT, LPCBYTE, INT, INT);
+  typedef RETCODE(__cdecl* plug_bcp_exec)(HDBC, LPDBINT);
   plug_bcp_bind dll_bcp_bind;
   plug_bcp_init dll_bcp_init;
   plug_bcp_sendrow dll_bcp_sendrow;
   plug_bcp_done dll_bcp_done;
+  plug_bcp_control dll_bcp_control;
+  plug_bcp_columns dll_bcp_columns;
+  plug_bcp_colfmt dll_bcp_colfmt;
+  plug_bcp_exec dll_bcp_exec;
 };
 
 struct basestorage {
@@ -77,8 +92,13 @@ struct bcp {
   bcp(std::shared_ptr<IOdbcApi> odbcApiPtr,
       const shared_ptr<BoundDatumSet> param_set,
       shared_ptr<IOdbcConnectionHandle> h);
+  bcp(std::shared_ptr<IOdbcApi> odbcApiPtr,
+      const shared_ptr<BcpFileOptions> file_options,
+      shared_ptr<IOdbcConnectionHandle> h);
   int insert(int version = 17);
+  int64_t insert_file();
   bool init();
+  bool hints();
   bool bind();
   bool send();
 #ifdef WINDOWS_BUILD
@@ -87,11 +107,17 @@ struct bcp {
 #ifdef LINUX_BUILD
   int dynload(const string name);
 #endif
+  bool load(int version);
+  bool init_file();
+  bool format_file();
+  bool control_file();
   int done();
   int clean(const string& step);
   wstring table_name() const;
+  wstring table_hints() const;
   shared_ptr<IOdbcConnectionHandle> _ch;
   shared_ptr<BoundDatumSet> _param_set;
+  shared_ptr<BcpFileOptions> _file_options;
   shared_ptr<vector<shared_ptr<OdbcError>>> _errors;
   shared_ptr<IOdbcApi> _odbcApi;
   vector<shared_ptr<basestorage>> _storage;
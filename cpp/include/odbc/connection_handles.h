@@ -2,6 +2,7 @@
 
 #include <common/odbc_common.h>
 
+#include <condition_variable>
 #include <functional>
 #include <map>
 #include <memory>
@@ -9,6 +10,7 @@
 #include <set>
 #include <vector>
 
+#include "odbc/iodbc_api.h"
 #include "odbc/odbc_handles.h"
 #include "odbc/safe_handle.h"
 #include "platform.h"
@@ -23,10 +25,26 @@ namespace mssql {
  *
  * The class provides a checkout/checkin pattern for statement handles
  * where each statement is identified by a unique ID.
+ *
+ * Handles checked in are reset and kept on a bounded free list for the next
+ * checkout rather than freed, so short queries do not pay SQLAllocHandle and
+ * SQLFreeHandle each time. A handle which fails to reset is freed instead.
+ * The reset runs outside the mutex, clear() waits for any still in flight.
  */
 class ConnectionHandles {
  public:
-  ConnectionHandles(std::shared_ptr<IOdbcEnvironmentHandle> env);
+  static constexpr size_t default_statement_pool_size = 16;
+
+  struct StatementPoolStats {
+    size_t allocated = 0;  // new handles from SQLAllocHandle
+    size_t reused = 0;     // checkouts served from the free list
+    size_t recycled = 0;   // checkins reset and put on the free list
+    size_t discarded = 0;  // checkins freed, the list being full or the reset failing
+    size_t idle = 0;       // handles on the free list now
+  };
+
+  ConnectionHandles(std::shared_ptr<IOdbcEnvironmentHandle> env,
+                    std::shared_ptr<IOdbcApi> odbcApi = nullptr);
   ~ConnectionHandles();
   void clear();
   /**
@@ -58,16 +76,32 @@ class ConnectionHandles {
    */
   bool exists(long statement_id) const;
 
+  /**
+   * @brief Bound the statement free list, 0 frees every handle on checkin
+   */
+  void setStatementPoolSize(size_t size);
+  StatementPoolStats statementPoolStats() const;
+
  private:
+  bool reset_statement(SQLHANDLE raw) const;
+  static void free_raw(SQLHANDLE raw);
+  void free_idle_unlocked();
   shared_ptr<IOdbcStatementHandle> store(const long statement_id,
                                          shared_ptr<IOdbcStatementHandle> handle);
   shared_ptr<IOdbcStatementHandle> find_unlocked(const long statement_id);
   std::map<long, std::shared_ptr<SafeHandle<IOdbcStatementHandle>>> _statementHandles;
   std::shared_ptr<IOdbcEnvironmentHandle> rawEnvHandle_;  // Raw handle - not wrapped in SafeHandle
   std::shared_ptr<SafeHandle<IOdbcConnectionHandle>> connectionHandle_;
+  std::shared_ptr<IOdbcApi> odbcApi_;
+  std::vector<SQLHANDLE> _idleStatements;
+  size_t _statementPoolSize = default_statement_pool_size;
+  StatementPoolStats _poolStats;
 
   // Mutex for thread-safe access to statement handles
   // This prevents race conditions between checkin() and clear()
   mutable std::mutex _handlesMutex;
+  // Checkins resetting a handle outside the mutex, clear() waits for these
+  size_t _resetting = 0;
+  std::condition_variable _resetDone;
 };
 }  // namespace mssql
\ No newline at end of file
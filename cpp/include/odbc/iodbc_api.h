@@ -152,6 +152,12 @@ class IOdbcApi {
   // Add SQLCancelHandle to the interface
   virtual SQLRETURN SQLCancelHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) = 0;
 
+  // data at execution parameters are sent in chunks once execute returns SQL_NEED_DATA
+  virtual SQLRETURN SQLParamData(SQLHSTMT StatementHandle, SQLPOINTER* Value) = 0;
+  virtual SQLRETURN SQLPutData(SQLHSTMT StatementHandle,
+                               SQLPOINTER Data,
+                               SQLLEN StrLen_or_Ind) = 0;
+
   // Add SQLGetDiagField to the interface
   virtual SQLRETURN SQLGetDiagField(SQLSMALLINT HandleType,
                                     SQLHANDLE Handle,
@@ -164,6 +170,9 @@ class IOdbcApi {
   // Add SQLCloseCursor to the interface
   virtual SQLRETURN SQLCloseCursor(SQLHSTMT StatementHandle) = 0;
 
+  // SQL_CLOSE discards every pending result, with no error where no cursor is open
+  virtual SQLRETURN SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) = 0;
+
   // Add SQLGetDescField to the interface
   virtual SQLRETURN SQLGetDescField(SQLHDESC DescriptorHandle,
                                     SQLSMALLINT RecNumber,
@@ -288,6 +297,9 @@ class RealOdbcApi : public IOdbcApi {
 
   SQLRETURN SQLCancelHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) override;
 
+  SQLRETURN SQLParamData(SQLHSTMT StatementHandle, SQLPOINTER* Value) override;
+  SQLRETURN SQLPutData(SQLHSTMT StatementHandle, SQLPOINTER Data, SQLLEN StrLen_or_Ind) override;
+
   SQLRETURN SQLGetDiagField(SQLSMALLINT HandleType,
                             SQLHANDLE Handle,
                             SQLSMALLINT RecNumber,
@@ -298,6 +310,8 @@ class RealOdbcApi : public IOdbcApi {
 
   SQLRETURN SQLCloseCursor(SQLHSTMT StatementHandle) override;
 
+  SQLRETURN SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) override;
+
   SQLRETURN SQLGetDescField(SQLHDESC DescriptorHandle,
                             SQLSMALLINT RecNumber,
                             SQLSMALLINT FieldIdentifier,
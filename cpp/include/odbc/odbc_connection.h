@@ -6,6 +6,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -14,13 +15,15 @@
 #include <sqlext.h>
 
 // Project includes
+#include "odbc/connection_handles.h"
 #include "odbc/odbc_error.h"
 #include "odbc/odbc_statement.h"
+#include "odbc/odbc_statement_cache.h"
 
 namespace mssql {
 // Forward declarations
 class OdbcError;
-class OdbcStatementCache;
+class OdbcStatementLegacy;
 class QueryParameter;
 class QueryResult;
 class IOdbcApi;
@@ -77,6 +80,23 @@ class IOdbcConnection {
   virtual const std::vector<std::shared_ptr<OdbcError>>& GetErrors() const = 0;
 
   virtual bool TryReadNextResult(int statementId, std::shared_ptr<QueryResult>& result) = 0;
+
+  // Bulk copy a delimited file into a table on this connection
+  virtual bool BcpFile(const std::shared_ptr<BcpFileOptions> options, int64_t& rowsCopied) = 0;
+
+  // Round value sized string and binary parameters up to these sizes, empty disables
+  virtual void SetParamSizeBuckets(const std::vector<SQLULEN>& buckets) = 0;
+  // Distinct query and parameter signatures sent on this connection
+  virtual size_t GetParamSignatureCount() const = 0;
+  // Prepared statements kept between queries, a capacity of 0 disables. Ad hoc
+  // sql is auto prepared after autoPrepareThreshold executions, 0 disables.
+  virtual void SetStatementCache(uint32_t autoPrepareThreshold,
+                                 size_t capacity,
+                                 size_t maxBytes) = 0;
+  virtual StatementCacheStats GetStatementCacheStats() const = 0;
+  // Released statement handles kept for reuse, a size of 0 frees each on release
+  virtual void SetStatementPoolSize(size_t size) = 0;
+  virtual ConnectionHandles::StatementPoolStats GetStatementPoolStats() const = 0;
 };
 
 // This class encapsulates the actual ODBC functionality
@@ -133,6 +153,17 @@ class OdbcConnection : public IOdbcConnection {
 
   bool TryReadNextResult(int statementId, std::shared_ptr<QueryResult>& result) override;
 
+  bool BcpFile(const std::shared_ptr<BcpFileOptions> options, int64_t& rowsCopied) override;
+
+  void SetParamSizeBuckets(const std::vector<SQLULEN>& buckets) override;
+  size_t GetParamSignatureCount() const override;
+  void SetStatementCache(uint32_t autoPrepareThreshold,
+                         size_t capacity,
+                         size_t maxBytes) override;
+  StatementCacheStats GetStatementCacheStats() const override;
+  void SetStatementPoolSize(size_t size) override;
+  ConnectionHandles::StatementPoolStats GetStatementPoolStats() const override;
+
   // Get connection errors
   const std::vector<std::shared_ptr<OdbcError>>& GetErrors() const override;
 
@@ -180,6 +211,24 @@ class OdbcConnection : public IOdbcConnection {
   // Statement management
   std::mutex _statementMutex;
 
+  // Parameter size buckets and the signatures seen so far, the set is capped
+  // so a connection issuing endless distinct ad hoc sql stays bounded.
+  static constexpr size_t kMaxTrackedSignatures = 65536;
+  mutable std::mutex _signatureMutex;
+  std::vector<SQLULEN> _paramSizeBuckets;
+  std::unordered_set<size_t> _paramSignatures;
+  size_t apply_param_policy(size_t key, const std::shared_ptr<BoundDatumSet>& parameters);
+
+  // Prepared statements kept between queries, see SetStatementCache
+  std::shared_ptr<OdbcStatementCache> _statementCache;
+  void invalidate_on_schema_change(const std::shared_ptr<IOdbcStatement>& statement);
+  std::shared_ptr<IOdbcStatement> auto_prepared_statement(
+      const std::shared_ptr<QueryOperationParams>& operationParams,
+      const std::shared_ptr<BoundDatumSet>& parameters,
+      size_t key);
+  void free_statements(const std::vector<std::shared_ptr<OdbcStatementLegacy>>& statements);
+  void map_query(int queryId, const StatementHandle& handle);
+
   // Helper methods
   bool TryClose();
   bool ReturnOdbcError();
@@ -193,6 +193,15 @@ class QueryOperationParams {
   bool numeric_string;
   bool bigint_as_native;
   bool polling;
+  // a polled execute still running returns early, see AsyncPoller
+  bool defer_polling = false;
+  // rows read by the query worker along with the metadata, 0 for none
+  int32_t first_batch_size = 0;
+  // keep reading results past the first batch until this much is held
+  size_t read_ahead_bytes = 0;
+  // once the results are read ahead to the end
+  bool unbind_on_end = false;
+  bool release_on_end = false;
 
   std::string toString() const {
     std::string result = "QueryOperationParams: ";
@@ -204,6 +213,10 @@ class QueryOperationParams {
     result += ", numeric_string: " + std::to_string(numeric_string);
     result += ", bigint_as_native: " + std::to_string(bigint_as_native);
     result += ", polling: " + std::to_string(polling);
+    result += ", first_batch_size: " + std::to_string(first_batch_size);
+    result += ", read_ahead_bytes: " + std::to_string(read_ahead_bytes);
+    result += ", unbind_on_end: " + std::to_string(unbind_on_end);
+    result += ", release_on_end: " + std::to_string(release_on_end);
     return result;
   }
 };
@@ -224,6 +237,113 @@ struct QueryOptions {
   }
 };
 
+// file based bcp - the driver reads and splits the file, the server converts
+// each field to its destination column type.
+struct BcpFileOptions {
+  std::u16string table_name;
+  std::u16string file_name;
+  std::u16string error_file;
+  std::string field_terminator;
+  std::string row_terminator;
+  std::u16string hints;
+  std::vector<int32_t> columns;  // server ordinal for each field in the file
+  int32_t first_row;
+  int32_t last_row;
+  int32_t batch_size;
+  int32_t max_errors;
+  int32_t code_page;
+  int32_t bcp_version;
+  bool unicode;
+  bool keep_nulls;
+
+  std::string toString() const {
+    std::string result = "BcpFileOptions: ";
+    result += "table_name: " + StringUtils::U16StringToUtf8(table_name);
+    result += ", file_name: " + StringUtils::U16StringToUtf8(file_name);
+    result += ", columns: " + std::to_string(columns.size());
+    result += ", first_row: " + std::to_string(first_row);
+    result += ", last_row: " + std::to_string(last_row);
+    result += ", batch_size: " + std::to_string(batch_size);
+    result += ", max_errors: " + std::to_string(max_errors);
+    result += ", code_page: " + std::to_string(code_page);
+    result += ", bcp_version: " + std::to_string(bcp_version);
+    result += ", unicode: ";
+    result += (unicode ? "true" : "false");
+    return result;
+  }
+};
+
+// native export - rows are rendered as text on the worker thread and written
+// straight to a file descriptor owned by the caller.
+enum class ExportFormat { Csv, Tsv, NdJson };
+
+struct ExportOptions {
+  int32_t fd = -1;
+  ExportFormat format = ExportFormat::Csv;
+  bool header = true;
+  std::string null_value;
+  size_t buffer_size = 1024 * 1024;
+  size_t batch_size = 5000;
+  // least time between progress calls, 0 calls after every batch
+  uint32_t progress_interval_ms = 250;
+
+  std::string toString() const {
+    std::string result = "ExportOptions: ";
+    result += "fd: " + std::to_string(fd);
+    result += ", format: ";
+    result += (format == ExportFormat::Csv ? "csv" : format == ExportFormat::Tsv ? "tsv" : "ndjson");
+    result += ", header: ";
+    result += (header ? "true" : "false");
+    result += ", buffer_size: " + std::to_string(buffer_size);
+    result += ", batch_size: " + std::to_string(batch_size);
+    result += ", progress_interval_ms: " + std::to_string(progress_interval_ms);
+    return result;
+  }
+};
+
+// one prepared statement run over many parameter sets on the worker thread,
+// each set is bound and executed in turn with its own outcome.
+struct ExecuteManyOptions {
+  bool stop_on_error = false;
+  size_t batch_size = 5000;
+
+  std::string toString() const {
+    std::string result = "ExecuteManyOptions: ";
+    result += "stop_on_error: ";
+    result += (stop_on_error ? "true" : "false");
+    result += ", batch_size: " + std::to_string(batch_size);
+    return result;
+  }
+};
+
+// a batch of statements run in one transaction on the worker thread, rows
+// are fetched batch_size at a time.
+struct TransactionOptions {
+  size_t batch_size = 5000;
+
+  std::string toString() const {
+    std::string result = "TransactionOptions: ";
+    result += "batch_size: " + std::to_string(batch_size);
+    return result;
+  }
+};
+
+// statements sent as one batch, each followed by a single column result
+// named marker. lines holds the batch line each statement starts on.
+struct BatchOptions {
+  size_t batch_size = 5000;
+  std::string marker;
+  std::vector<int32_t> lines;
+
+  std::string toString() const {
+    std::string result = "BatchOptions: ";
+    result += "batch_size: " + std::to_string(batch_size);
+    result += ", marker: " + marker;
+    result += ", statements: " + std::to_string(lines.size());
+    return result;
+  }
+};
+
 // Existing structure
 struct ProcedureParamMeta {
   std::string proc_name;
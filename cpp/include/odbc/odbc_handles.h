@@ -30,6 +30,16 @@ class IOdbcHandle {
 
   // Get underlying handle
   virtual SQLHANDLE get_handle() const = 0;
+
+  // Hand the raw handle to a new owner without freeing it, as the statement
+  // pool in ConnectionHandles does. Handles which cannot do this return null
+  // from detach and false from adopt, and are simply freed.
+  virtual SQLHANDLE detach() {
+    return SQL_NULL_HANDLE;
+  }
+  virtual bool adopt(SQLHANDLE handle) {
+    return false;
+  }
 };
 
 // Specialized handle interfaces - these must not add any new pure virtual methods
@@ -170,6 +180,18 @@ class OdbcHandleImpl : public InterfaceType {
     return handle_;
   }
 
+  SQLHANDLE detach() override {
+    const auto handle = handle_;
+    handle_ = SQL_NULL_HANDLE;
+    return handle;
+  }
+
+  bool adopt(SQLHANDLE handle) override {
+    free();
+    handle_ = handle;
+    return handle_ != SQL_NULL_HANDLE;
+  }
+
  protected:
   SQLHANDLE handle_;
 
@@ -159,6 +159,42 @@ class IOdbcStatement {
 
   virtual bool Cancel() = 0;
 
+  /**
+   * @brief Discard the rows and results not yet read
+   * Closes the cursor rather than fetching what is left, the handle can then
+   * be released or executed again.
+   * @return true if successful, false otherwise
+   */
+  virtual bool Abandon() {
+    return false;
+  }
+
+  /**
+   * @brief True when Execute returned with a polled query still running
+   * The caller finishes it with PollExecute and CompleteExecute, see AsyncPoller.
+   */
+  virtual bool IsExecutePending() const {
+    return false;
+  }
+
+  /**
+   * @brief Check a pending execute once, without waiting on the driver
+   * @return SQL_STILL_EXECUTING until the query has finished
+   */
+  virtual SQLRETURN PollExecute() {
+    return SQL_ERROR;
+  }
+
+  /**
+   * @brief Finish a pending execute once PollExecute has returned
+   * @param ret The last return from PollExecute
+   * @param result Result object to store metadata
+   * @return true if successful, false otherwise
+   */
+  virtual bool CompleteExecute(SQLRETURN ret, std::shared_ptr<QueryResult>& result) {
+    return false;
+  }
+
   /**
    * @brief Close the statement and set CLOSED state
    */
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <common/odbc_common.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "platform.h"
+
+namespace mssql {
+class OdbcStatementLegacy;
+
+// what a cached statement was created by - an explicit prepare binds its
+// result columns, an auto prepared statement reads results as a direct query.
+enum class CachedStatementKind { AutoPrepared, Prepared };
+
+struct StatementCacheStats {
+  size_t size = 0;
+  size_t bytes = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  uint64_t invalidations = 0;
+};
+
+/**
+ * @brief Keeps prepared statements alive between executions of the same sql
+ *
+ * Entries are keyed by a hash of the sql text and parameter signature and
+ * hold the text itself so a hash collision is treated as a miss. A statement
+ * is checked out while a query owns it and only idle statements are handed
+ * out again, least recently used idle entries are evicted first once either
+ * the statement or byte limit is passed.
+ *
+ * Statements pushed out of the cache are returned to the caller, which owns
+ * freeing their handles through the statement factory.
+ *
+ * This class is thread-safe.
+ */
+class OdbcStatementCache {
+ public:
+  using statements = std::vector<std::shared_ptr<OdbcStatementLegacy>>;
+
+  OdbcStatementCache() = default;
+
+  /**
+   * @brief Set the cache policy, a capacity of 0 disables caching
+   * @param threshold executions of ad hoc sql before it is auto prepared, 0 disables
+   * @param capacity maximum number of prepared statements held
+   * @param maxBytes maximum estimated memory held by the statements
+   * @param evicted receives statements no longer held
+   */
+  void Configure(uint32_t threshold, size_t capacity, size_t maxBytes, statements& evicted);
+
+  bool Enabled() const;
+  bool AutoPrepareEnabled() const;
+
+  /**
+   * @brief Count an execution of key
+   * @return true once key has been seen threshold times
+   */
+  bool Seen(size_t key);
+
+  /**
+   * @brief Idle statement of kind prepared for key and text, marked in use
+   * @return nullptr on a miss or when the cached statement is busy
+   */
+  std::shared_ptr<OdbcStatementLegacy> Checkout(size_t key,
+                                                const std::u16string& text,
+                                                CachedStatementKind kind);
+
+  /**
+   * @brief Hold a statement already in use under key
+   * @param evicted receives idle statements pushed out to make room
+   */
+  void Insert(size_t key,
+              const std::u16string& text,
+              CachedStatementKind kind,
+              std::shared_ptr<OdbcStatementLegacy> statement,
+              statements& evicted);
+
+  /**
+   * @brief Drop the statement when the query using it is released
+   */
+  void Invalidate(long statementId);
+
+  /**
+   * @brief The cached statement a finished query still holds, if it is to be
+   * kept, so the caller can close its cursor before Release without any lock.
+   */
+  std::shared_ptr<OdbcStatementLegacy> Returning(long statementId) const;
+
+  /**
+   * @brief Query using the statement is done with it
+   * @param cursorClosed the cursor left by the query was closed, see Returning
+   * @param evicted receives idle statements pushed out by its new size
+   * @return true when the cache keeps the statement, false when the caller
+   * should free it as normal
+   */
+  bool Release(long statementId, bool cursorClosed, statements& evicted);
+
+  /**
+   * @brief Give up every statement, e.g. on connection close
+   */
+  void Clear(statements& evicted);
+
+  StatementCacheStats Stats() const;
+
+  /**
+   * @brief Server errors after which a prepared plan can no longer be used
+   * e.g. a dropped or altered table, column or procedure.
+   */
+  static bool InvalidatesPlan(int nativeError);
+
+ private:
+  struct Entry {
+    size_t key;
+    std::u16string text;
+    CachedStatementKind kind;
+    std::shared_ptr<OdbcStatementLegacy> statement;
+    size_t bytes;
+    bool in_use;
+    bool discard;
+  };
+  using entry_list = std::list<Entry>;
+
+  void trim(statements& evicted);
+  void erase(entry_list::iterator it);
+
+  // most recently used at the front
+  entry_list _entries;
+  std::unordered_map<size_t, entry_list::iterator> _byKey;
+  std::unordered_map<long, entry_list::iterator> _byStatement;
+  std::unordered_map<size_t, uint32_t> _seen;
+  uint32_t _threshold = 0;
+  size_t _capacity = 0;
+  size_t _maxBytes = 0;
+  StatementCacheStats _stats;
+  mutable std::mutex _mutex;
+};
+}  // namespace mssql
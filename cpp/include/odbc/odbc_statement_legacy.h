@@ -80,6 +80,13 @@ class OdbcStatementLegacy : public IOdbcStatement {
     return _statementState == OdbcStatementState::STATEMENT_CREATED;
   }
   bool Cancel() override;
+  bool Abandon() override;
+
+  bool IsExecutePending() const override {
+    return _executePending.load();
+  }
+  SQLRETURN PollExecute() override;
+  bool CompleteExecute(SQLRETURN ret, std::shared_ptr<QueryResult>& result) override;
 
   /**
    * @brief Close the statement and set CLOSED state
@@ -116,6 +123,23 @@ class OdbcStatementLegacy : public IOdbcStatement {
     return _prepared;
   }
 
+  // ad hoc sql kept prepared by the connection - the first execute prepares
+  // the text and later ones only bind and SQLExecute, results read as direct.
+  void set_auto_prepare(bool mode) {
+    _autoPrepare = mode;
+  }
+
+  bool is_auto_prepare() const {
+    return _autoPrepare;
+  }
+
+  // point a cached statement at the next query using it
+  void reuse(const shared_ptr<QueryOperationParams>& q);
+  // close any open cursor so the statement can be executed again
+  bool close_cursor();
+  // estimate of the memory held - sql text, bound parameter and column buffers
+  size_t memory_footprint() const;
+
   Napi::Array unbind_params(Napi::Env env) const;
   Napi::Object get_meta_value(Napi::Env env) const;
   bool end_of_results() const;
@@ -137,6 +161,7 @@ class OdbcStatementLegacy : public IOdbcStatement {
   bool try_bcp(const shared_ptr<BoundDatumSet>& param_set, int32_t version);
   bool try_execute_direct(const shared_ptr<QueryOperationParams>& q,
                           const shared_ptr<BoundDatumSet>& paramSet);
+  bool finish_execute_direct(SQLRETURN ret, const shared_ptr<BoundDatumSet>& paramSet);
   bool cancel_handle();
   bool try_read_columns(size_t number_rows);
   bool try_read_next_result();
@@ -159,6 +184,8 @@ class OdbcStatementLegacy : public IOdbcStatement {
   bool get_data_timestamp_offset(size_t row_id, size_t column);
 
   bool start_reading_results();
+  SQLRETURN execute_auto_prepared(std::u16string& query);
+  SQLRETURN send_data_at_exec(const BoundDatumSet& param_set);
   SQLRETURN query_timeout(int timeout);
   bool d_variant(size_t row_id, size_t column);
   bool d_time(size_t row_id, size_t column);
@@ -189,6 +216,7 @@ class OdbcStatementLegacy : public IOdbcStatement {
   bool bind_tvp(vector<tvp_t>& tvps);
   bool bind_datum(int current_param, const shared_ptr<BoundDatum>& datum);
   bool bind_params(const shared_ptr<BoundDatumSet>& params);
+  bool bind_prepared_params(const shared_ptr<BoundDatumSet>& params);
   void queue_tvp(int current_param,
                  param_bindings::iterator& itr,
                  shared_ptr<BoundDatum>& datum,
@@ -208,8 +236,14 @@ class OdbcStatementLegacy : public IOdbcStatement {
   // bool _endOfResults;
   long _statementId;
   bool _prepared;
+  bool _autoPrepare;
+  bool _autoPrepared;
   std::atomic<bool> _cancelRequested;
   std::atomic<bool> _pollingEnabled;
+  // a deferred polled execute, the text is passed again on each poll
+  std::atomic<bool> _executePending{false};
+  std::u16string _pendingQuery;
+  std::shared_ptr<BoundDatumSet> _pendingParams;
   bool _numericStringEnabled;
   bool _bigIntAsNativeEnabled;
 
@@ -218,8 +252,11 @@ class OdbcStatementLegacy : public IOdbcStatement {
   // set binary true if a binary Buffer should be returned instead of a JS string
 
   std::shared_ptr<ResultSet> _resultset;
+  std::shared_ptr<ResultSet> _preparedResultset;
   std::shared_ptr<BoundDatumSet> _boundParamsSet;
   std::shared_ptr<BoundDatumSet> _preparedStorage;
+  // parameters bound to the prepared handle, later executes copy into them
+  std::shared_ptr<BoundDatumSet> _preparedParams;
 
   std::shared_ptr<IOdbcStatementHandle> _statement;
   std::shared_ptr<OdbcErrorHandler> _errorHandler;
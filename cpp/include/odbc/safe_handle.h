@@ -6,6 +6,7 @@
 #include <string>
 #include "odbc_handles.h"
 #include "Logger.h"
+#include "handle_diagnostics.h"
 
 namespace mssql {
 
@@ -16,6 +17,7 @@ namespace mssql {
  * - State tracking to prevent double-free
  * - Thread-safe validity checks
  * - Debug logging for handle lifecycle
+ * - Sampled lifecycle history when HandleDiagnostics is enabled
  * - Automatic cleanup on destruction
  */
 template <typename HandleType>
@@ -67,7 +69,7 @@ public:
         
         if (handle_->alloc(parent)) {
             state_ = State::ALLOCATED;
-            allocation_stack_ = captureStackTrace();
+            record(HandleEventKind::Alloc, HandleDiagnostics::GetInstance().ShouldSample());
             SQL_LOG_DEBUG_STREAM("SafeHandle allocated successfully: " << name_);
             return true;
         }
@@ -81,8 +83,15 @@ public:
         std::lock_guard<std::mutex> lock(mutex_);
         
         if (state_ == State::FREED) {
-            SQL_LOG_ERROR_STREAM("SafeHandle double-free detected: " << name_ 
-                << " Originally freed from: " << free_stack_);
+            auto& diagnostics = HandleDiagnostics::GetInstance();
+            if (diagnostics.IsEnabled()) {
+                diagnostics.Record(HandleEventKind::DoubleFree, name_, nullptr);
+                SQL_LOG_ERROR_STREAM("SafeHandle double-free detected: " << name_
+                    << " history:\n" << diagnostics.Dump(name_));
+            } else {
+                SQL_LOG_ERROR_STREAM("SafeHandle double-free detected: " << name_
+                    << " (enable handle diagnostics for its history)");
+            }
             return;
         }
         
@@ -98,11 +107,51 @@ public:
         }
         
         SQL_LOG_DEBUG_STREAM("SafeHandle freeing: " << name_);
+        record(HandleEventKind::Free, sampled_);
         handle_->free();
         state_ = State::FREED;
-        free_stack_ = captureStackTrace();
     }
     
+    /**
+     * @brief Give up the raw handle without freeing it, leaving this wrapper freed
+     * @return The raw handle, or SQL_NULL_HANDLE if the handle type cannot detach
+     */
+    SQLHANDLE detach() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (state_ != State::ALLOCATED) {
+            return SQL_NULL_HANDLE;
+        }
+
+        const auto raw = handle_->detach();
+        if (raw == SQL_NULL_HANDLE) {
+            return SQL_NULL_HANDLE;
+        }
+
+        SQL_LOG_DEBUG_STREAM("SafeHandle detached: " << name_);
+        state_ = State::FREED;
+        if (sampled_ && HandleDiagnostics::GetInstance().IsEnabled()) {
+            HandleDiagnostics::GetInstance().Record(HandleEventKind::Detach, name_, raw);
+        }
+        return raw;
+    }
+
+    /**
+     * @brief Take ownership of a raw handle allocated elsewhere, e.g. one detached earlier
+     */
+    bool adopt(SQLHANDLE raw) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (state_ != State::UNALLOCATED || !handle_ || !handle_->adopt(raw)) {
+            return false;
+        }
+
+        SQL_LOG_DEBUG_STREAM("SafeHandle adopted: " << name_);
+        state_ = State::ALLOCATED;
+        record(HandleEventKind::Adopt, HandleDiagnostics::GetInstance().ShouldSample());
+        return true;
+    }
+
     /**
      * @brief Force reset reference count - use only during cleanup
      */
@@ -185,10 +234,12 @@ public:
     };
 
 private:
-    std::string captureStackTrace() const {
-        // In production, you might want to use backtrace() or similar
-        // For now, just return a placeholder
-        return "Stack trace not implemented";
+    // caller holds mutex_, nothing is captured unless the handle was sampled
+    void record(HandleEventKind kind, bool sampled) {
+        sampled_ = sampled;
+        if (sampled_) {
+            HandleDiagnostics::GetInstance().Record(kind, name_, handle_->get_handle());
+        }
     }
 
     const std::string name_;
@@ -196,8 +247,7 @@ private:
     mutable std::mutex mutex_;
     std::atomic<State> state_;
     std::atomic<int> ref_count_;
-    std::string allocation_stack_;
-    std::string free_stack_;
+    bool sampled_ = false;
 };
 
 }  // namespace mssql
\ No newline at end of file
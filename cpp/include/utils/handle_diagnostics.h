@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mssql {
+
+enum class HandleEventKind { Alloc = 0, Free = 1, Detach = 2, Adopt = 3, DoubleFree = 4 };
+
+struct HandleEvent {
+  HandleEventKind kind;
+  std::string name;
+  const void* handle;
+  uint64_t sequence;
+  int64_t timestamp_ms;
+  std::string thread;
+  std::string stack;
+};
+
+/**
+ * @brief Handle lifecycle history for SafeHandle, off by default
+ *
+ * When enabled, 1 in sample_every handles is followed from alloc to free
+ * with a stack trace at each step, kept in a bounded ring of recent events.
+ * A double free is always recorded while enabled and the ring for that
+ * handle is logged with it. Disabled, a handle costs one relaxed load.
+ *
+ * Switched from js with logger.setHandleDiagnostics, see lib/logger.js.
+ */
+class HandleDiagnostics {
+ public:
+  static constexpr size_t default_capacity = 256;
+
+  static HandleDiagnostics& GetInstance();
+
+  void Configure(bool enabled, uint32_t sample_every, size_t capacity);
+
+  bool IsEnabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // called once per handle on alloc, true if its lifecycle should be recorded
+  bool ShouldSample() {
+    if (!IsEnabled()) {
+      return false;
+    }
+    const auto every = sample_every_.load(std::memory_order_relaxed);
+    return every <= 1 || counter_.fetch_add(1, std::memory_order_relaxed) % every == 0;
+  }
+
+  void Record(HandleEventKind kind, const std::string& name, const void* handle);
+  std::vector<HandleEvent> Events() const;
+
+  // recent events for one handle name, oldest first, for the log
+  std::string Dump(const std::string& name) const;
+
+  static const char* KindName(HandleEventKind kind);
+
+ private:
+  HandleDiagnostics() = default;
+
+  HandleDiagnostics(const HandleDiagnostics&) = delete;
+  HandleDiagnostics& operator=(const HandleDiagnostics&) = delete;
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint32_t> sample_every_{1};
+  std::atomic<uint64_t> counter_{0};
+
+  mutable std::mutex mutex_;
+  std::vector<HandleEvent> ring_;
+  size_t capacity_ = default_capacity;
+  size_t next_ = 0;
+  uint64_t sequence_ = 0;
+};
+
+}  // namespace mssql
@@ -0,0 +1,123 @@
+#include <platform.h>
+#include <common/executor_pool.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <utils/Logger.h>
+
+namespace mssql {
+
+namespace {
+size_t configured_threads() {
+  const char* value = std::getenv("MSNODESQLV8_EXECUTOR_THREADS");
+  if (value) {
+    const auto threads = std::strtoul(value, nullptr, 10);
+    if (threads > 0) {
+      return threads;
+    }
+  }
+  return ExecutorPool::default_threads;
+}
+}  // namespace
+
+ExecutorPool& ExecutorPool::GetInstance() {
+  // never destroyed - a thread may still be blocked in the driver at exit
+  static auto* instance = new ExecutorPool(configured_threads());
+  return *instance;
+}
+
+ExecutorPool::ExecutorPool(const size_t max_threads)
+    : max_threads_(std::max<size_t>(max_threads, 1)) {}
+
+ExecutorPool::~ExecutorPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_.notify_all();
+  for (auto& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void ExecutorPool::Submit(const void* key, Task task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& serial = serials_[key];
+    serial.tasks.push_back(std::move(task));
+    if (serial.scheduled) {
+      // runs after the task in front of it for the same key
+      return;
+    }
+    serial.scheduled = true;
+    ready_.push_back(key);
+    // a thread for each key waiting, until the limit is reached
+    if (ready_.size() > idle_ && threads_.size() < max_threads_) {
+      threads_.emplace_back(&ExecutorPool::run, this);
+    }
+  }
+  work_.notify_one();
+}
+
+void ExecutorPool::SetMaxThreads(const size_t max_threads) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_threads_ = std::max<size_t>(max_threads, 1);
+}
+
+size_t ExecutorPool::MaxThreads() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_threads_;
+}
+
+size_t ExecutorPool::Threads() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return threads_.size();
+}
+
+size_t ExecutorPool::Busy() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return threads_.size() - idle_;
+}
+
+void ExecutorPool::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ++idle_;
+    work_.wait(lock, [this]() { return stop_ || !ready_.empty(); });
+    --idle_;
+    if (stop_) {
+      return;
+    }
+
+    const auto key = ready_.front();
+    ready_.pop_front();
+    // node references stay valid while other keys are added
+    auto& serial = serials_[key];
+    auto task = std::move(serial.tasks.front());
+    serial.tasks.pop_front();
+    lock.unlock();
+
+    try {
+      task();
+    } catch (const std::exception& e) {
+      SQL_LOG_ERROR_STREAM("ExecutorPool task failed: " << e.what());
+    }
+
+    lock.lock();
+    if (serial.tasks.empty()) {
+      serials_.erase(key);
+    } else {
+      // to the back, so other connections waiting get a turn first
+      ready_.push_back(key);
+      work_.notify_one();
+    }
+  }
+}
+
+}  // namespace mssql
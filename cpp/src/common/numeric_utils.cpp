@@ -13,6 +13,7 @@
 #include <cfloat>
 #include <algorithm>
 #include <string>
+#include <vector>
 
 namespace mssql {
 
@@ -147,4 +148,236 @@ void NumericUtils::encode_numeric_struct(const double v,
   numeric.scale = static_cast<SQLSCHAR>(std::min(upscale_limit, scale));
 }
 
+namespace {
+constexpr int max_numeric_digits = 38;
+
+// 128 bit unsigned as 32 bit limbs, least significant first, so the same
+// code runs where the compiler has no native 128 bit type
+struct Uint128 {
+  uint32_t limb[4] = {0, 0, 0, 0};
+};
+
+// value = value * mul + add, false when the result needs more than 128 bits
+bool mul_add(Uint128& value, const uint32_t mul, const uint32_t add) {
+  uint64_t carry = add;
+  for (auto& l : value.limb) {
+    const auto t = static_cast<uint64_t>(l) * mul + carry;
+    l = static_cast<uint32_t>(t);
+    carry = t >> 32;
+  }
+  return carry == 0;
+}
+
+bool less_than(const Uint128& a, const Uint128& b) {
+  for (auto i = 3; i >= 0; --i) {
+    if (a.limb[i] != b.limb[i])
+      return a.limb[i] < b.limb[i];
+  }
+  return false;
+}
+
+// powers[n] = 10^n for n up to 38
+const Uint128* powers_of_ten() {
+  static const auto table = [] {
+    std::vector<Uint128> t(max_numeric_digits + 1);
+    t[0].limb[0] = 1;
+    for (auto i = 1; i <= max_numeric_digits; ++i) {
+      t[i] = t[i - 1];
+      mul_add(t[i], 10, 0);
+    }
+    return t;
+  }();
+  return table.data();
+}
+
+// decimal digits in value, which is below 10^38
+int digit_count(const Uint128& value) {
+  const auto* powers = powers_of_ten();
+  auto digits = 1;
+  while (digits < max_numeric_digits && !less_than(value, powers[digits])) {
+    ++digits;
+  }
+  return digits;
+}
+
+bool scale_up(Uint128& value, int by) {
+  constexpr uint32_t billion = 1000000000;
+  for (; by >= 9; by -= 9) {
+    if (!mul_add(value, billion, 0))
+      return false;
+  }
+  uint32_t mul = 1;
+  for (; by > 0; --by) {
+    mul *= 10;
+  }
+  return mul_add(value, mul, 0);
+}
+
+Uint128 load(const SQL_NUMERIC_STRUCT& numeric) {
+  Uint128 value;
+  for (auto i = 0; i < 16; ++i) {
+    value.limb[i / 4] |= static_cast<uint32_t>(numeric.val[i]) << (8 * (i % 4));
+  }
+  return value;
+}
+
+bool store(const Uint128& value,
+           const bool negative,
+           const int scale,
+           SQL_NUMERIC_STRUCT& numeric,
+           const char*& error) {
+  if (!less_than(value, powers_of_ten()[max_numeric_digits])) {
+    error = "Decimal parameter exceeds 38 digits";
+    return false;
+  }
+  for (auto i = 0; i < 16; ++i) {
+    numeric.val[i] = static_cast<SQLCHAR>(value.limb[i / 4] >> (8 * (i % 4)));
+  }
+  const auto zero = !(value.limb[0] | value.limb[1] | value.limb[2] | value.limb[3]);
+  numeric.sign = negative && !zero ? 0 : 1;
+  numeric.scale = static_cast<SQLSCHAR>(scale);
+  numeric.precision = static_cast<SQLCHAR>(std::max(digit_count(value), std::max(scale, 1)));
+  return true;
+}
+
+bool is_digit(const char c) {
+  return c >= '0' && c <= '9';
+}
+}  // namespace
+
+bool NumericUtils::parse_numeric_string(const char* text,
+                                        size_t len,
+                                        int scale,
+                                        SQL_NUMERIC_STRUCT& numeric,
+                                        const char*& error) {
+  error = "Invalid decimal string parameter";
+  const auto* p = text;
+  const auto* end = text + len;
+  while (p < end && (*p == ' ' || *p == '\t'))
+    ++p;
+  while (end > p && (end[-1] == ' ' || end[-1] == '\t'))
+    --end;
+
+  auto negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  // mantissa as [first, last) with the point, if any, skipped over
+  const auto* first = p;
+  const char* point = nullptr;
+  size_t mantissa_digits = 0;
+  for (; p < end; ++p) {
+    if (is_digit(*p)) {
+      ++mantissa_digits;
+    } else if (*p == '.' && !point) {
+      point = p;
+    } else {
+      break;
+    }
+  }
+  const auto* last = p;
+  if (mantissa_digits == 0)
+    return false;
+
+  long exponent = 0;
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    auto exp_negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      exp_negative = *p == '-';
+      ++p;
+    }
+    if (p == end)
+      return false;
+    for (; p < end && is_digit(*p); ++p) {
+      if (exponent > 1000)
+        return false;
+      exponent = exponent * 10 + (*p - '0');
+    }
+    if (exp_negative)
+      exponent = -exponent;
+  }
+  if (p != end)
+    return false;
+
+  // digits written after the point once the exponent has moved it
+  const long written_scale = (point ? static_cast<long>(last - point - 1) : 0) - exponent;
+  const long target = scale >= 0 ? scale : std::max(0L, written_scale);
+  if (target > max_numeric_digits) {
+    error = "Decimal parameter exceeds 38 digits";
+    return false;
+  }
+
+  // keep digits down to the target scale, nine at a time into the limbs
+  const long dropped = written_scale - target;
+  auto keep = static_cast<long>(mantissa_digits) - std::max(0L, dropped);
+  Uint128 value;
+  uint32_t chunk = 0;
+  uint32_t chunk_mul = 1;
+  auto round_up = false;
+  error = "Decimal parameter exceeds 38 digits";
+  for (const auto* c = first; c < last; ++c) {
+    if (c == point)
+      continue;
+    if (keep <= 0) {
+      round_up = keep == 0 && *c >= '5';
+      break;
+    }
+    --keep;
+    chunk = chunk * 10 + static_cast<uint32_t>(*c - '0');
+    chunk_mul *= 10;
+    if (chunk_mul == 1000000000) {
+      if (!mul_add(value, chunk_mul, chunk))
+        return false;
+      chunk = 0;
+      chunk_mul = 1;
+    }
+  }
+  if (!mul_add(value, chunk_mul, chunk))
+    return false;
+  if (dropped < 0 && !scale_up(value, static_cast<int>(-dropped)))
+    return false;
+  if (round_up && !mul_add(value, 1, 1))
+    return false;
+
+  return store(value, negative, static_cast<int>(target), numeric, error);
+}
+
+bool NumericUtils::encode_numeric_words(const bool negative,
+                                        const uint64_t* words,
+                                        const size_t word_count,
+                                        const int scale,
+                                        SQL_NUMERIC_STRUCT& numeric,
+                                        const char*& error) {
+  error = "Decimal parameter exceeds 38 digits";
+  if (scale < 0 || scale > max_numeric_digits)
+    return false;
+  for (size_t i = 2; i < word_count; ++i) {
+    if (words[i] != 0)
+      return false;
+  }
+  Uint128 value;
+  for (size_t i = 0; i < std::min<size_t>(word_count, 2); ++i) {
+    value.limb[i * 2] = static_cast<uint32_t>(words[i]);
+    value.limb[i * 2 + 1] = static_cast<uint32_t>(words[i] >> 32);
+  }
+  return store(value, negative, scale, numeric, error);
+}
+
+bool NumericUtils::rescale_numeric_struct(SQL_NUMERIC_STRUCT& numeric,
+                                          const int scale,
+                                          const char*& error) {
+  error = "Decimal parameter exceeds 38 digits";
+  if (scale <= numeric.scale)
+    return true;
+  if (scale > max_numeric_digits)
+    return false;
+  auto value = load(numeric);
+  if (!scale_up(value, scale - numeric.scale))
+    return false;
+  return store(value, numeric.sign == 0, scale, numeric, error);
+}
+
 }  // namespace mssql
\ No newline at end of file
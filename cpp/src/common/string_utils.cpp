@@ -200,6 +200,37 @@ std::string StringUtils::U16StringToUtf8(const std::u16string& u16Str) {
   return result;
 }
 
+void StringUtils::AppendUtf16AsUtf8(const uint16_t* str, size_t length, std::string& out) {
+  for (size_t i = 0; i < length; i++) {
+    const uint16_t c = str[i];
+
+    // Handle surrogate pairs
+    if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length) {
+      const uint16_t c2 = str[i + 1];
+      if (c2 >= 0xDC00 && c2 <= 0xDFFF) {
+        const uint32_t codePoint = 0x10000 + (((c - 0xD800) << 10) | (c2 - 0xDC00));
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        i++;
+        continue;
+      }
+    }
+
+    if (c <= 0x7F) {
+      out.push_back(static_cast<char>(c));
+    } else if (c <= 0x7FF) {
+      out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    } else {
+      out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+  }
+}
+
 std::string StringUtils::WideToUtf8(const SQLWCHAR* wideStr, SQLSMALLINT length) {
   if (!wideStr || length <= 0) {
     return "";
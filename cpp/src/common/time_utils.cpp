@@ -212,4 +212,120 @@ void TimeUtils::createTimestampOffsetStruct(double milliseconds,
   result.timezone_minute = offset_minutes % 60;
 }
 
-}  // namespace mssql
\ No newline at end of file
+namespace {
+// 0001-01-01T00:00:00.000Z and 9999-12-31T23:59:59.999Z
+constexpr int64_t min_epoch_ms = -62135596800000LL;
+constexpr int64_t max_epoch_ms = 253402300799999LL;
+
+// whole milliseconds split into days since the epoch and time of day, the
+// sub millisecond part of the double carried as nanoseconds
+struct EpochParts {
+  int64_t days;
+  int64_t ms_of_day;
+  int32_t sub_ms_ns;
+};
+
+inline EpochParts split_epoch_ms(const double milliseconds, const int64_t offset_ms) {
+  const double whole = std::floor(milliseconds);
+  const auto sub_ms_ns = static_cast<int32_t>(std::min(
+      std::lround((milliseconds - whole) * TimeUtils::NANOSECONDS_PER_MS), 999999L));
+  const auto ms = std::min(std::max(static_cast<int64_t>(whole) - offset_ms, min_epoch_ms),
+                           max_epoch_ms);
+  // floor division so times before the epoch fall on the previous day
+  auto days = ms / TimeUtils::ms_per_day;
+  auto ms_of_day = ms % TimeUtils::ms_per_day;
+  if (ms_of_day < 0) {
+    ms_of_day += TimeUtils::ms_per_day;
+    --days;
+  }
+  return EpochParts{days, ms_of_day, sub_ms_ns};
+}
+
+// proleptic gregorian date of a day count from 1970-01-01, integer only
+// (the era based algorithm from Howard Hinnant's date library)
+template <typename DateStruct>
+inline void civil_from_days(int64_t days, DateStruct& out) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const auto doe = static_cast<uint32_t>(days - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const uint32_t mp = (5 * doy + 2) / 153;
+  const uint32_t month = mp < 10 ? mp + 3 : mp - 9;
+  out.year = static_cast<SQLSMALLINT>(static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0));
+  out.month = static_cast<SQLUSMALLINT>(month);
+  out.day = static_cast<SQLUSMALLINT>(doy - (153 * mp + 2) / 5 + 1);
+}
+
+template <typename TimeStruct>
+inline void time_from_ms(const EpochParts& parts, TimeStruct& out) {
+  const auto ms = parts.ms_of_day;
+  out.hour = static_cast<SQLUSMALLINT>(ms / TimeUtils::ms_per_hour);
+  out.minute = static_cast<SQLUSMALLINT>((ms % TimeUtils::ms_per_hour) / TimeUtils::ms_per_minute);
+  out.second = static_cast<SQLUSMALLINT>((ms % TimeUtils::ms_per_minute) / TimeUtils::ms_per_second);
+  out.fraction = static_cast<SQLUINTEGER>((ms % TimeUtils::ms_per_second) * TimeUtils::NANOSECONDS_PER_MS +
+                                          parts.sub_ms_ns);
+}
+}  // namespace
+
+void TimeUtils::toDateStructs(const double* milliseconds,
+                              const size_t count,
+                              const int32_t offset_minutes,
+                              SQL_DATE_STRUCT* out) {
+  const int64_t offset_ms = static_cast<int64_t>(offset_minutes) * ms_per_minute;
+  for (size_t i = 0; i < count; ++i) {
+    if (std::isnan(milliseconds[i])) {
+      continue;
+    }
+    civil_from_days(split_epoch_ms(milliseconds[i], offset_ms).days, out[i]);
+  }
+}
+
+void TimeUtils::toTimeStructs(const double* milliseconds,
+                              const size_t count,
+                              const int32_t offset_minutes,
+                              SQL_SS_TIME2_STRUCT* out) {
+  const int64_t offset_ms = static_cast<int64_t>(offset_minutes) * ms_per_minute;
+  for (size_t i = 0; i < count; ++i) {
+    if (std::isnan(milliseconds[i])) {
+      continue;
+    }
+    time_from_ms(split_epoch_ms(milliseconds[i], offset_ms), out[i]);
+  }
+}
+
+void TimeUtils::toTimestampStructs(const double* milliseconds,
+                                   const size_t count,
+                                   const int32_t offset_minutes,
+                                   SQL_TIMESTAMP_STRUCT* out) {
+  const int64_t offset_ms = static_cast<int64_t>(offset_minutes) * ms_per_minute;
+  for (size_t i = 0; i < count; ++i) {
+    if (std::isnan(milliseconds[i])) {
+      continue;
+    }
+    const auto parts = split_epoch_ms(milliseconds[i], offset_ms);
+    civil_from_days(parts.days, out[i]);
+    time_from_ms(parts, out[i]);
+  }
+}
+
+void TimeUtils::toTimestampOffsetStructs(const double* milliseconds,
+                                         const size_t count,
+                                         const int32_t offset_minutes,
+                                         SQL_SS_TIMESTAMPOFFSET_STRUCT* out) {
+  const auto timezone_hour = static_cast<SQLSMALLINT>(offset_minutes / 60);
+  const auto timezone_minute = static_cast<SQLSMALLINT>(offset_minutes % 60);
+  for (size_t i = 0; i < count; ++i) {
+    if (std::isnan(milliseconds[i])) {
+      continue;
+    }
+    const auto parts = split_epoch_ms(milliseconds[i], 0);
+    auto& ts = out[i];
+    civil_from_days(parts.days, ts);
+    time_from_ms(parts, ts);
+    ts.timezone_hour = timezone_hour;
+    ts.timezone_minute = timezone_minute;
+  }
+}
+
+}  // namespace mssql
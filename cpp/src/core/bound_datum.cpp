@@ -8,6 +8,7 @@
 #include <cstring>
 #include <string>
 #include <ctime>
+#include <limits>
 
 namespace mssql {
 constexpr int sql_server_2008_default_time_precision = 16;
@@ -151,6 +152,7 @@ void BoundDatum::reserve_var_char_array(const size_t max_str_len, const size_t a
       param_size = 0;
     } else {
       param_size = max(buffer_len, static_cast<SQLLEN>(1));
+      sized_from_value = true;
     }
   }
 }
@@ -257,6 +259,7 @@ void BoundDatum::reserve_w_var_char_array(const size_t max_str_len, const size_t
       param_size = max_str_len;
     } else {
       param_size = max(buffer_len / 2, static_cast<SQLLEN>(1));
+      sized_from_value = true;
     }
   }
 }
@@ -389,6 +392,70 @@ void BoundDatum::reserve_var_binary_array(const size_t max_obj_len, const size_t
   buffer = _storage->charvec_ptr->data();
   buffer_len = static_cast<SQLLEN>(max_obj_len) * static_cast<SQLLEN>(size);
   param_size = max_obj_len;
+  sized_from_value = true;
+}
+
+void BoundDatum::apply_size_bucket(const vector<SQLULEN>& buckets) {
+  if (!sized_from_value || is_bcp || is_tvp || param_type != SQL_PARAM_INPUT || param_size == 0) {
+    return;
+  }
+
+  // beyond these the server treats the parameter as max whatever size is sent
+  SQLULEN limit = 0;
+  switch (sql_type) {
+    case SQL_WVARCHAR:
+      limit = 4000;
+      break;
+    case SQL_VARCHAR:
+    case SQL_VARBINARY:
+    case SQL_LONGVARBINARY:
+      limit = 8000;
+      break;
+    default:
+      return;
+  }
+
+  for (const auto bucket : buckets) {
+    if (bucket > limit) {
+      break;
+    }
+    if (bucket >= param_size) {
+      param_size = bucket;
+      return;
+    }
+  }
+}
+
+bool BoundDatum::can_take_value(const BoundDatum& next) const {
+  if (is_data_at_exec() || next.is_data_at_exec() || is_bcp || is_tvp || next.is_bcp || next.is_tvp || param_type != SQL_PARAM_INPUT ||
+      next.param_type != SQL_PARAM_INPUT || _indvec.size() != 1 || next._indvec.size() != 1) {
+    return false;
+  }
+  if (c_type != next.c_type || sql_type != next.sql_type || param_size != next.param_size ||
+      digits != next.digits || is_money != next.is_money ||
+      definedPrecision != next.definedPrecision || definedScale != next.definedScale ||
+      name != next.name) {
+    return false;
+  }
+  if (next.buffer_len > 0 && buffer == nullptr) {
+    return false;
+  }
+  // a shorter string or binary value fits the buffer bound for a longer one
+  switch (c_type) {
+    case SQL_C_CHAR:
+    case SQL_C_WCHAR:
+    case SQL_C_BINARY:
+      return next.buffer_len <= buffer_len;
+    default:
+      return next.buffer_len == buffer_len;
+  }
+}
+
+void BoundDatum::take_value(BoundDatum& next) {
+  if (next.buffer_len > 0 && next.buffer != nullptr) {
+    memcpy(buffer, next.buffer, static_cast<size_t>(next.buffer_len));
+  }
+  _indvec[0] = next._indvec[0];
 }
 
 /*
@@ -482,6 +549,205 @@ void BoundDatum::bind_tvp(const Napi::Object& p) {
   param_size = rows;  // max no of rows.
   _indvec[0] = rows;  // no of rows.
   digits = 0;
+  if (get_as_bool(p, "data_at_exec")) {
+    // row_count is then the batch size, rows are sent once execute asks for them
+    _indvec[0] = SQL_DATA_AT_EXEC;
+  }
+}
+
+bool BoundDatum::bind_tvp_stream(const Napi::Object& p,
+                                 const vector<shared_ptr<BoundDatum>>& columns) {
+  const auto pull = p.Get("pull");
+  if (!pull.IsFunction()) {
+    err = const_cast<char*>("Streamed table parameter requires a pull function");
+    return false;
+  }
+  const auto templates = p.Get("table_value_param").As<Napi::Array>();
+  if (columns.size() != static_cast<size_t>(tvp_no_cols) || templates.Length() != columns.size()) {
+    err = const_cast<char*>("Streamed table parameter has an invalid column");
+    return false;
+  }
+  const auto rows = static_cast<size_t>(param_size);
+  for (uint32_t i = 0; i < columns.size(); ++i) {
+    const auto width = templates.Get(i).As<Napi::Object>().Get("stream_width");
+    const auto chars = width.IsNumber() ? width.ToNumber().Int64Value() : 0;
+    if (!columns[i]->reserve_rows(rows, chars > 0 ? static_cast<size_t>(chars) : 0)) {
+      err = const_cast<char*>("Streamed table parameter has an unsupported column type");
+      return false;
+    }
+  }
+
+  // runs on the js thread while the statement waits in SQLParamData, each
+  // batch is bound as a normal table column and copied into the buffers
+  // reserved above.
+  auto sink = [this, columns](const Napi::Value& value, string& error) {
+    if (!value.IsArray() || value.As<Napi::Array>().Length() != columns.size()) {
+      error = "table stream batch must hold one array per column";
+      return false;
+    }
+    const auto batch = value.As<Napi::Array>();
+    SQLLEN batch_rows = -1;
+    for (uint32_t i = 0; i < batch.Length(); ++i) {
+      BoundDatum next;
+      if (!next.bind(batch.Get(i).As<Napi::Object>())) {
+        error = next.getErr() ? next.getErr() : "table stream batch has an invalid column";
+        return false;
+      }
+      const auto next_rows = static_cast<SQLLEN>(next.get_ind_vec().size());
+      if (batch_rows >= 0 && next_rows != batch_rows) {
+        error = "table stream batch columns differ in length";
+        return false;
+      }
+      batch_rows = next_rows;
+      if (!columns[i]->take_rows(next, error)) {
+        return false;
+      }
+    }
+    _streamRows = batch_rows;
+    return true;
+  };
+  _stream = make_shared<ParamStream>(p.Env(), pull.As<Napi::Function>(), sink);
+  return true;
+}
+
+// bytes per row of a column bound as an array
+size_t BoundDatum::element_size() const {
+  switch (c_type) {
+    case SQL_C_CHAR:
+    case SQL_C_WCHAR:
+    case SQL_C_BINARY:
+    case SQL_C_TYPE_DATE:
+    case SQL_C_TIMESTAMP:
+    case SQL_C_TYPE_TIMESTAMP:
+      return static_cast<size_t>(buffer_len);
+    case SQL_C_BIT:
+    case SQL_C_TINYINT:
+    case SQL_C_STINYINT:
+    case SQL_C_UTINYINT:
+      return sizeof(int8_t);
+    case SQL_C_SHORT:
+    case SQL_C_SSHORT:
+    case SQL_C_USHORT:
+      return sizeof(int16_t);
+    case SQL_C_LONG:
+    case SQL_C_SLONG:
+    case SQL_C_ULONG:
+    case SQL_C_FLOAT:
+      return sizeof(int32_t);
+    case SQL_C_SBIGINT:
+    case SQL_C_UBIGINT:
+    case SQL_C_DOUBLE:
+      return sizeof(int64_t);
+    case SQL_C_NUMERIC:
+      return sizeof(SQL_NUMERIC_STRUCT);
+    default:
+      return 0;
+  }
+}
+
+bool BoundDatum::is_var_length() const {
+  switch (c_type) {
+    case SQL_C_CHAR:
+    case SQL_C_WCHAR:
+      return true;
+    case SQL_C_BINARY:
+      return sql_type != SQL_SS_TIME2 && sql_type != SQL_SS_TIMESTAMPOFFSET;
+    default:
+      return false;
+  }
+}
+
+// move the rows bound so far into a buffer of rows entries, string and binary
+// columns widened to hold width characters or bytes.
+bool BoundDatum::reserve_rows(const size_t rows, const size_t width) {
+  const auto var = is_var_length();
+  const auto stride = element_size();
+  if (!var && stride == 0) {
+    return false;
+  }
+  const auto unit = c_type == SQL_C_WCHAR ? sizeof(uint16_t) : sizeof(char);
+  const auto row_bytes = var ? max(max(stride, width * unit), unit) : stride;
+  vector<char> reserved(rows * row_bytes);
+  const auto bound = min(_indvec.size(), rows);
+  for (size_t i = 0; i < bound && stride > 0; ++i) {
+    memcpy(reserved.data() + i * row_bytes, static_cast<char*>(buffer) + i * stride, stride);
+  }
+  _rowBuffer.swap(reserved);
+  _indvec.resize(rows, SQL_NULL_DATA);
+  buffer = _rowBuffer.data();
+  if (var) {
+    buffer_len = static_cast<SQLLEN>(row_bytes);
+    param_size = max(param_size, static_cast<SQLULEN>(row_bytes / unit));
+    if (c_type == SQL_C_WCHAR && param_size > 4000) {
+      sql_type = SQL_WLONGVARCHAR;
+    } else if (c_type == SQL_C_BINARY && param_size > 8000) {
+      sql_type = SQL_LONGVARBINARY;
+    } else if (c_type == SQL_C_CHAR && param_size > 8000) {
+      sql_type = SQL_LONGVARCHAR;
+    }
+  }
+  return true;
+}
+
+// copy every row of next, bound by the same column type, into this column
+bool BoundDatum::take_rows(const BoundDatum& next, string& error) {
+  if (next.c_type != c_type) {
+    error = "table stream batch column type differs from the table type";
+    return false;
+  }
+  const auto rows = next._indvec.size();
+  if (rows > _indvec.size()) {
+    error = "table stream batch is larger than the batch size";
+    return false;
+  }
+  const auto stride = is_var_length() ? static_cast<size_t>(buffer_len) : element_size();
+  const auto next_stride = next.element_size();
+  auto* const base = static_cast<char*>(buffer);
+  for (size_t i = 0; i < rows; ++i) {
+    const auto ind = next._indvec[i];
+    _indvec[i] = ind;
+    if (ind == SQL_NULL_DATA) {
+      continue;
+    }
+    const auto bytes = is_var_length() ? static_cast<size_t>(ind) : stride;
+    if (bytes > stride || bytes > next_stride) {
+      error = "table stream value is longer than its column";
+      return false;
+    }
+    memcpy(base + i * stride, static_cast<const char*>(next.buffer) + i * next_stride, bytes);
+  }
+  return true;
+}
+
+// no value is bound, the length at exec indicator makes execute return
+// SQL_NEED_DATA and the statement then streams the value in with SQLPutData.
+bool BoundDatum::bind_data_at_exec(const Napi::Object& p) {
+  const auto pull = p.Get("pull");
+  if (!pull.IsFunction()) {
+    err = const_cast<char*>("Stream parameter requires a pull function");
+    return false;
+  }
+  sql_type = static_cast<SQLSMALLINT>(p.Get("sql_type").ToNumber().Int32Value());
+  switch (sql_type) {
+    case SQL_WLONGVARCHAR:
+      c_type = SQL_C_WCHAR;
+      break;
+    case SQL_LONGVARBINARY:
+      c_type = SQL_C_BINARY;
+      break;
+    default:
+      err = const_cast<char*>("Stream parameter must be varbinary(max) or nvarchar(max)");
+      return false;
+  }
+  _stream = make_shared<ParamStream>(p.Env(), pull.As<Napi::Function>());
+  param_type = SQL_PARAM_INPUT;
+  param_size = 0;
+  digits = 0;
+  buffer = this;
+  buffer_len = 0;
+  _indvec.resize(1);
+  _indvec[0] = SQL_LEN_DATA_AT_EXEC(0);
+  return true;
 }
 
 void BoundDatum::bind_binary(const Napi::Object& p) {
@@ -680,6 +946,100 @@ void BoundDatum::bind_numeric_array(const Napi::Object& p) {
   }
 }
 
+// strings and BigInt carry decimals a double cannot, e.g. decimal(38,10).
+// a BigInt is the value already multiplied by 10^scale.
+
+static bool is_exact_numeric(const Napi::Value& v) {
+  return v.IsString() || v.IsBigInt();
+}
+
+static bool has_exact_numeric(const Napi::Array& arr) {
+  const auto len = arr.Length();
+  for (uint32_t i = 0; i < len; ++i) {
+    if (is_exact_numeric(arr[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BoundDatum::encode_exact_numeric(const Napi::Value& v,
+                                      const int scale,
+                                      SQL_NUMERIC_STRUCT& ns) {
+  const char* error = nullptr;
+  auto ok = false;
+  if (v.IsBigInt()) {
+    int sign_bit = 0;
+    uint64_t words[3] = {0, 0, 0};
+    size_t word_count = 3;
+    v.As<Napi::BigInt>().ToWords(&sign_bit, &word_count, words);
+    error = "Decimal parameter exceeds 38 digits";
+    ok = word_count <= 3 &&
+         NumericUtils::encode_numeric_words(
+             sign_bit != 0, words, word_count, std::max(scale, 0), ns, error);
+  } else {
+    // numbers mixed into a column of strings go via their shortest js form
+    const auto text = v.ToString().Utf8Value();
+    ok = NumericUtils::parse_numeric_string(text.c_str(), text.size(), scale, ns, error);
+  }
+  if (!ok) {
+    err = const_cast<char*>(error);
+  }
+  return ok;
+}
+
+void BoundDatum::bind_exact_numeric(const Napi::Value& p) {
+  reserve_numeric(1);
+  auto& ns = (*_storage->numeric_ptr)[0];
+  _indvec[0] = SQL_NULL_DATA;
+  // a declared scale of 0 rounds to whole numbers, only no scale takes the value's own
+  if (!encode_exact_numeric(p, definedScale ? digits : -1, ns)) {
+    return;
+  }
+  if (param_size <= 0)
+    param_size = ns.precision;
+  if (!definedScale)
+    digits = ns.scale;
+  _indvec[0] = sizeof(SQL_NUMERIC_STRUCT);
+}
+
+// the column is bound at one precision and scale, so without a declared
+// scale each value is parsed at its own and then raised to the widest.
+
+void BoundDatum::bind_exact_numeric_array(const Napi::Array& arr) {
+  const auto len = arr.Length();
+  reserve_numeric(len);
+  auto& vec = *_storage->numeric_ptr;
+  const auto scale = definedScale ? static_cast<int>(digits) : -1;
+  auto widest = 0;
+  for (uint32_t i = 0; i < len; ++i) {
+    _indvec[i] = SQL_NULL_DATA;
+    const Napi::Value elem = arr[i];
+    if (elem.IsNull() || elem.IsUndefined())
+      continue;
+    if (!encode_exact_numeric(elem, scale, vec[i]))
+      return;
+    widest = std::max(widest, static_cast<int>(vec[i].scale));
+    _indvec[i] = sizeof(SQL_NUMERIC_STRUCT);
+  }
+
+  SQLULEN precision = 0;
+  for (uint32_t i = 0; i < len; ++i) {
+    if (_indvec[i] == SQL_NULL_DATA)
+      continue;
+    const char* error = nullptr;
+    if (!NumericUtils::rescale_numeric_struct(vec[i], widest, error)) {
+      err = const_cast<char*>(error);
+      return;
+    }
+    precision = std::max(precision, static_cast<SQLULEN>(vec[i].precision));
+  }
+  if (param_size <= 0)
+    param_size = precision;
+  if (!definedScale)
+    digits = static_cast<SQLSMALLINT>(widest);
+}
+
 void BoundDatum::reserve_numeric(const SQLLEN len) {
   definedPrecision = true;
   buffer_len = len * sizeof(SQL_NUMERIC_STRUCT);
@@ -884,6 +1244,33 @@ void BoundDatum::reserve_date(SQLLEN len) {
   }
 }
 
+// a date column as epoch milliseconds with NaN for null. a Float64Array, as
+// lib/param-descriptor.js sends for typed date arrays, is used in place.
+const double* BoundDatum::epoch_ms_column(const Napi::Object& p,
+                                          vector<double>& scratch,
+                                          size_t& len) {
+  if (p.IsTypedArray() && p.As<Napi::TypedArray>().TypedArrayType() == napi_float64_array) {
+    const auto typed = p.As<Napi::Float64Array>();
+    len = typed.ElementLength();
+    return typed.Data();
+  }
+  const auto arr = p.As<Napi::Array>();
+  len = arr.Length();
+  scratch.resize(len);
+  for (uint32_t i = 0; i < len; ++i) {
+    const Napi::Value elem = arr[i];
+    scratch[i] = elem.IsNull() || elem.IsUndefined() ? std::numeric_limits<double>::quiet_NaN()
+                                                     : elem.ToNumber().DoubleValue();
+  }
+  return scratch.data();
+}
+
+void BoundDatum::set_date_indicators(const double* ms, const size_t len, const SQLLEN width) {
+  for (size_t i = 0; i < len; ++i) {
+    _indvec[i] = std::isnan(ms[i]) ? SQL_NULL_DATA : width;
+  }
+}
+
 void BoundDatum::bind_date(const Napi::Object& p) {
   reserve_date(1);
   auto& vec = *_storage->datevec_ptr;
@@ -899,39 +1286,21 @@ void BoundDatum::bind_date(const Napi::Object& p) {
 }
 
 void BoundDatum::bind_date_array(const Napi::Object& p) {
-  const auto arr = p.As<Napi::Array>();
-  const auto len = arr.Length();
-  reserve_date(len);
-  auto& vec = *_storage->datevec_ptr;
-  for (uint32_t i = 0; i < len; ++i) {
-    _indvec[i] = SQL_NULL_DATA;
-    const auto elem = arr[i];
-    if (!elem.IsNull() && !elem.IsUndefined()) {
-      const auto d = elem.ToNumber().DoubleValue();
-      auto& dt = vec[i];
-      auto v = TimeUtils::createDateStruct(d, offset / 1000);
-      dt = v;
-      _indvec[i] = sizeof(SQL_DATE_STRUCT);
-    }
-  }
+  vector<double> scratch;
+  size_t len = 0;
+  const auto* ms = epoch_ms_column(p, scratch, len);
+  reserve_date(static_cast<SQLLEN>(len));
+  TimeUtils::toDateStructs(ms, len, offset / 1000, _storage->datevec_ptr->data());
+  set_date_indicators(ms, len, sizeof(SQL_DATE_STRUCT));
 }
 
 void BoundDatum::bind_time_array(const Napi::Object& p) {
-  const auto arr = p.As<Napi::Array>();
-  const auto len = arr.Length();
-  reserve_time(len);
-  auto& vec = *_storage->time2vec_ptr;
-  for (uint32_t i = 0; i < len; ++i) {
-    _indvec[i] = SQL_NULL_DATA;
-    const auto elem = arr[i];
-    if (!elem.IsNull() && !elem.IsUndefined()) {
-      const auto d = elem.ToNumber().DoubleValue();
-      auto& time2 = vec[i];
-      auto v = TimeUtils::createTimeStruct(d, offset / 1000);
-      time2 = v;
-      _indvec[i] = sizeof(SQL_SS_TIME2_STRUCT);
-    }
-  }
+  vector<double> scratch;
+  size_t len = 0;
+  const auto* ms = epoch_ms_column(p, scratch, len);
+  reserve_time(static_cast<SQLLEN>(len));
+  TimeUtils::toTimeStructs(ms, len, offset / 1000, _storage->time2vec_ptr->data());
+  set_date_indicators(ms, len, sizeof(SQL_SS_TIME2_STRUCT));
 }
 
 void BoundDatum::bind_time(const Napi::Object& p) {
@@ -985,22 +1354,12 @@ void BoundDatum::bind_time_stamp(const Napi::Object& p) {
 }
 
 void BoundDatum::bind_time_stamp_array(const Napi::Object& p) {
-  const auto arr = p.As<Napi::Array>();
-  const auto len = arr.Length();
-  reserve_time_stamp(len);
-  auto& vec = *_storage->timestampvec_ptr;
-  for (uint32_t i = 0; i < len; ++i) {
-    _indvec[i] = SQL_NULL_DATA;
-    const auto elem = arr[i];
-    if (!elem.IsNull() && !elem.IsUndefined()) {
-      // dates in JS are stored internally as ms count from Jan 1, 1970
-      const auto d = elem.ToNumber().DoubleValue();
-      auto& ts = vec[i];
-      auto v = TimeUtils::createTimestampStruct(d, offset / 1000);
-      ts = v;
-      _indvec[i] = sizeof(SQL_TIMESTAMP_STRUCT);
-    }
-  }
+  vector<double> scratch;
+  size_t len = 0;
+  const auto* ms = epoch_ms_column(p, scratch, len);
+  reserve_time_stamp(static_cast<SQLLEN>(len));
+  TimeUtils::toTimestampStructs(ms, len, offset / 1000, _storage->timestampvec_ptr->data());
+  set_date_indicators(ms, len, sizeof(SQL_TIMESTAMP_STRUCT));
 }
 
 void BoundDatum::reserve_time_stamp(const SQLLEN len) {
@@ -1061,21 +1420,14 @@ void BoundDatum::reserve_time_stamp_offset(SQLLEN len) {
 }
 
 void BoundDatum::bind_time_stamp_offset_array(const Napi::Object& p) {
-  const auto arr = p.As<Napi::Array>();
-  const auto len = arr.Length();
-  reserve_time_stamp_offset(len);
-  auto& vec = *_storage->timestampoffsetvec_ptr;
+  vector<double> scratch;
+  size_t len = 0;
+  const auto* ms = epoch_ms_column(p, scratch, len);
+  reserve_time_stamp_offset(static_cast<SQLLEN>(len));
   buffer_len = sizeof(SQL_SS_TIMESTAMPOFFSET_STRUCT);
-  for (uint32_t i = 0; i < len; ++i) {
-    _indvec[i] = SQL_NULL_DATA;
-    const auto elem = arr[i];
-    if (!elem.IsNull() && !elem.IsUndefined()) {
-      const auto d = elem.ToNumber().DoubleValue();
-      auto& ts = vec[i];
-      TimeUtils::createTimestampOffsetStruct(d, 0, offset / 1000, ts);
-      _indvec[i] = sizeof(SQL_SS_TIMESTAMPOFFSET_STRUCT);
-    }
-  }
+  TimeUtils::toTimestampOffsetStructs(
+      ms, len, offset / 1000, _storage->timestampoffsetvec_ptr->data());
+  set_date_indicators(ms, len, sizeof(SQL_SS_TIMESTAMPOFFSET_STRUCT));
 }
 
 void BoundDatum::bind_integer(const Napi::Object& p) {
@@ -1586,6 +1938,11 @@ void BoundDatum::assign_precision(Napi::Object& pv) {
           table_name_str.Utf16Value().length() > 0) {
         _storage->table = wide_from_js_string(table_name_str);
       }
+      const auto hints_str = get_as_string(pv, "bcp_hints");
+      if (!hints_str.IsNull() && !hints_str.IsUndefined() &&
+          hints_str.Utf16Value().length() > 0) {
+        _storage->bcp_hints = wide_from_js_string(hints_str);
+      }
       const auto position = get("ordinal_position", pv);
       if (!position.IsUndefined()) {
         ordinal_position = position.ToNumber().Int32Value();
@@ -1596,6 +1953,7 @@ void BoundDatum::assign_precision(Napi::Object& pv) {
   const auto scale = get("scale", pv);
   if (!scale.IsUndefined()) {
     digits = scale.ToNumber().Int32Value();
+    definedScale = true;
   }
 
   const auto off = get("offset", pv);
@@ -1716,7 +2074,9 @@ void BoundDatum::sql_smallint(const Napi::Object pp) {
 
 void BoundDatum::sql_decimal(const Napi::Object pp) {
   if (pp.IsArray()) {
-    if (is_bcp) {
+    if (has_exact_numeric(pp.As<Napi::Array>())) {
+      bind_exact_numeric_array(pp.As<Napi::Array>());
+    } else if (is_bcp) {
       bind_numeric_array(pp);
     } else {
       bind_decimal_array(pp);
@@ -1728,7 +2088,11 @@ void BoundDatum::sql_decimal(const Napi::Object pp) {
 
 void BoundDatum::sql_numeric(const Napi::Object pp) {
   if (pp.IsArray()) {
-    bind_numeric_array(pp);
+    if (has_exact_numeric(pp.As<Napi::Array>())) {
+      bind_exact_numeric_array(pp.As<Napi::Array>());
+    } else {
+      bind_numeric_array(pp);
+    }
   } else {
     bind_numeric(pp);
   }
@@ -1759,7 +2123,7 @@ void BoundDatum::sql_varchar(const Napi::Object pp) {
 }
 
 void BoundDatum::sql_ss_time2(const Napi::Object pp) {
-  if (pp.IsArray()) {
+  if (pp.IsArray() || pp.IsTypedArray()) {
     bind_time_array(pp);
   } else {
     bind_time(pp);
@@ -1767,7 +2131,7 @@ void BoundDatum::sql_ss_time2(const Napi::Object pp) {
 }
 
 void BoundDatum::sql_type_date(const Napi::Object pp) {
-  if (pp.IsArray()) {
+  if (pp.IsArray() || pp.IsTypedArray()) {
     bind_date_array(pp);
   } else {
     bind_date(pp);
@@ -1775,7 +2139,7 @@ void BoundDatum::sql_type_date(const Napi::Object pp) {
 }
 
 void BoundDatum::sql_type_timestamp(const Napi::Object pp) {
-  if (pp.IsArray()) {
+  if (pp.IsArray() || pp.IsTypedArray()) {
     bind_time_stamp_array(pp);
   } else {
     bind_time_stamp(pp);
@@ -1783,7 +2147,7 @@ void BoundDatum::sql_type_timestamp(const Napi::Object pp) {
 }
 
 void BoundDatum::sql_ss_timestampoffset(const Napi::Object pp) {
-  if (pp.IsArray()) {
+  if (pp.IsArray() || pp.IsTypedArray()) {
     bind_time_stamp_offset_array(pp);
   } else {
     bind_time_stamp_offset(pp);
@@ -1838,7 +2202,43 @@ bool BoundDatum::user_bind(const Napi::Object& p, const Napi::Object& v) {
 
   Napi::Object p_obj = p.As<Napi::Object>();
   assign_precision(p_obj);
+  return bind_typed_value(pp);
+}
+
+// the packed form of user_bind - js has already read the type, precision and
+// scale into an Int32Array so the only property access left is the value.
+bool BoundDatum::bind_packed(const Napi::Value& value, const int32_t* descriptor) {
+  sql_type = static_cast<SQLSMALLINT>(descriptor[packed_sql_type]);
+  if (sql_type == 0)
+    return false;
+
+  if (value.IsNull() || value.IsUndefined()) {
+    bind_null(value.As<Napi::Object>());
+    return true;
+  }
 
+  const auto flags = descriptor[packed_flags];
+  if (flags & packed_has_precision) {
+    param_size = descriptor[packed_precision];
+  }
+  if (flags & packed_has_max_length) {
+    max_length = descriptor[packed_max_length];
+  }
+  if (flags & packed_money) {
+    is_money = true;
+  }
+  if (flags & packed_has_scale) {
+    digits = static_cast<SQLSMALLINT>(descriptor[packed_scale]);
+    definedScale = true;
+  }
+  if (flags & packed_has_offset) {
+    offset = descriptor[packed_offset];
+  }
+  return bind_typed_value(value);
+}
+
+bool BoundDatum::bind_typed_value(const Napi::Value& pp) {
+  const auto p = pp.As<Napi::Object>();
   switch (sql_type) {
     case SQL_LONGVARBINARY:
       if (pp.IsObject()) {
@@ -1986,21 +2386,29 @@ bool BoundDatum::user_bind(const Napi::Object& p, const Napi::Object& v) {
     case SQL_DECIMAL:
       if (pp.IsNumber()) {
         bind_decimal(pp.As<Napi::Object>());
+      } else if (is_exact_numeric(pp)) {
+        bind_exact_numeric(pp);
       } else if (pp.IsObject()) {
         sql_decimal(pp.As<Napi::Object>());
       } else {
         bind_null(p);
       }
+      if (err)
+        return false;
       break;
 
     case SQL_NUMERIC:
       if (pp.IsNumber()) {
         bind_numeric(pp.As<Napi::Object>());
+      } else if (is_exact_numeric(pp)) {
+        bind_exact_numeric(pp);
       } else if (pp.IsObject()) {
         sql_numeric(pp.As<Napi::Object>());
       } else {
         bind_null(p);
       }
+      if (err)
+        return false;
       break;
 
     case SQL_CHAR:
@@ -2141,6 +2549,10 @@ bool BoundDatum::bind_object(const Napi::Object& p) {
     return proc_bind(p.Env(), p, p);
   }
 
+  if (get_as_bool(p, "data_at_exec")) {
+    return bind_data_at_exec(p);
+  }
+
   v = get("sql_type", p);
   if (!v.IsUndefined()) {
     return user_bind(p, p);
@@ -69,16 +69,46 @@ bool BoundDatumSet::tvp(Napi::Object& v) const {
   return true;
 }
 
+// the column bindings tvp has just added follow their table binding
+bool BoundDatumSet::tvp_stream(const std::shared_ptr<BoundDatum>& table, const Napi::Object& v) {
+  const auto cols = static_cast<size_t>(table->tvp_no_cols);
+  if (_bindings->size() < cols + 1) {
+    return table->bind_tvp_stream(v, {});
+  }
+  const std::vector<std::shared_ptr<BoundDatum>> columns(_bindings->end() - cols, _bindings->end());
+  return table->bind_tvp_stream(v, columns);
+}
+
+// the descriptor array is only used when it holds an entry for every parameter
+const int32_t* BoundDatumSet::packed_descriptors(const Napi::Array& node_params) {
+  const auto packed = node_params.Get("descriptors");
+  if (!packed.IsTypedArray()) {
+    return nullptr;
+  }
+  const auto typed = packed.As<Napi::TypedArray>();
+  if (typed.TypedArrayType() != napi_int32_array ||
+      typed.ElementLength() != static_cast<size_t>(node_params.Length()) * packed_stride) {
+    return nullptr;
+  }
+  return packed.As<Napi::Int32Array>().Data();
+}
+
 bool BoundDatumSet::bind(const Napi::Array& node_params) {
   const auto count = node_params.Length();
   auto res = true;
   _output_param_count = 0;
+  const auto descriptors = packed_descriptors(node_params);
   if (count > 0) {
     for (uint32_t i = 0; i < count; ++i) {
       const auto binding = make_shared<BoundDatum>();
       Napi::Value elem = node_params[static_cast<uint32_t>(i)];
       Napi::Object v = elem.As<Napi::Object>();
-      res = binding->bind(v);
+      const auto* descriptor = descriptors ? descriptors + i * packed_stride : nullptr;
+      if (descriptor && descriptor[packed_kind] == packed_typed) {
+        res = binding->bind_packed(elem, descriptor);
+      } else {
+        res = binding->bind(v);
+      }
 
       switch (binding->param_type) {
         case SQL_PARAM_OUTPUT:
@@ -102,6 +132,14 @@ bool BoundDatumSet::bind(const Napi::Array& node_params) {
         const auto col_count = get_tvp_col_count(v);
         binding->tvp_no_cols = col_count;
         res = tvp(v);
+        if (res && v.Get("data_at_exec").ToBoolean().Value()) {
+          res = tvp_stream(binding, v);
+          if (!res) {
+            err = binding->getErr();
+            first_error = i;
+            break;
+          }
+        }
       }
     }
   }
@@ -109,6 +147,71 @@ bool BoundDatumSet::bind(const Napi::Array& node_params) {
   return res;
 }
 
+// tvp column bindings follow their table binding and describe the table
+// type, they are left at the size the type was declared with.
+void BoundDatumSet::apply_size_buckets(const std::vector<SQLULEN>& buckets) {
+  if (buckets.empty()) {
+    return;
+  }
+  int tvp_cols = 0;
+  for (const auto& binding : *_bindings) {
+    if (tvp_cols > 0) {
+      --tvp_cols;
+      continue;
+    }
+    if (binding->is_tvp) {
+      tvp_cols = binding->tvp_no_cols;
+      continue;
+    }
+    binding->apply_size_bucket(buckets);
+  }
+}
+
+// the parts of each binding the server uses to match a cached plan
+size_t BoundDatumSet::signature_hash() const {
+  size_t seed = _bindings->size();
+  const auto combine = [&seed](const size_t v) {
+    seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  for (const auto& binding : *_bindings) {
+    combine(static_cast<size_t>(binding->sql_type));
+    combine(static_cast<size_t>(binding->param_size));
+    combine(static_cast<size_t>(binding->digits));
+    combine(static_cast<size_t>(binding->param_type));
+  }
+  return seed;
+}
+
+bool BoundDatumSet::take_values(BoundDatumSet& next) {
+  if (_bindings->size() != next._bindings->size()) {
+    return false;
+  }
+  for (size_t i = 0; i < _bindings->size(); ++i) {
+    if (!(*_bindings)[i]->can_take_value(*(*next._bindings)[i])) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < _bindings->size(); ++i) {
+    (*_bindings)[i]->take_value(*(*next._bindings)[i]);
+  }
+  return true;
+}
+
+bool BoundDatumSet::has_data_at_exec() const {
+  return std::any_of(_bindings->begin(), _bindings->end(), [](const shared_ptr<BoundDatum>& b) {
+    return b->is_data_at_exec();
+  });
+}
+
+std::shared_ptr<BoundDatum> BoundDatumSet::data_at_exec(SQLPOINTER token) const {
+  for (const auto& binding : *_bindings) {
+    if (binding->is_data_at_exec() && binding->buffer == token) {
+      return binding;
+    }
+  }
+  return nullptr;
+}
+
 Napi::Array BoundDatumSet::unbind(Napi::Env& env) const {
   auto arr = Napi::Array::New(env, _output_param_count);
   auto i = 0;
@@ -0,0 +1,133 @@
+#include <platform.h>
+#include <core/param_stream.h>
+
+#include <utils/Logger.h>
+
+namespace mssql {
+
+ParamStream::ParamStream(Napi::Env env, Napi::Function pull)
+    : _channel(std::make_shared<Channel>()),
+      _pull(Napi::ThreadSafeFunction::New(env, pull, "ParamStream", 0, 1)) {
+  // a statement which is never executed must not hold the event loop open
+  _pull.Unref(env);
+}
+
+ParamStream::ParamStream(Napi::Env env, Napi::Function pull, Sink sink)
+    : ParamStream(env, pull) {
+  _channel->sink = std::move(sink);
+}
+
+ParamStream::~ParamStream() {
+  {
+    // a late deliver from js must not reach a sink whose buffers are gone
+    std::lock_guard lock(_channel->mutex);
+    _channel->sink = nullptr;
+    _channel->done = true;
+    _channel->ready = true;
+  }
+  _pull.Release();
+}
+
+bool ParamStream::Next(std::vector<char>& chunk, const Abort& abort) {
+  if (!pull_next(abort)) {
+    return false;
+  }
+  std::lock_guard lock(_channel->mutex);
+  chunk.swap(_channel->chunk);
+  return true;
+}
+
+bool ParamStream::Next(const Abort& abort) {
+  return pull_next(abort);
+}
+
+bool ParamStream::pull_next(const Abort& abort) {
+  const auto channel = _channel;
+  {
+    std::lock_guard lock(channel->mutex);
+    if (channel->done) {
+      return false;
+    }
+    channel->ready = false;
+    channel->chunk.clear();
+  }
+
+  // pull is called as pull(deliver), deliver(err, value) with a null value
+  // ending the stream. it may be called later from any js callback.
+  auto call = [channel](Napi::Env env, Napi::Function jsPull) {
+    const auto deliver = Napi::Function::New(env, [channel](const Napi::CallbackInfo& info) {
+      std::lock_guard lock(channel->mutex);
+      if (channel->ready) {
+        return;
+      }
+      const auto err = info.Length() > 0 ? info[0] : info.Env().Undefined();
+      const auto data = info.Length() > 1 ? info[1] : info.Env().Undefined();
+      if (!err.IsNull() && !err.IsUndefined()) {
+        channel->error = err.IsObject() ? err.As<Napi::Object>().Get("message").ToString().Utf8Value()
+                                        : err.ToString().Utf8Value();
+        channel->done = true;
+      } else if (data.IsNull() || data.IsUndefined()) {
+        channel->done = true;
+      } else if (channel->sink) {
+        if (!channel->sink(data, channel->error)) {
+          channel->done = true;
+        }
+      } else if (data.IsBuffer()) {
+        const auto buffer = data.As<Napi::Buffer<char>>();
+        channel->chunk.assign(buffer.Data(), buffer.Data() + buffer.Length());
+      } else {
+        channel->done = true;
+      }
+      channel->ready = true;
+      channel->ready_cv.notify_one();
+    });
+    try {
+      jsPull.Call({deliver});
+    } catch (const std::exception& e) {
+      std::lock_guard lock(channel->mutex);
+      if (!channel->ready) {
+        channel->error = e.what();
+        channel->done = true;
+        channel->ready = true;
+        channel->ready_cv.notify_one();
+      }
+    }
+  };
+
+  if (_pull.BlockingCall(call) != napi_ok) {
+    std::lock_guard lock(channel->mutex);
+    channel->error = "parameter stream is closed";
+    channel->done = true;
+    return false;
+  }
+
+  std::unique_lock lock(channel->mutex);
+  const auto ready = [&channel]() { return channel->ready; };
+  while (!channel->ready_cv.wait_for(lock, poll_interval, ready)) {
+    std::string reason;
+    if (abort && abort(reason)) {
+      // a deliver arriving after this is ignored
+      channel->error = reason;
+      channel->done = true;
+      channel->ready = true;
+      SQL_LOG_DEBUG_STREAM("ParamStream::Next aborted " << reason);
+      return false;
+    }
+  }
+  if (channel->done) {
+    SQL_LOG_DEBUG_STREAM("ParamStream::Next end of stream " << channel->error);
+    return false;
+  }
+  return true;
+}
+
+bool ParamStream::HasError() const {
+  std::lock_guard lock(_channel->mutex);
+  return !_channel->error.empty();
+}
+
+std::string ParamStream::Error() const {
+  std::lock_guard lock(_channel->mutex);
+  return _channel->error;
+}
+}  // namespace mssql
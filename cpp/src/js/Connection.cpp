@@ -15,16 +15,23 @@
 #include <js/workers/close_worker.h>
 #include <js/workers/fetch_rows_worker.h>
 #include <js/workers/next_result_worker.h>
+#include <js/workers/pipeline_worker.h>
 #include <js/workers/open_worker.h>
 #include <js/workers/bind_query_worker.h>
 #include <js/workers/query_worker.h>
 #include <js/workers/prepare_worker.h>
 #include <js/workers/release_worker.h>
+#include <js/workers/abandon_worker.h>
 #include <js/workers/cancel_worker.h>
 #include <js/workers/unbind_worker.h>
 #include <js/workers/begin_transaction_worker.h>
 #include <js/workers/commit_worker.h>
 #include <js/workers/rollback_worker.h>
+#include <js/workers/bcp_file_worker.h>
+#include <js/workers/export_worker.h>
+#include <js/workers/execute_many_worker.h>
+#include <js/workers/transaction_worker.h>
+#include <js/workers/batch_worker.h>
 #include <js/workers/worker_base.h>
 #include <odbc/odbc_connection.h>
 #include <odbc/odbc_connection_factory.h>
@@ -58,13 +65,29 @@ Napi::Object Connection::Init(Napi::Env env, Napi::Object exports) {
                       InstanceMethod("prepare", &Connection::Prepare),
                       InstanceMethod("fetchRows", &Connection::FetchRows),
                       InstanceMethod("nextResultSet", &Connection::NextResultSet),
+                      InstanceMethod("pipeline", &Connection::Pipeline),
                       InstanceMethod("releaseStatement", &Connection::ReleaseStatement),
+                      InstanceMethod("abandonStatement", &Connection::AbandonStatement),
                       InstanceMethod("cancelQuery", &Connection::CancelQuery),
                       InstanceMethod("callProcedure", &Connection::Query),
                       InstanceMethod("unbind", &Connection::Unbind),
                       InstanceMethod("beginTransaction", &Connection::BeginTransaction),
                       InstanceMethod("commit", &Connection::Commit),
                       InstanceMethod("rollback", &Connection::Rollback),
+                      InstanceMethod("bcpFile", &Connection::BcpFile),
+                      InstanceMethod("exportQuery", &Connection::ExportQuery),
+                      InstanceMethod("executeMany", &Connection::ExecuteMany),
+                      InstanceMethod("transaction", &Connection::Transaction),
+                      InstanceMethod("batch", &Connection::Batch),
+                      InstanceMethod("setParamSizeBuckets", &Connection::SetParamSizeBuckets),
+                      InstanceMethod("getParamSignatureCount",
+                                     &Connection::GetParamSignatureCount),
+                      InstanceMethod("setStatementCache", &Connection::SetStatementCache),
+                      InstanceMethod("getStatementCacheStats",
+                                     &Connection::GetStatementCacheStats),
+                      InstanceMethod("setStatementPoolSize", &Connection::SetStatementPoolSize),
+                      InstanceMethod("getStatementPoolStats",
+                                     &Connection::GetStatementPoolStats),
                   });
 
   // Create persistent reference to constructor
@@ -392,6 +415,43 @@ Napi::Value Connection::NextResultSet(const Napi::CallbackInfo& info) {
       info, odbcConnection_.get(), statementHandle);
 }
 
+// pipeline(queryId, handle, options, ['fetchRows', 'nextResultSet', 'release'], cb)
+Napi::Value Connection::Pipeline(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  InfoParser parser(isConnected_);
+  if (!parser.parseStatementHandle(info)) {
+    return env.Undefined();
+  }
+  const auto statementHandle = parser.statementHandle;
+
+  if (!parser.parseQueryOptions(info)) {
+    return env.Undefined();
+  }
+  const auto options = parser.options;
+
+  if (info.Length() < 4 || !info[3].IsArray()) {
+    Napi::TypeError::New(env, "pipeline steps expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const auto names = info[3].As<Napi::Array>();
+  std::vector<PipelineStep> steps;
+  steps.reserve(names.Length());
+  for (uint32_t i = 0; i < names.Length(); ++i) {
+    PipelineStep step;
+    const Napi::Value name = names[i];
+    if (!name.IsString() || !PipelineWorker::ParseStep(name.As<Napi::String>().Utf8Value(), step)) {
+      Napi::TypeError::New(env, "unknown pipeline step").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    steps.push_back(step);
+  }
+
+  return CreateWorkerWithCallbackOrPromise<PipelineWorker>(
+      info, odbcConnection_.get(), statementHandle, options, std::move(steps));
+}
+
 Napi::Value Connection::CallProc(const Napi::CallbackInfo& info) {
   const Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -433,6 +493,24 @@ Napi::Value Connection::ReleaseStatement(const Napi::CallbackInfo& info) {
       info, odbcConnection_.get(), statementHandle);
 }
 
+// abandonStatement(queryId, handle, release, cb)
+Napi::Value Connection::AbandonStatement(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  InfoParser parser(isConnected_);
+  if (!parser.parseStatementHandle(info)) {
+    return env.Undefined();
+  }
+  const auto statementHandle = parser.statementHandle;
+  // a prepared statement keeps its handle to be executed again
+  const auto release =
+      info.Length() < 3 || !info[2].IsBoolean() || info[2].As<Napi::Boolean>().Value();
+
+  return CreateWorkerWithCallbackOrPromise<AbandonWorker>(
+      info, odbcConnection_.get(), statementHandle, release);
+}
+
 Napi::Value Connection::Prepare(const Napi::CallbackInfo& info) {
   const Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -603,4 +681,270 @@ Napi::Value Connection::Rollback(const Napi::CallbackInfo& info) {
   // Use the generic worker factory
   return CreateWorkerWithCallbackOrPromise<RollbackWorker>(info, odbcConnection_.get(), this);
 }
-}  // namespace mssql
\ No newline at end of file
+
+Napi::Value Connection::BcpFile(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isConnected_) {
+    Napi::TypeError::New(env, "Connection is closed").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "bcp file options expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const auto options = JsObjectMapper::toBcpFileOptions(info[0].As<Napi::Object>());
+  if (options->table_name.empty() || options->file_name.empty() || options->columns.empty()) {
+    Napi::TypeError::New(env, "bcp file options require table_name, file_name and columns")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  SQL_LOG_DEBUG_STREAM("Connection::BcpFile: " << options->toString());
+
+  return CreateWorkerWithCallbackOrPromise<BcpFileWorker>(info, odbcConnection_.get(), options);
+}
+
+// exportQuery(queryId, queryObj, params, exportOptions, callback)
+Napi::Value Connection::ExportQuery(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  InfoParser parser(isConnected_);
+  if (!parser.parseOperationParams(info)) {
+    return env.Undefined();
+  }
+
+  const auto operationParams = parser.operationParams;
+  operationParams->id = parser.queryId;
+
+  Napi::Array params = Napi::Array::New(env, 0);
+  if (info.Length() > 2 && info[2].IsArray()) {
+    params = info[2].As<Napi::Array>();
+  }
+
+  if (info.Length() < 4 || !info[3].IsObject()) {
+    Napi::TypeError::New(env, "export options expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const auto exportObj = info[3].As<Napi::Object>();
+  const auto options = JsObjectMapper::toExportOptions(exportObj);
+  if (options->fd < 0) {
+    Napi::TypeError::New(env, "export options require a file descriptor")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Function progressCallback;
+  if (exportObj.Has("progress") && exportObj.Get("progress").IsFunction()) {
+    progressCallback = exportObj.Get("progress").As<Napi::Function>();
+  }
+
+  SQL_LOG_DEBUG_STREAM("Connection::ExportQuery: " << operationParams->toString() << " "
+                                                    << options->toString());
+
+  return CreateWorkerWithCallbackOrPromise<ExportWorker>(
+      info, odbcConnection_.get(), operationParams, params, options, progressCallback);
+}
+
+// executeMany(queryId, [[p1, p2], [p1, p2], ...], options, callback)
+Napi::Value Connection::ExecuteMany(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  InfoParser parser(isConnected_);
+  if (!parser.parseQueryId(info)) {
+    return env.Undefined();
+  }
+  const auto queryId = parser.queryId;
+
+  if (info.Length() < 2 || !info[1].IsArray()) {
+    Napi::TypeError::New(env, "array of parameter sets expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const auto paramSets = info[1].As<Napi::Array>();
+
+  auto options = std::make_shared<ExecuteManyOptions>();
+  if (info.Length() > 2 && info[2].IsObject() && !info[2].IsFunction()) {
+    options = JsObjectMapper::toExecuteManyOptions(info[2].As<Napi::Object>());
+  }
+
+  SQL_LOG_DEBUG_STREAM("Connection::ExecuteMany: " << queryId << " sets " << paramSets.Length()
+                                                   << " " << options->toString());
+
+  return CreateWorkerWithCallbackOrPromise<ExecuteManyWorker>(
+      info, odbcConnection_.get(), queryId, paramSets, options);
+}
+
+// transaction([{query, params}, ...], options, callback)
+Napi::Value Connection::Transaction(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isConnected_) {
+    Napi::Error::New(env, "Connection is not open").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "array of statements expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const auto statements = info[0].As<Napi::Array>();
+
+  auto options = std::make_shared<TransactionOptions>();
+  if (info.Length() > 1 && info[1].IsObject() && !info[1].IsFunction()) {
+    options = JsObjectMapper::toTransactionOptions(info[1].As<Napi::Object>());
+  }
+
+  SQL_LOG_DEBUG_STREAM("Connection::Transaction: statements " << statements.Length() << " "
+                                                              << options->toString());
+
+  return CreateWorkerWithCallbackOrPromise<TransactionWorker>(
+      info, odbcConnection_.get(), statements, options);
+}
+
+// batch(queryId, queryObj, params, { marker, lines, batch_size }, callback)
+Napi::Value Connection::Batch(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  InfoParser parser(isConnected_);
+  if (!parser.parseOperationParams(info)) {
+    return env.Undefined();
+  }
+
+  const auto operationParams = parser.operationParams;
+  operationParams->id = parser.queryId;
+  // the results are all read on the worker thread
+  operationParams->polling = false;
+
+  Napi::Array params = Napi::Array::New(env, 0);
+  if (info.Length() > 2 && info[2].IsArray()) {
+    params = info[2].As<Napi::Array>();
+  }
+
+  if (info.Length() < 4 || !info[3].IsObject() || info[3].IsFunction()) {
+    Napi::TypeError::New(env, "batch options expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const auto options = JsObjectMapper::toBatchOptions(info[3].As<Napi::Object>());
+
+  SQL_LOG_DEBUG_STREAM("Connection::Batch: " << operationParams->toString() << " "
+                                              << options->toString());
+
+  return CreateWorkerWithCallbackOrPromise<BatchWorker>(
+      info, odbcConnection_.get(), operationParams, params, options);
+}
+
+// setParamSizeBuckets([32, 128, 512, 4000]) - synchronous, an empty array disables
+Napi::Value Connection::SetParamSizeBuckets(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "array of parameter sizes expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const auto arr = info[0].As<Napi::Array>();
+  std::vector<SQLULEN> buckets;
+  buckets.reserve(arr.Length());
+  for (uint32_t i = 0; i < arr.Length(); ++i) {
+    const Napi::Value v = arr[i];
+    if (!v.IsNumber() || v.As<Napi::Number>().Int64Value() <= 0) {
+      Napi::TypeError::New(env, "parameter sizes must be positive numbers")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    buckets.push_back(static_cast<SQLULEN>(v.As<Napi::Number>().Int64Value()));
+  }
+
+  if (odbcConnection_) {
+    odbcConnection_->SetParamSizeBuckets(buckets);
+  }
+  return env.Undefined();
+}
+
+Napi::Value Connection::GetParamSignatureCount(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  const auto count = odbcConnection_ ? odbcConnection_->GetParamSignatureCount() : 0;
+  return Napi::Number::New(env, static_cast<double>(count));
+}
+
+// setStatementCache(threshold, capacity, maxBytes) - synchronous, a capacity of 0 disables
+Napi::Value Connection::SetStatementCache(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 3 || !info[0].IsNumber() || !info[1].IsNumber() || !info[2].IsNumber()) {
+    Napi::TypeError::New(env, "threshold, capacity and maxBytes expected")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const auto threshold = info[0].As<Napi::Number>().Int64Value();
+  const auto capacity = info[1].As<Napi::Number>().Int64Value();
+  const auto maxBytes = info[2].As<Napi::Number>().Int64Value();
+  if (threshold < 0 || capacity < 0 || maxBytes < 0) {
+    Napi::TypeError::New(env, "threshold, capacity and maxBytes must not be negative")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (odbcConnection_) {
+    odbcConnection_->SetStatementCache(static_cast<uint32_t>(threshold),
+                                       static_cast<size_t>(capacity),
+                                       static_cast<size_t>(maxBytes));
+  }
+  return env.Undefined();
+}
+
+Napi::Value Connection::GetStatementCacheStats(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  const auto stats = odbcConnection_ ? odbcConnection_->GetStatementCacheStats()
+                                     : StatementCacheStats{};
+  auto result = Napi::Object::New(env);
+  result.Set("size", Napi::Number::New(env, static_cast<double>(stats.size)));
+  result.Set("bytes", Napi::Number::New(env, static_cast<double>(stats.bytes)));
+  result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+  result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+  result.Set("evictions", Napi::Number::New(env, static_cast<double>(stats.evictions)));
+  result.Set("invalidations", Napi::Number::New(env, static_cast<double>(stats.invalidations)));
+  return result;
+}
+
+// setStatementPoolSize(size) - synchronous, a size of 0 frees each statement handle on release
+Napi::Value Connection::SetStatementPoolSize(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber() || info[0].As<Napi::Number>().Int64Value() < 0) {
+    Napi::TypeError::New(env, "non negative pool size expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (odbcConnection_) {
+    odbcConnection_->SetStatementPoolSize(
+        static_cast<size_t>(info[0].As<Napi::Number>().Int64Value()));
+  }
+  return env.Undefined();
+}
+
+Napi::Value Connection::GetStatementPoolStats(const Napi::CallbackInfo& info) {
+  const Napi::Env env = info.Env();
+  const auto stats = odbcConnection_ ? odbcConnection_->GetStatementPoolStats()
+                                     : ConnectionHandles::StatementPoolStats{};
+  auto result = Napi::Object::New(env);
+  result.Set("allocated", Napi::Number::New(env, static_cast<double>(stats.allocated)));
+  result.Set("reused", Napi::Number::New(env, static_cast<double>(stats.reused)));
+  result.Set("recycled", Napi::Number::New(env, static_cast<double>(stats.recycled)));
+  result.Set("discarded", Napi::Number::New(env, static_cast<double>(stats.discarded)));
+  result.Set("idle", Napi::Number::New(env, static_cast<double>(stats.idle)));
+  return result;
+}
+}  // namespace mssql
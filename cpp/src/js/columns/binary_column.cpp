@@ -9,6 +9,18 @@ BinaryColumn::BinaryColumn(const int id, shared_ptr<DatumStorageLegacy> s, size_
 BinaryColumn::BinaryColumn(const int id, shared_ptr<DatumStorageLegacy> s, size_t offset, size_t l)
     : Column(id), storage(s->charvec_ptr), len(l), offset(offset) {}
 
+BinaryColumn::BinaryColumn(const int id, shared_ptr<DatumStorageLegacy::char_vec_t> s, size_t l)
+    : Column(id), storage(s), len(l), offset(0) {}
+
+std::shared_ptr<Column> BinaryColumn::Detached() const {
+  if (!Borrowed() || !storage) {
+    return nullptr;
+  }
+  const auto* const begin = storage->data() + offset;
+  auto owned = std::make_shared<DatumStorageLegacy::char_vec_t>(begin, begin + len);
+  return std::make_shared<BinaryColumn>(Id(), owned, len);
+}
+
 Napi::Object BinaryColumn::ToString(Napi::Env env) {
   const auto* const ptr = storage->data() + offset;
   const std::string s(ptr, ptr + len);
@@ -25,6 +37,20 @@ Napi::Object BinaryColumn::ToString(Napi::Env env) {
   return Napi::String::New(env, hex).As<Napi::Object>();
 }
 
+void BinaryColumn::AppendText(std::string& out) const {
+  static constexpr char hex_digits[] = "0123456789ABCDEF";
+  if (!storage) {
+    return;
+  }
+  const auto* const ptr = storage->data() + offset;
+  out.reserve(out.size() + len * 2);
+  for (size_t i = 0; i < len; ++i) {
+    const auto b = static_cast<unsigned char>(ptr[i]);
+    out.push_back(hex_digits[b >> 4]);
+    out.push_back(hex_digits[b & 0x0F]);
+  }
+}
+
 Napi::Object BinaryColumn::ToNative(Napi::Env env) {
   const auto* const ptr = storage->data() + offset;
   // Create a copy of the binary data in a Buffer
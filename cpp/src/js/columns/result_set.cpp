@@ -25,6 +25,32 @@ void ResultSet::add_column(const size_t row_id, const shared_ptr<Column>& column
   row[column->Id()] = column;
 }
 
+size_t ResultSet::byte_size() const {
+  size_t bytes = 0;
+  for (const auto& row : _rows) {
+    for (const auto& column : row) {
+      if (column) {
+        bytes += column->ByteSize();
+      }
+    }
+  }
+  return bytes;
+}
+
+void ResultSet::detach() {
+  for (auto& row : _rows) {
+    for (auto& column : row) {
+      if (!column) {
+        continue;
+      }
+      auto owned = column->Detached();
+      if (owned) {
+        column = owned;
+      }
+    }
+  }
+}
+
 Napi::Object ResultSet::get_entry(Napi::Env env, const ColumnDefinition& definition) {
   return JsObjectMapper::fromColumnDefinition(env, definition);
 }
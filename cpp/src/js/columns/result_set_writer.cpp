@@ -0,0 +1,219 @@
+#include <platform.h>
+#include <common/odbc_common.h>
+#include <common/string_utils.h>
+#include <js/columns/result_set_writer.h>
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef PLATFORM_WINDOWS
+#include <io.h>
+#define EXPORT_WRITE _write
+#else
+#include <unistd.h>
+#define EXPORT_WRITE write
+#endif
+
+namespace mssql {
+
+ResultSetWriter::ResultSetWriter(const ExportOptions& options)
+    : _options(options), _rows(0), _bytes(0) {
+  _buffer.reserve(_options.buffer_size + 4096);
+}
+
+char ResultSetWriter::separator() const {
+  return _options.format == ExportFormat::Tsv ? '\t' : ',';
+}
+
+bool ResultSetWriter::Start(const std::vector<ColumnDefinition>& metadata) {
+  _names.clear();
+  for (const auto& def : metadata) {
+    const auto name = StringUtils::WideToUtf8(def.name.data(), def.colNameLen);
+    if (_options.format == ExportFormat::NdJson) {
+      // pre-render the "name": prefix once rather than per row
+      std::string prefix;
+      append_json(name, prefix);
+      prefix.push_back(':');
+      _names.push_back(prefix);
+    } else {
+      _names.push_back(name);
+    }
+  }
+
+  if (!_options.header || _options.format == ExportFormat::NdJson) {
+    return true;
+  }
+
+  for (size_t c = 0; c < _names.size(); ++c) {
+    if (c > 0) {
+      _buffer.push_back(separator());
+    }
+    if (_options.format == ExportFormat::Csv) {
+      append_csv(_names[c]);
+    } else {
+      append_tsv(_names[c]);
+    }
+  }
+  _buffer.push_back('\n');
+  return true;
+}
+
+bool ResultSetWriter::WriteRows(const ResultSet& resultset) {
+  const auto rows = resultset.get_result_count();
+  const auto columns = resultset.get_column_count();
+  const bool json = _options.format == ExportFormat::NdJson;
+
+  for (size_t r = 0; r < rows; ++r) {
+    if (json) {
+      _buffer.push_back('{');
+    }
+    for (size_t c = 0; c < columns; ++c) {
+      if (c > 0) {
+        _buffer.push_back(json ? ',' : separator());
+      }
+      if (json && c < _names.size()) {
+        _buffer += _names[c];
+      }
+      const auto column = resultset.get_column(r, c);
+      if (!column || column->IsNull()) {
+        _buffer += json ? "null" : _options.null_value;
+        continue;
+      }
+      append_field(*column);
+    }
+    if (json) {
+      _buffer.push_back('}');
+    }
+    _buffer.push_back('\n');
+    ++_rows;
+
+    if (_buffer.size() >= _options.buffer_size && !Flush()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ResultSetWriter::append_field(const Column& column) {
+  _scratch.clear();
+  column.AppendText(_scratch);
+
+  switch (_options.format) {
+    case ExportFormat::Csv:
+      // an empty string is quoted so it can be told apart from a null
+      if (column.IsTextual() && _scratch.empty()) {
+        _buffer += "\"\"";
+      } else {
+        append_csv(_scratch);
+      }
+      break;
+
+    case ExportFormat::Tsv:
+      append_tsv(_scratch);
+      break;
+
+    case ExportFormat::NdJson:
+      if (column.IsTextual()) {
+        append_json(_scratch, _buffer);
+      } else {
+        _buffer += _scratch;
+      }
+      break;
+  }
+}
+
+// rfc 4180 - quote the field when it holds the separator, a quote or a line break
+void ResultSetWriter::append_csv(const std::string& text) {
+  if (text.find_first_of(",\"\r\n") == std::string::npos) {
+    _buffer += text;
+    return;
+  }
+  _buffer.push_back('"');
+  for (const auto ch : text) {
+    if (ch == '"') {
+      _buffer.push_back('"');
+    }
+    _buffer.push_back(ch);
+  }
+  _buffer.push_back('"');
+}
+
+// tab, line breaks and backslash are escaped so each row stays on one line
+void ResultSetWriter::append_tsv(const std::string& text) {
+  for (const auto ch : text) {
+    switch (ch) {
+      case '\t':
+        _buffer += "\\t";
+        break;
+      case '\n':
+        _buffer += "\\n";
+        break;
+      case '\r':
+        _buffer += "\\r";
+        break;
+      case '\\':
+        _buffer += "\\\\";
+        break;
+      default:
+        _buffer.push_back(ch);
+        break;
+    }
+  }
+}
+
+void ResultSetWriter::append_json(const std::string& text, std::string& out) {
+  static constexpr char hex_digits[] = "0123456789abcdef";
+  out.push_back('"');
+  for (const auto ch : text) {
+    const auto u = static_cast<unsigned char>(ch);
+    switch (ch) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (u < 0x20) {
+          out += "\\u00";
+          out.push_back(hex_digits[u >> 4]);
+          out.push_back(hex_digits[u & 0x0F]);
+        } else {
+          out.push_back(ch);
+        }
+        break;
+    }
+  }
+  out.push_back('"');
+}
+
+bool ResultSetWriter::Flush() {
+  const char* ptr = _buffer.data();
+  size_t remaining = _buffer.size();
+  while (remaining > 0) {
+    const auto chunk = static_cast<unsigned int>(std::min<size_t>(remaining, 1 << 30));
+    const auto written = EXPORT_WRITE(_options.fd, ptr, chunk);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      _error = std::string("export write failed: ") + strerror(errno);
+      return false;
+    }
+    ptr += written;
+    remaining -= static_cast<size_t>(written);
+    _bytes += written;
+  }
+  _buffer.clear();
+  return true;
+}
+}  // namespace mssql
@@ -158,4 +158,23 @@ void TimestampColumn::DateFromMilliseconds(SQL_SS_TIMESTAMPOFFSET_STRUCT& date)
   date.timezone_hour = offset_minutes / 60;
   date.timezone_minute = offset_minutes % 60;
 }
-}  // namespace mssql
\ No newline at end of file
+
+void TimestampColumn::AppendText(std::string& out) const {
+  SQL_SS_TIMESTAMPOFFSET_STRUCT ts;
+  DateFromMilliseconds(ts);
+  // fraction from the milliseconds plus the sub millisecond remainder, as 100ns ticks
+  const auto ticks = (static_cast<int64_t>(ts.fraction) + nanoseconds_delta) / 100;
+  char buf[40];
+  snprintf(buf,
+           sizeof(buf),
+           "%04d-%02u-%02uT%02u:%02u:%02u.%07lldZ",
+           static_cast<int>(ts.year),
+           static_cast<unsigned>(ts.month),
+           static_cast<unsigned>(ts.day),
+           static_cast<unsigned>(ts.hour),
+           static_cast<unsigned>(ts.minute),
+           static_cast<unsigned>(ts.second),
+           static_cast<long long>(ticks));
+  out += buf;
+}
+}  // namespace mssql
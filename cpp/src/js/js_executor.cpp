@@ -0,0 +1,64 @@
+#include <platform.h>
+#include <js/js_executor.h>
+
+#include <common/executor_pool.h>
+#include <utils/Logger.h>
+
+#include <utility>
+
+namespace mssql {
+
+std::shared_ptr<JsExecutor> JsExecutor::ForEnv(Napi::Env env) {
+  // the env deletes its reference on teardown, workers still running keep theirs
+  auto* executor = env.GetInstanceData<std::shared_ptr<JsExecutor>>();
+  if (!executor) {
+    executor = new std::shared_ptr<JsExecutor>(std::make_shared<JsExecutor>(env));
+    env.SetInstanceData(executor);
+  }
+  return *executor;
+}
+
+JsExecutor::JsExecutor(Napi::Env env)
+    : env_(env),
+      closing_(std::make_shared<Closing>()),
+      completion_(Napi::ThreadSafeFunction::New(
+          env,
+          Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+          "msnodesqlv8",
+          0,
+          1,
+          [closing = closing_](Napi::Env) {
+            std::lock_guard<std::mutex> lock(closing->mutex);
+            closing->closed = true;
+          })) {
+  // referenced from the first Queue until the last Done
+  completion_.Unref(env);
+}
+
+void JsExecutor::Queue(const void* key, Job job) {
+  if (in_flight_++ == 0) {
+    completion_.Ref(env_);
+  }
+  ExecutorPool::GetInstance().Submit(key, std::move(job));
+}
+
+void JsExecutor::Post(Job complete) {
+  std::lock_guard<std::mutex> lock(closing_->mutex);
+  if (closing_->closed) {
+    SQL_LOG_DEBUG("JsExecutor::Post after the env closed, completion dropped");
+    return;
+  }
+  const auto status = completion_.NonBlockingCall(
+      [complete = std::move(complete)](Napi::Env, Napi::Function) { complete(); });
+  if (status != napi_ok) {
+    SQL_LOG_ERROR_STREAM("JsExecutor::Post failed to reach js " << status);
+  }
+}
+
+void JsExecutor::Done() {
+  if (in_flight_ > 0 && --in_flight_ == 0) {
+    completion_.Unref(env_);
+  }
+}
+
+}  // namespace mssql
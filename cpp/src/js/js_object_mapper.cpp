@@ -116,6 +116,11 @@ std::shared_ptr<QueryOperationParams> JsObjectMapper::toQueryOperationParams(
   result->numeric_string = safeGetBool(jsObject, "numeric_string");
   result->bigint_as_native = safeGetBool(jsObject, "bigint_as_native");
   result->polling = safeGetBool(jsObject, "query_polling");
+  result->first_batch_size = safeGetInt32(jsObject, "first_batch_size");
+  const auto read_ahead_bytes = safeGetInt64(jsObject, "read_ahead_bytes");
+  result->read_ahead_bytes = read_ahead_bytes > 0 ? static_cast<size_t>(read_ahead_bytes) : 0;
+  result->unbind_on_end = safeGetBool(jsObject, "unbind_on_end");
+  result->release_on_end = safeGetBool(jsObject, "release_on_end");
   return result;
 }
 
@@ -175,6 +180,94 @@ QueryOptions JsObjectMapper::toQueryOptions(const Napi::Object& jsObject) {
   return result;
 }
 
+std::shared_ptr<BcpFileOptions> JsObjectMapper::toBcpFileOptions(const Napi::Object& jsObject) {
+  auto result = std::make_shared<BcpFileOptions>();
+
+  result->table_name = safeGetWideString(jsObject, "table_name");
+  result->file_name = safeGetWideString(jsObject, "file_name");
+  result->error_file = safeGetWideString(jsObject, "error_file");
+  result->field_terminator = safeGetString(jsObject, "field_terminator", ",");
+  result->row_terminator = safeGetString(jsObject, "row_terminator", "\n");
+  result->hints = safeGetWideString(jsObject, "hints");
+  result->first_row = safeGetInt32(jsObject, "first_row");
+  result->last_row = safeGetInt32(jsObject, "last_row");
+  result->batch_size = safeGetInt32(jsObject, "batch_size");
+  result->max_errors = safeGetInt32(jsObject, "max_errors");
+  result->code_page = safeGetInt32(jsObject, "code_page");
+  result->bcp_version = safeGetInt32(jsObject, "bcp_version", 17);
+  result->unicode = safeGetBool(jsObject, "unicode");
+  result->keep_nulls = safeGetBool(jsObject, "keep_nulls");
+
+  if (jsObject.Has("columns") && jsObject.Get("columns").IsArray()) {
+    const auto columns = jsObject.Get("columns").As<Napi::Array>();
+    for (uint32_t i = 0; i < columns.Length(); ++i) {
+      result->columns.push_back(columns.Get(i).ToNumber().Int32Value());
+    }
+  }
+
+  return result;
+}
+
+std::shared_ptr<ExportOptions> JsObjectMapper::toExportOptions(const Napi::Object& jsObject) {
+  auto result = std::make_shared<ExportOptions>();
+
+  result->fd = safeGetInt32(jsObject, "fd", -1);
+  const auto format = safeGetString(jsObject, "format", "csv");
+  if (format == "tsv") {
+    result->format = ExportFormat::Tsv;
+  } else if (format == "ndjson") {
+    result->format = ExportFormat::NdJson;
+  }
+  result->header = safeGetBool(jsObject, "header", true);
+  result->null_value = safeGetString(jsObject, "null_value");
+  const auto buffer_size = safeGetInt32(jsObject, "buffer_size", 1024 * 1024);
+  result->buffer_size = static_cast<size_t>(std::max(buffer_size, 4096));
+  const auto batch_size = safeGetInt32(jsObject, "batch_size", 5000);
+  result->batch_size = static_cast<size_t>(std::max(batch_size, 1));
+  const auto interval = safeGetInt32(jsObject, "progress_interval_ms", 250);
+  result->progress_interval_ms = static_cast<uint32_t>(std::max(interval, 0));
+
+  return result;
+}
+
+std::shared_ptr<ExecuteManyOptions> JsObjectMapper::toExecuteManyOptions(
+    const Napi::Object& jsObject) {
+  auto result = std::make_shared<ExecuteManyOptions>();
+
+  result->stop_on_error = safeGetBool(jsObject, "stop_on_error", false);
+  const auto batch_size = safeGetInt32(jsObject, "batch_size", 5000);
+  result->batch_size = static_cast<size_t>(std::max(batch_size, 1));
+
+  return result;
+}
+
+std::shared_ptr<TransactionOptions> JsObjectMapper::toTransactionOptions(
+    const Napi::Object& jsObject) {
+  auto result = std::make_shared<TransactionOptions>();
+
+  const auto batch_size = safeGetInt32(jsObject, "batch_size", 5000);
+  result->batch_size = static_cast<size_t>(std::max(batch_size, 1));
+
+  return result;
+}
+
+std::shared_ptr<BatchOptions> JsObjectMapper::toBatchOptions(const Napi::Object& jsObject) {
+  auto result = std::make_shared<BatchOptions>();
+
+  const auto batch_size = safeGetInt32(jsObject, "batch_size", 5000);
+  result->batch_size = static_cast<size_t>(std::max(batch_size, 1));
+  result->marker = safeGetString(jsObject, "marker");
+  if (jsObject.Has("lines") && jsObject.Get("lines").IsArray()) {
+    const auto lines = jsObject.Get("lines").As<Napi::Array>();
+    for (uint32_t i = 0; i < lines.Length(); ++i) {
+      const Napi::Value line = lines[i];
+      result->lines.push_back(line.IsNumber() ? line.As<Napi::Number>().Int32Value() : 0);
+    }
+  }
+
+  return result;
+}
+
 // Helper function to decode SqlParamValue into DatumStorage
 void JsObjectMapper::decodeIntoStorage(const Napi::Object& jsObject, SqlParameter& param) {
   // Local template function for writing int values
@@ -0,0 +1,48 @@
+#include <js/workers/abandon_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <platform.h>
+
+namespace mssql {
+
+AbandonWorker::AbandonWorker(Napi::Function& callback,
+                             IOdbcConnection* connection,
+                             const StatementHandle& statementHandle,
+                             const bool release)
+    : OdbcAsyncWorker(callback, connection),
+      statementHandle_(statementHandle),
+      release_(release) {}
+
+void AbandonWorker::Execute() {
+  try {
+    SQL_LOG_DEBUG_STREAM("Executing AbandonWorker for statement: "
+                         << statementHandle_.toString() << " release " << release_);
+    const auto statement = connection_->GetStatement(statementHandle_.getStatementId());
+    if (!statement) {
+      SetError("Statement not found");
+      return;
+    }
+    if (!statement->Abandon()) {
+      errorDetails_ = connection_->GetErrors();
+    }
+    // released even when the close failed, the handle is reset on checkin
+    if (release_) {
+      released_ = connection_->RemoveStatement(statementHandle_.getStatementId());
+    }
+    if (!errorDetails_.empty()) {
+      SetError(errorDetails_[0]->message);
+    }
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in AbandonWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  }
+}
+
+void AbandonWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG("AbandonWorker::OnOK");
+  Callback().Call({env.Null(), Napi::Boolean::New(env, released_)});
+}
+}  // namespace mssql
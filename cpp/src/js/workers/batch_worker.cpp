@@ -0,0 +1,235 @@
+#include <js/workers/batch_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <common/string_utils.h>
+#include <core/bound_datum_set.h>
+#include <js/js_object_mapper.h>
+#include <odbc/odbc_connection.h>
+#include <odbc/odbc_statement.h>
+#include <platform.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace mssql {
+
+BatchWorker::BatchWorker(Napi::Function& callback,
+                         IOdbcConnection* connection,
+                         const std::shared_ptr<QueryOperationParams> query,
+                         const Napi::Array& params,
+                         const std::shared_ptr<BatchOptions> options)
+    : OdbcAsyncWorker(callback, connection), query_(query), options_(options) {
+  SQL_LOG_DEBUG_STREAM("BatchWorker " << options_->toString() << " number params "
+                                      << params.Length());
+  outcomes_.resize(options_->lines.size());
+  parameters_ = std::make_shared<BoundDatumSet>(query_);
+  if (!parameters_->bind(params)) {
+    SQL_LOG_ERROR_STREAM("Failed to bind parameters: " << parameters_->err);
+    SetError("IMNOD: [msnodesql] Parameter " + std::to_string(parameters_->first_error + 1) +
+             ": " + parameters_->err);
+    has_error_ = true;
+  }
+  result_ = std::make_shared<QueryResult>();
+}
+
+void BatchWorker::Execute() {
+  if (has_error_ || outcomes_.empty()) {
+    return;
+  }
+  try {
+    bool errored = false;
+    // false is also returned for an execute with info messages
+    if (!connection_->ExecuteQuery(query_, parameters_, result_)) {
+      const auto errors = connection_->GetErrors();
+      if (errors.empty()) {
+        connection_->RemoveStatement(result_->getHandle().getStatementId());
+        SetError("Failed to execute batch");
+        return;
+      }
+      const auto failed = route(errors, 0);
+      if (failed < outcomes_.size()) {
+        if (!continues(errors)) {
+          ended_at(failed);
+          connection_->RemoveStatement(result_->getHandle().getStatementId());
+          return;
+        }
+        // the first statement failed, the server runs on with the rest
+        errored = true;
+      }
+    }
+    const auto statementId = result_->getHandle().getStatementId();
+    const auto statement = connection_->GetStatement(statementId);
+    if (!statement) {
+      SetError("Statement not found");
+      return;
+    }
+    read_results(statement, errored);
+    connection_->RemoveStatement(statementId);
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in BatchWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  } catch (...) {
+    SQL_LOG_ERROR("Unknown exception in BatchWorker::Execute");
+    SetError("Unknown exception occurred");
+  }
+}
+
+// each result up to a marker belongs to the current statement, recorded as
+// js would have read it - the first as the metadata, the rest as steps. a
+// statement error has no result of its own, SQLMoreResults is called again
+// to move on to whatever the server ran next.
+void BatchWorker::read_results(const std::shared_ptr<IOdbcStatement>& statement, bool errored) {
+  const auto handle = result_->getHandle();
+  auto next = result_;
+  size_t current = 0;
+  while (current < outcomes_.size()) {
+    auto& outcome = outcomes_[current];
+    outcome.executed = true;
+    if (errored) {
+      errored = false;
+    } else if (is_marker(*next)) {
+      if (outcome.steps) {
+        // js counts the rows affected by the last result as it ends
+        const auto end = std::make_shared<QueryResult>(handle);
+        end->set_end_of_rows(true);
+        end->set_end_of_results(true);
+        outcome.steps->NextResultSet(end);
+      }
+      ++current;
+    } else {
+      if (!outcome.metadata) {
+        outcome.metadata = next;
+        outcome.steps = std::make_unique<StatementSteps>(connection_, handle);
+      } else {
+        outcome.steps->NextResultSet(next);
+      }
+      if (next->size() > 0) {
+        bool end_of_rows = false;
+        while (!end_of_rows) {
+          end_of_rows = outcome.steps->FetchRows(statement, options_->batch_size);
+          if (outcome.steps->Failed()) {
+            // js routes the errors of the fetch step to this statement
+            if (!continues(outcome.steps->LastErrors())) {
+              ended_at(current);
+              return;
+            }
+            break;
+          }
+        }
+        if (outcome.steps->FetchedToEnd()) {
+          ended_at(current);
+          return;
+        }
+      }
+    }
+
+    next = std::make_shared<QueryResult>(handle);
+    connection_->TryReadNextResult(handle.getStatementId(), next);
+    const auto errors = connection_->GetErrors();
+    const auto failed = route(errors, current);
+    if (failed < outcomes_.size() && continues(errors)) {
+      errored = true;
+      continue;
+    }
+    if (failed < outcomes_.size() || next->is_end_of_results()) {
+      if (current < outcomes_.size() && outcomes_[current].steps) {
+        outcomes_[current].steps->NextResultSet(next);
+      }
+      ended_at(failed < outcomes_.size() ? failed : current);
+      return;
+    }
+  }
+}
+
+// the server raises a statement error with a severity below 20 and goes on
+// with the batch, a driver error or a fatal one ends the read.
+bool BatchWorker::continues(const std::vector<std::shared_ptr<OdbcError>>& errors) {
+  for (const auto& error : errors) {
+    if (!StatementSteps::is_info(*error) && (error->severity <= 0 || error->severity >= 20)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BatchWorker::is_marker(const QueryResult& result) const {
+  if (result.size() != 1) {
+    return false;
+  }
+  const auto column = result.get(0);
+  return StringUtils::WideToUtf8(column.name.data(), column.colNameLen) == options_->marker;
+}
+
+// a message raised by the batch itself carries the line it came from, one
+// from inside a procedure goes to the statement being read. the index of
+// the statement with the first error is returned, else the statement count.
+size_t BatchWorker::route(const std::vector<std::shared_ptr<OdbcError>>& errors,
+                          const size_t current) {
+  auto failed = outcomes_.size();
+  for (const auto& error : errors) {
+    auto owner = std::min(current, outcomes_.size() - 1);
+    if (error->procName.empty() && error->lineNumber > 0) {
+      for (size_t i = 0; i < options_->lines.size(); ++i) {
+        if (static_cast<int64_t>(error->lineNumber) >= options_->lines[i]) {
+          owner = i;
+        }
+      }
+    }
+    outcomes_[owner].errors.push_back(error);
+    if (failed == outcomes_.size() && !StatementSteps::is_info(*error)) {
+      failed = owner;
+    }
+  }
+  return failed;
+}
+
+// the batch was aborted, statements after the one that ended it never ran
+// and are told so. the one that ended it keeps its own errors.
+void BatchWorker::ended_at(const size_t current) {
+  SQL_LOG_DEBUG_STREAM("BatchWorker ended at statement " << current << " of "
+                                                         << outcomes_.size());
+  for (size_t i = 0; i < outcomes_.size(); ++i) {
+    auto& outcome = outcomes_[i];
+    if (i != current && !outcome.executed && outcome.errors.empty()) {
+      outcome.errors.push_back(std::make_shared<OdbcError>(
+          "IMNOD", "[msnodesql] batch ended before this statement ran", 0));
+    }
+  }
+}
+
+Napi::Object BatchWorker::to_value(Napi::Env env, const StatementOutcome& outcome) const {
+  auto value = Napi::Object::New(env);
+  value.Set("executed", Napi::Boolean::New(env, outcome.executed));
+  if (outcome.metadata) {
+    value.Set("meta", JsObjectMapper::fromNativeQueryResult(env, outcome.metadata));
+  }
+  if (outcome.steps) {
+    value.Set("steps", outcome.steps->ToValue(env));
+  }
+
+  auto errors = Napi::Array::New(env, outcome.errors.size());
+  for (size_t e = 0; e < outcome.errors.size(); ++e) {
+    errors.Set(static_cast<uint32_t>(e),
+               JsObjectMapper::fromOdbcError(env, *outcome.errors[e]).Value());
+  }
+  value.Set("errors", errors);
+  return value;
+}
+
+void BatchWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG("BatchWorker::OnOK");
+
+  try {
+    auto statements = Napi::Array::New(env, outcomes_.size());
+    for (size_t i = 0; i < outcomes_.size(); ++i) {
+      statements.Set(static_cast<uint32_t>(i), to_value(env, outcomes_[i]));
+    }
+    Callback().Call({env.Null(), statements});
+  } catch (const std::exception& e) {
+    Callback().Call({Napi::Error::New(env, e.what()).Value(), env.Null()});
+  }
+}
+}  // namespace mssql
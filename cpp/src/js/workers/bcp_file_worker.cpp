@@ -0,0 +1,50 @@
+#include <js/workers/bcp_file_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <odbc/odbc_connection.h>
+
+namespace mssql {
+BcpFileWorker::BcpFileWorker(Napi::Function& callback,
+                             IOdbcConnection* connection,
+                             const std::shared_ptr<BcpFileOptions> options)
+    : OdbcAsyncWorker(callback, connection), options_(options) {
+  SQL_LOG_DEBUG_STREAM("BcpFileWorker constructor " << options_->toString());
+}
+
+void BcpFileWorker::Execute() {
+  try {
+    SQL_LOG_DEBUG("Executing BcpFileWorker");
+
+    if (!connection_->BcpFile(options_, rowsCopied_)) {
+      const auto& errors = connection_->GetErrors();
+      if (!errors.empty()) {
+        errorDetails_ = errors;
+        const std::string errorMessage = errors[0]->message;
+        SetError(errorMessage);
+      } else {
+        SetError("Failed to bulk copy file");
+      }
+      return;
+    }
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in BcpFileWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  } catch (...) {
+    SQL_LOG_ERROR("Unknown exception in BcpFileWorker::Execute");
+    SetError("Unknown exception occurred");
+  }
+}
+
+void BcpFileWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG_STREAM("BcpFileWorker::OnOK rows " << rowsCopied_);
+
+  try {
+    Callback().Call({env.Null(), Napi::Number::New(env, static_cast<double>(rowsCopied_))});
+  } catch (const std::exception& e) {
+    Callback().Call({Napi::Error::New(env, e.what()).Value(), env.Null()});
+  }
+}
+}  // namespace mssql
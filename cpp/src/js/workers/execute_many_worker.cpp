@@ -0,0 +1,171 @@
+#include <js/workers/execute_many_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <core/bound_datum_set.h>
+#include <js/js_object_mapper.h>
+#include <odbc/odbc_connection.h>
+#include <platform.h>
+
+namespace mssql {
+
+ExecuteManyWorker::ExecuteManyWorker(Napi::Function& callback,
+                                     IOdbcConnection* connection,
+                                     const int queryId,
+                                     const Napi::Array& paramSets,
+                                     const std::shared_ptr<ExecuteManyOptions> options)
+    : OdbcAsyncWorker(callback, connection), queryId_(queryId), options_(options) {
+  const auto length = paramSets.Length();
+  SQL_LOG_DEBUG_STREAM("ExecuteManyWorker " << length << " sets " << options_->toString());
+  outcomes_.resize(length);
+  // a set that fails to bind is reported against its index, the rest still run
+  for (uint32_t i = 0; i < length; ++i) {
+    auto& outcome = outcomes_[i];
+    const Napi::Value set = paramSets[i];
+    if (!set.IsArray()) {
+      outcome.bind_error = "IMNOD: [msnodesql] parameter set " + std::to_string(i) +
+                           " is not an array";
+      continue;
+    }
+    outcome.parameters = std::make_shared<BoundDatumSet>();
+    if (!outcome.parameters->bind(set.As<Napi::Array>())) {
+      outcome.bind_error = "IMNOD: [msnodesql] Parameter " +
+                           std::to_string(outcome.parameters->first_error + 1) + ": " +
+                           outcome.parameters->err;
+      outcome.parameters.reset();
+    }
+  }
+}
+
+void ExecuteManyWorker::Execute() {
+  try {
+    size_t attempted = 0;
+    for (auto& outcome : outcomes_) {
+      ++attempted;
+      const auto ok = execute_set(outcome);
+      // the bound buffers are not needed once the set has run
+      outcome.parameters.reset();
+      if (!ok && options_->stop_on_error) {
+        break;
+      }
+    }
+    outcomes_.resize(attempted);
+    SQL_LOG_DEBUG_STREAM("ExecuteManyWorker ran " << attempted << " sets");
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in ExecuteManyWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  } catch (...) {
+    SQL_LOG_ERROR("Unknown exception in ExecuteManyWorker::Execute");
+    SetError("Unknown exception occurred");
+  }
+}
+
+bool ExecuteManyWorker::execute_set(SetOutcome& outcome) {
+  if (!outcome.bind_error.empty()) {
+    return false;
+  }
+  auto result = std::make_shared<QueryResult>();
+  if (!connection_->BindQuery(queryId_, outcome.parameters, result)) {
+    outcome.errors = connection_->GetErrors();
+    if (outcome.errors.empty()) {
+      outcome.bind_error = "Failed to execute prepared statement";
+    }
+    return false;
+  }
+  outcome.executed = true;
+  const auto statement = connection_->GetStatement(result->getHandle().getStatementId());
+  if (!statement) {
+    outcome.bind_error = "Statement not found";
+    return false;
+  }
+  return read_rows(statement, outcome);
+}
+
+// rows of the first result are kept, any later results are drained so the
+// cursor is closed before the next set executes.
+bool ExecuteManyWorker::read_rows(const std::shared_ptr<IOdbcStatement>& statement,
+                                  SetOutcome& outcome) {
+  const auto handle = statement->GetStatementHandle();
+  const auto resultset = statement->GetResultSet();
+  if (resultset) {
+    outcome.row_count = resultset->row_count();
+  }
+  if (resultset && resultset->get_column_count() > 0) {
+    std::shared_ptr<QueryResult> batch;
+    do {
+      batch = std::make_shared<QueryResult>(handle);
+      if (!statement->TryReadRows(batch, options_->batch_size)) {
+        outcome.errors = connection_->GetErrors();
+        return false;
+      }
+      // prepared columns view the bound buffers, copied out before the next fetch
+      auto& rows = *statement->GetResultSet();
+      rows.detach();
+      const auto columns = rows.get_column_count();
+      for (size_t r = 0; r < rows.get_result_count(); ++r) {
+        ResultSet::t_row row(columns);
+        for (size_t c = 0; c < columns; ++c) {
+          row[c] = rows.get_column(r, c);
+        }
+        outcome.rows.push_back(std::move(row));
+      }
+    } while (!batch->is_end_of_rows());
+  }
+
+  for (;;) {
+    const auto next = std::make_shared<QueryResult>(handle);
+    if (!statement->ReadNextResult(next)) {
+      outcome.errors = connection_->GetErrors();
+      return false;
+    }
+    if (next->is_end_of_results()) {
+      return true;
+    }
+  }
+}
+
+Napi::Object ExecuteManyWorker::to_value(Napi::Env env, const SetOutcome& outcome) const {
+  auto value = Napi::Object::New(env);
+  value.Set("executed", Napi::Boolean::New(env, outcome.executed));
+  value.Set("rowCount", Napi::Number::New(env, static_cast<double>(outcome.row_count)));
+
+  auto rows = Napi::Array::New(env, outcome.rows.size());
+  for (size_t r = 0; r < outcome.rows.size(); ++r) {
+    const auto& row = outcome.rows[r];
+    auto row_array = Napi::Array::New(env, row.size());
+    for (size_t c = 0; c < row.size(); ++c) {
+      const Napi::Value cell = row[c] ? Napi::Value(row[c]->ToValue(env)) : env.Null();
+      row_array.Set(static_cast<uint32_t>(c), cell);
+    }
+    rows.Set(static_cast<uint32_t>(r), row_array);
+  }
+  value.Set("rows", rows);
+
+  auto errors = Napi::Array::New(env);
+  uint32_t e = 0;
+  if (!outcome.bind_error.empty()) {
+    errors.Set(e++, Napi::Error::New(env, outcome.bind_error).Value());
+  }
+  for (const auto& error : outcome.errors) {
+    errors.Set(e++, JsObjectMapper::fromOdbcError(env, *error).Value());
+  }
+  value.Set("errors", errors);
+  return value;
+}
+
+void ExecuteManyWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG("ExecuteManyWorker::OnOK");
+
+  try {
+    auto results = Napi::Array::New(env, outcomes_.size());
+    for (size_t i = 0; i < outcomes_.size(); ++i) {
+      results.Set(static_cast<uint32_t>(i), to_value(env, outcomes_[i]));
+    }
+    Callback().Call({env.Null(), results});
+  } catch (const std::exception& e) {
+    Callback().Call({Napi::Error::New(env, e.what()).Value(), env.Null()});
+  }
+}
+}  // namespace mssql
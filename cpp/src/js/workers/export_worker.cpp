@@ -0,0 +1,164 @@
+#include <js/workers/export_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <core/bound_datum_set.h>
+#include <js/columns/result_set.h>
+#include <js/columns/result_set_writer.h>
+#include <odbc/odbc_connection.h>
+#include <platform.h>
+
+namespace mssql {
+
+ExportWorker::ExportWorker(Napi::Function& callback,
+                           IOdbcConnection* connection,
+                           const std::shared_ptr<QueryOperationParams> q,
+                           const Napi::Array& params,
+                           const std::shared_ptr<ExportOptions> options,
+                           Napi::Function progressCallback)
+    : OdbcAsyncWorker(callback, connection), queryParams_(q), options_(options) {
+  SQL_LOG_DEBUG_STREAM("ExportWorker constructor " << options_->toString());
+  // progress is best effort - a queue of one means a slow js thread drops
+  // intermediate counts rather than stalling the export.
+  if (!progressCallback.IsEmpty()) {
+    progress_ = Napi::ThreadSafeFunction::New(Env(), progressCallback, "ExportProgress", 1, 1);
+    has_progress_ = true;
+  }
+
+  parameters_ = std::make_shared<BoundDatumSet>(q);
+  if (!parameters_->bind(params)) {
+    SQL_LOG_ERROR_STREAM("Failed to bind parameters: " << parameters_->err);
+    std::string formatted_error = "IMNOD: [msnodesql] Parameter " +
+                                  std::to_string(parameters_->first_error + 1) + ": " +
+                                  parameters_->err;
+    SetError(formatted_error);
+    has_error_ = true;
+  }
+}
+
+ExportWorker::~ExportWorker() {
+  if (has_progress_) {
+    progress_.Release();
+  }
+}
+
+bool ExportWorker::set_connection_error(const char* fallback) {
+  const auto& errors = connection_->GetErrors();
+  if (!errors.empty()) {
+    errorDetails_ = errors;
+    SetError(errors[0]->message);
+  } else {
+    SetError(fallback);
+  }
+  has_error_ = true;
+  return false;
+}
+
+// skip row counts from leading statements e.g. set nocount off with an insert
+// ahead of the select, the export is taken from the first set with columns.
+bool ExportWorker::first_result_with_columns(const std::shared_ptr<IOdbcStatement>& statement) {
+  while (statement->GetResultSet()->get_column_count() == 0) {
+    const auto next = std::make_shared<QueryResult>(statement->GetStatementHandle());
+    if (!statement->ReadNextResult(next)) {
+      return set_connection_error("Failed to read next result");
+    }
+    if (next->is_end_of_results()) {
+      return true;
+    }
+  }
+  return true;
+}
+
+void ExportWorker::notify_progress(int64_t rows, int64_t bytes) {
+  if (!has_progress_) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (now < next_progress_) {
+    return;
+  }
+  next_progress_ = now + std::chrono::milliseconds(options_->progress_interval_ms);
+  auto callback = [rows, bytes](Napi::Env env, Napi::Function jsCallback) {
+    jsCallback.Call({Napi::Number::New(env, static_cast<double>(rows)),
+                     Napi::Number::New(env, static_cast<double>(bytes))});
+  };
+  progress_.NonBlockingCall(callback);
+}
+
+void ExportWorker::Execute() {
+  if (has_error_) {
+    return;
+  }
+
+  try {
+    const bool executed = connection_->ExecuteQuery(queryParams_, parameters_, result_);
+    const auto statementId = result_->getHandle().getStatementId();
+    if (!executed) {
+      set_connection_error("Failed to execute export query");
+      if (statementId >= 0) {
+        connection_->RemoveStatement(statementId);
+      }
+      return;
+    }
+
+    const auto statement = connection_->GetStatement(statementId);
+    if (!statement) {
+      SetError("Statement not found");
+      has_error_ = true;
+      return;
+    }
+
+    ResultSetWriter writer(*options_);
+    if (first_result_with_columns(statement)) {
+      const auto resultset = statement->GetResultSet();
+      writer.Start(resultset->get_metadata());
+      if (resultset->get_column_count() > 0) {
+        std::shared_ptr<QueryResult> batch;
+        do {
+          batch = std::make_shared<QueryResult>(statement->GetStatementHandle());
+          if (!statement->TryReadRows(batch, options_->batch_size)) {
+            set_connection_error("Failed to read rows");
+            break;
+          }
+          if (!writer.WriteRows(*statement->GetResultSet())) {
+            SetError(writer.LastError());
+            has_error_ = true;
+            break;
+          }
+          notify_progress(writer.RowsWritten(), writer.BytesWritten());
+        } while (!batch->is_end_of_rows());
+      }
+      if (!has_error_ && !writer.Flush()) {
+        SetError(writer.LastError());
+        has_error_ = true;
+      }
+    }
+
+    rows_ = writer.RowsWritten();
+    bytes_ = writer.BytesWritten();
+    SQL_LOG_DEBUG_STREAM("ExportWorker rows " << rows_ << " bytes " << bytes_);
+    connection_->RemoveStatement(statementId);
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in ExportWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  } catch (...) {
+    SQL_LOG_ERROR("Unknown exception in ExportWorker::Execute");
+    SetError("Unknown exception occurred");
+  }
+}
+
+void ExportWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG("ExportWorker::OnOK");
+
+  try {
+    auto summary = Napi::Object::New(env);
+    summary.Set("rows", Napi::Number::New(env, static_cast<double>(rows_)));
+    summary.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes_)));
+    Callback().Call({env.Null(), summary});
+  } catch (const std::exception& e) {
+    Callback().Call({Napi::Error::New(env, e.what()).Value(), env.Null()});
+  }
+}
+}  // namespace mssql
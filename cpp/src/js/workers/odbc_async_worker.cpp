@@ -1,9 +1,68 @@
 #include <js/workers/odbc_async_worker.h>
 
 #include <utils/Logger.h>
+#include <js/js_executor.h>
 #include <js/js_object_mapper.h>
 
 namespace mssql {
+void OdbcAsyncWorker::Queue() {
+  executor_ = JsExecutor::ForEnv(Env());
+  executor_->Queue(SerialKey(), [this]() { Run(); });
+}
+
+void OdbcAsyncWorker::SetError(const std::string& error) {
+  error_ = error;
+  Napi::AsyncWorker::SetError(error);
+}
+
+void OdbcAsyncWorker::Defer() {
+  deferred_ = true;
+}
+
+// deferred_ belongs to the js thread, the poller may finish before Complete
+// has returned from the OnOK which deferred it.
+void OdbcAsyncWorker::Resume() {
+  executor_->Post([this]() { Complete(); });
+}
+
+void OdbcAsyncWorker::Run() {
+  try {
+    Execute();
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR_STREAM("OdbcAsyncWorker::Run " << e.what());
+    SetError(e.what());
+  }
+  executor_->Post([this]() { Complete(); });
+}
+
+void OdbcAsyncWorker::Complete() {
+  deferred_ = false;
+  const Napi::Env env = Env();
+  {
+    Napi::HandleScope scope(env);
+#ifdef NAPI_CPP_EXCEPTIONS
+    try {
+#endif
+      if (error_.empty()) {
+        OnOK();
+      } else {
+        OnError(Napi::Error::New(env, error_));
+      }
+#ifdef NAPI_CPP_EXCEPTIONS
+    } catch (const Napi::Error& e) {
+      // thrown from the js callback, report it as uncaught
+      e.ThrowAsJavaScriptException();
+    }
+#endif
+  }
+  if (deferred_) {
+    return;
+  }
+  const auto executor = executor_;
+  Destroy();
+  executor->Done();
+}
+
 Napi::Object OdbcAsyncWorker::GetMetadata() {
   const Napi::Env env = Env();
 
@@ -0,0 +1,91 @@
+#include <js/workers/pipeline_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <platform.h>
+
+namespace mssql {
+
+PipelineWorker::PipelineWorker(Napi::Function& callback,
+                               IOdbcConnection* connection,
+                               const StatementHandle& statementHandle,
+                               const QueryOptions& options,
+                               std::vector<PipelineStep> steps)
+    : OdbcAsyncWorker(callback, connection),
+      statementHandle_(statementHandle),
+      options_(options),
+      steps_(std::move(steps)),
+      results_(connection, statementHandle) {
+  result_ = std::make_shared<QueryResult>(statementHandle_);
+}
+
+bool PipelineWorker::ParseStep(const std::string& name, PipelineStep& step) {
+  if (name == "fetchRows") {
+    step = PipelineStep::FetchRows;
+  } else if (name == "nextResultSet") {
+    step = PipelineStep::NextResultSet;
+  } else if (name == "release") {
+    step = PipelineStep::Release;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void PipelineWorker::Execute() {
+  try {
+    SQL_LOG_DEBUG_STREAM("Executing PipelineWorker for statement: "
+                         << statementHandle_.toString() << " steps " << steps_.size());
+    const auto statement = connection_->GetStatement(statementHandle_.getStatementId());
+    if (!statement) {
+      SetError("Statement not found");
+      return;
+    }
+
+    for (const auto step : steps_) {
+      bool more = true;
+      switch (step) {
+        case PipelineStep::FetchRows:
+          more = results_.FetchRows(statement, options_.batch_size);
+          if (results_.Failed()) {
+            errorDetails_ = results_.LastErrors();
+            SetError(errorDetails_[0]->message);
+          }
+          break;
+        case PipelineStep::NextResultSet:
+          // js moves straight on from a fetch at the end of the results
+          if (!results_.FetchedToEnd()) {
+            // info messages and errors are routed by js before going further
+            more = results_.NextResultSet() && !results_.HasMessages();
+          }
+          break;
+        case PipelineStep::Unbind:
+          // output parameters are only read ahead by the query worker
+          break;
+        case PipelineStep::Release:
+          results_.Release();
+          break;
+      }
+      if (!more) {
+        break;
+      }
+    }
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in PipelineWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  }
+}
+
+void PipelineWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG("PipelineWorker::OnOK");
+
+  try {
+    const auto results = results_.ToValue(env);
+    Callback().Call({env.Null(), results});
+  } catch (const std::exception& e) {
+    Callback().Call({Napi::Error::New(env, e.what()).Value(), env.Null()});
+  }
+}
+}  // namespace mssql
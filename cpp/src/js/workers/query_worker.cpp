@@ -4,6 +4,7 @@
 #include <js/js_object_mapper.h>
 #include <common/odbc_common.h>
 #include <core/bound_datum_set.h>
+#include <odbc/async_poller.h>
 #include <platform.h>
 #include <common/string_utils.h>
 
@@ -15,6 +16,8 @@ QueryWorker::QueryWorker(Napi::Function& callback,
                          const Napi::Array& params,
                          Napi::Function stateChangeCallback)
     : OdbcAsyncWorker(callback, connection), queryParams_(q) {
+  // hand a long polled query to the poller rather than sleep on a libuv thread
+  queryParams_->defer_polling = queryParams_->polling;
   // Create state notifier if callback is provided
   if (!stateChangeCallback.IsEmpty()) {
     stateNotifier_ = std::make_shared<JsStateNotifier>(Env(), stateChangeCallback);
@@ -63,6 +66,14 @@ void QueryWorker::Execute() {
         SetError(errorMessage);
         has_error_ = true;
       }
+    } else if (queryParams_->defer_polling) {
+      const auto statement = connection_->GetStatement(result_->getHandle().getStatementId());
+      if (statement && statement->IsExecutePending()) {
+        pending_ = statement;
+      }
+    }
+    if (!has_error_ && !pending_ && queryParams_->first_batch_size > 0) {
+      read_ahead();
     }
   } catch (const std::exception& e) {
     SQL_LOG_ERROR("Exception in QueryWorker::Execute: " + std::string(e.what()));
@@ -79,12 +90,20 @@ void QueryWorker::OnOK() {
     return;
   }
 
+  if (pending_) {
+    defer_completion();
+    return;
+  }
+
   const Napi::Env env = Env();
   Napi::HandleScope scope(env);
   SQL_LOG_DEBUG("QueryWorker::OnOK");
 
   try {
-    const auto metadata = GetMetadata();
+    auto metadata = GetMetadata();
+    if (readAhead_ && !readAhead_->Empty()) {
+      metadata.Set("steps", readAhead_->ToValue(env));
+    }
     Callback().Call({env.Null(), metadata, Napi::Boolean::New(env, !result_->is_end_of_results())});
   } catch (const std::exception& e) {
     // Call the callback with an error
@@ -92,4 +111,57 @@ void QueryWorker::OnOK() {
   }
 }
 
+void QueryWorker::read_ahead() {
+  const auto handle = result_->getHandle();
+  const auto statement = connection_->GetStatement(handle.getStatementId());
+  if (!statement) {
+    return;
+  }
+  readAhead_ = std::make_unique<StatementSteps>(connection_, handle);
+  // with no cap this is the first batch, and what follows if it ends the rows
+  const auto complete = readAhead_->ReadAhead(statement,
+                                              result_->size() > 0,
+                                              queryParams_->first_batch_size,
+                                              queryParams_->read_ahead_bytes);
+  if (complete) {
+    if (queryParams_->unbind_on_end) {
+      readAhead_->Unbind(queryParams_->id);
+    }
+    if (queryParams_->release_on_end) {
+      readAhead_->Release();
+    }
+  }
+  SQL_LOG_DEBUG_STREAM("QueryWorker::read_ahead " << handle.toString() << " complete "
+                                                  << complete);
+}
+
+void QueryWorker::defer_completion() {
+  SQL_LOG_DEBUG_STREAM("QueryWorker::defer_completion " << result_->getHandle().toString());
+  Defer();
+  const auto statement = pending_;
+  pending_.reset();
+  AsyncPoller::GetInstance().Submit([statement]() { return statement->PollExecute(); },
+                                    [this, statement](const SQLRETURN ret) {
+                                      complete(statement, ret);
+                                      Resume();
+                                    });
+}
+
+void QueryWorker::complete(const std::shared_ptr<IOdbcStatement>& statement, const SQLRETURN ret) {
+  try {
+    if (!statement->CompleteExecute(ret, result_)) {
+      const auto& errors = connection_->GetErrors();
+      if (!errors.empty()) {
+        errorDetails_ = errors;
+        SetError(errors[0]->message);
+        has_error_ = true;
+      }
+    }
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in QueryWorker::complete: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+    has_error_ = true;
+  }
+}
+
 }  // namespace mssql
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <js/workers/statement_steps.h>
+
+#include <utils/Logger.h>
+#include <core/bound_datum_set.h>
+#include <js/columns/result_set.h>
+#include <js/js_object_mapper.h>
+#include <odbc/odbc_statement.h>
+#include <platform.h>
+
+namespace mssql {
+
+StatementSteps::StatementSteps(IOdbcConnection* connection, const StatementHandle& statementHandle)
+    : connection_(connection), statementHandle_(statementHandle) {}
+
+bool StatementSteps::FetchRows(const std::shared_ptr<IOdbcStatement>& statement,
+                               const size_t batch_size) {
+  StepResult fetched;
+  fetched.step = PipelineStep::FetchRows;
+  const auto rows = std::make_shared<QueryResult>(statementHandle_);
+  if (!statement->TryReadRows(rows, batch_size)) {
+    const auto& errors = connection_->GetErrors();
+    if (!errors.empty()) {
+      fetched.errors = errors;
+      failed_ = true;
+      steps_.push_back(fetched);
+      return false;
+    }
+  }
+  const auto resultset = statement->GetResultSet();
+  if (!resultset) {
+    fetched.errors.push_back(std::make_shared<OdbcError>("IMNOD", "Result set is null", 0));
+    failed_ = true;
+    steps_.push_back(fetched);
+    return false;
+  }
+  // the statement clears its rows on the next read, and a prepared statement
+  // reuses the buffers its columns view
+  fetched.rows = std::make_shared<ResultSet>(*resultset);
+  fetched.rows->detach();
+  bytes_ += fetched.rows->byte_size();
+  steps_.push_back(fetched);
+  return fetched.rows->EndOfRows();
+}
+
+bool StatementSteps::NextResultSet() {
+  StepResult next;
+  next.step = PipelineStep::NextResultSet;
+  next.next = std::make_shared<QueryResult>(statementHandle_);
+  connection_->TryReadNextResult(statementHandle_.getStatementId(), next.next);
+  next.errors = connection_->GetErrors();
+  steps_.push_back(next);
+  return next.next->is_end_of_results() && next.next->is_end_of_rows();
+}
+
+void StatementSteps::NextResultSet(const std::shared_ptr<QueryResult>& next) {
+  StepResult read;
+  read.step = PipelineStep::NextResultSet;
+  read.next = next;
+  steps_.push_back(read);
+}
+
+void StatementSteps::Unbind(const int queryId) {
+  StepResult unbound;
+  unbound.step = PipelineStep::Unbind;
+  unbound.output = connection_->UnbindStatement(queryId);
+  if (unbound.output) {
+    steps_.push_back(unbound);
+  }
+}
+
+void StatementSteps::Release() {
+  StepResult released;
+  released.step = PipelineStep::Release;
+  released.released = connection_->RemoveStatement(statementHandle_.getStatementId());
+  steps_.push_back(released);
+}
+
+bool StatementSteps::ReadAhead(const std::shared_ptr<IOdbcStatement>& statement,
+                               bool has_columns,
+                               const size_t batch_size,
+                               const size_t max_bytes) {
+  for (;;) {
+    if (has_columns) {
+      // js fetches until the rows run out
+      bool end_of_rows = false;
+      while (!end_of_rows) {
+        if (bytes_ > max_bytes) {
+          // js streams the rest from here
+          return false;
+        }
+        end_of_rows = FetchRows(statement, batch_size);
+        if (failed_) {
+          return false;
+        }
+      }
+      if (FetchedToEnd()) {
+        return true;
+      }
+    }
+    if (NextResultSet()) {
+      return true;
+    }
+    // info is routed by js as it goes, an error ends the query
+    for (const auto& error : LastErrors()) {
+      if (!is_info(*error)) {
+        return false;
+      }
+    }
+    has_columns = steps_.back().next->size() > 0;
+  }
+}
+
+bool StatementSteps::FetchedToEnd() const {
+  return !steps_.empty() && steps_.back().step == PipelineStep::FetchRows &&
+         steps_.back().rows && steps_.back().rows->EndOfResults();
+}
+
+bool StatementSteps::HasMessages() const {
+  return !steps_.empty() && steps_.back().step == PipelineStep::NextResultSet &&
+         !steps_.back().errors.empty();
+}
+
+const std::vector<std::shared_ptr<OdbcError>>& StatementSteps::LastErrors() const {
+  static const std::vector<std::shared_ptr<OdbcError>> none;
+  return steps_.empty() ? none : steps_.back().errors;
+}
+
+bool StatementSteps::is_info(const OdbcError& error) {
+  // as Query.isInfo in lib/reader.js
+  return error.sqlstate.size() >= 2 && error.sqlstate.compare(0, 2, "01") == 0;
+}
+
+Napi::Array StatementSteps::ToValue(const Napi::Env& env) const {
+  auto results = Napi::Array::New(env, steps_.size());
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    const auto& r = steps_[i];
+    Napi::Object o;
+    auto errors = Napi::Array::New(env, r.errors.size());
+    for (size_t e = 0; e < r.errors.size(); ++e) {
+      errors.Set(static_cast<uint32_t>(e), JsObjectMapper::fromOdbcError(env, *r.errors[e]).Value());
+    }
+    switch (r.step) {
+      case PipelineStep::FetchRows:
+        if (r.rows) {
+          o = JsObjectMapper::fromQueryResult(env, r.rows);
+        } else {
+          o = Napi::Object::New(env);
+          o.Set("errors", errors);
+        }
+        o.Set("step", Napi::String::New(env, "fetchRows"));
+        break;
+      case PipelineStep::NextResultSet:
+        o = JsObjectMapper::fromNativeQueryResult(env, r.next);
+        o.Set("errors", errors);
+        o.Set("step", Napi::String::New(env, "nextResultSet"));
+        break;
+      case PipelineStep::Unbind: {
+        Napi::Env unbindEnv = env;
+        o = Napi::Object::New(env);
+        o.Set("output", r.output->unbind(unbindEnv));
+        o.Set("step", Napi::String::New(env, "unbind"));
+        break;
+      }
+      case PipelineStep::Release:
+        o = Napi::Object::New(env);
+        o.Set("released", Napi::Boolean::New(env, r.released));
+        o.Set("step", Napi::String::New(env, "release"));
+        break;
+    }
+    results.Set(static_cast<uint32_t>(i), o);
+  }
+  return results;
+}
+}  // namespace mssql
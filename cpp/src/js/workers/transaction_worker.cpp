@@ -0,0 +1,178 @@
+#include <js/workers/transaction_worker.h>
+
+#include <utils/Logger.h>
+#include <common/odbc_common.h>
+#include <core/bound_datum_set.h>
+#include <js/js_object_mapper.h>
+#include <odbc/odbc_connection.h>
+#include <odbc/odbc_statement.h>
+#include <platform.h>
+
+#include <cstdint>
+
+namespace mssql {
+
+TransactionWorker::TransactionWorker(Napi::Function& callback,
+                                     IOdbcConnection* connection,
+                                     const Napi::Array& statements,
+                                     const std::shared_ptr<TransactionOptions> options)
+    : OdbcAsyncWorker(callback, connection), options_(options) {
+  const auto length = statements.Length();
+  SQL_LOG_DEBUG_STREAM("TransactionWorker " << length << " statements " << options_->toString());
+  outcomes_.resize(length);
+  // statements are all bound before any is run, a bind error runs none of them
+  for (uint32_t i = 0; i < length; ++i) {
+    auto& outcome = outcomes_[i];
+    const Napi::Value statement = statements[i];
+    if (!statement.IsObject() || !statement.As<Napi::Object>().Get("query").IsObject()) {
+      outcome.bind_error = "IMNOD: [msnodesql] statement " + std::to_string(i) +
+                           " has no query";
+      continue;
+    }
+    const auto o = statement.As<Napi::Object>();
+    outcome.query = JsObjectMapper::toQueryOperationParams(o.Get("query").As<Napi::Object>());
+    // results are read here, the statement never waits on js
+    outcome.query->polling = false;
+    outcome.query->defer_polling = false;
+    outcome.parameters = std::make_shared<BoundDatumSet>(outcome.query);
+    const Napi::Value params = o.Get("params");
+    const auto values = params.IsArray() ? params.As<Napi::Array>() : Napi::Array::New(Env(), 0);
+    if (!outcome.parameters->bind(values)) {
+      outcome.bind_error = "IMNOD: [msnodesql] Parameter " +
+                           std::to_string(outcome.parameters->first_error + 1) + ": " +
+                           outcome.parameters->err;
+      outcome.parameters.reset();
+    }
+  }
+}
+
+void TransactionWorker::Execute() {
+  try {
+    for (size_t i = 0; i < outcomes_.size(); ++i) {
+      if (!outcomes_[i].bind_error.empty()) {
+        failed_ = static_cast<int>(i);
+        return;
+      }
+    }
+    if (!connection_->BeginTransaction()) {
+      errorDetails_ = connection_->GetErrors();
+      SetError(errorDetails_.empty() ? "Failed to begin transaction" : errorDetails_[0]->message);
+      return;
+    }
+    for (size_t i = 0; i < outcomes_.size(); ++i) {
+      const auto ok = execute_statement(outcomes_[i]);
+      // the bound buffers are not needed once the statement has run
+      outcomes_[i].parameters.reset();
+      if (!ok) {
+        failed_ = static_cast<int>(i);
+        break;
+      }
+    }
+    if (failed_ < 0) {
+      committed_ = connection_->CommitTransaction();
+      if (!committed_) {
+        endErrors_ = connection_->GetErrors();
+      }
+    }
+    if (!committed_) {
+      rolled_back_ = connection_->RollbackTransaction();
+      if (!rolled_back_) {
+        const auto& errors = connection_->GetErrors();
+        endErrors_.insert(endErrors_.end(), errors.begin(), errors.end());
+      }
+    }
+    SQL_LOG_DEBUG_STREAM("TransactionWorker committed " << committed_ << " failed " << failed_);
+  } catch (const std::exception& e) {
+    SQL_LOG_ERROR("Exception in TransactionWorker::Execute: " + std::string(e.what()));
+    SetError("Exception occurred: " + std::string(e.what()));
+  } catch (...) {
+    SQL_LOG_ERROR("Unknown exception in TransactionWorker::Execute");
+    SetError("Unknown exception occurred");
+  }
+}
+
+bool TransactionWorker::execute_statement(StatementOutcome& outcome) {
+  outcome.metadata = std::make_shared<QueryResult>();
+  // false is also returned for an execute with info messages
+  if (!connection_->ExecuteQuery(outcome.query, outcome.parameters, outcome.metadata)) {
+    outcome.errors = connection_->GetErrors();
+    if (outcome.errors.empty() || has_error(outcome.errors)) {
+      connection_->RemoveStatement(outcome.metadata->getHandle().getStatementId());
+      if (outcome.errors.empty()) {
+        outcome.bind_error = "Failed to execute statement";
+      }
+      return false;
+    }
+  }
+  outcome.executed = true;
+  const auto handle = outcome.metadata->getHandle();
+  const auto statement = connection_->GetStatement(handle.getStatementId());
+  if (!statement) {
+    outcome.bind_error = "Statement not found";
+    return false;
+  }
+  outcome.steps = std::make_unique<StatementSteps>(connection_, handle);
+  const auto complete = outcome.steps->ReadAhead(
+      statement, outcome.metadata->size() > 0, options_->batch_size, SIZE_MAX);
+  outcome.steps->Release();
+  return complete;
+}
+
+bool TransactionWorker::has_error(const std::vector<std::shared_ptr<OdbcError>>& errors) {
+  for (const auto& error : errors) {
+    if (!StatementSteps::is_info(*error)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Napi::Object TransactionWorker::to_value(Napi::Env env, const StatementOutcome& outcome) const {
+  auto value = Napi::Object::New(env);
+  value.Set("executed", Napi::Boolean::New(env, outcome.executed));
+  if (outcome.executed) {
+    value.Set("meta", JsObjectMapper::fromNativeQueryResult(env, outcome.metadata));
+  }
+  if (outcome.steps) {
+    value.Set("steps", outcome.steps->ToValue(env));
+  }
+
+  auto errors = Napi::Array::New(env);
+  uint32_t e = 0;
+  if (!outcome.bind_error.empty()) {
+    errors.Set(e++, Napi::Error::New(env, outcome.bind_error).Value());
+  }
+  for (const auto& error : outcome.errors) {
+    errors.Set(e++, JsObjectMapper::fromOdbcError(env, *error).Value());
+  }
+  value.Set("errors", errors);
+  return value;
+}
+
+void TransactionWorker::OnOK() {
+  const Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+  SQL_LOG_DEBUG("TransactionWorker::OnOK");
+
+  try {
+    auto result = Napi::Object::New(env);
+    result.Set("committed", Napi::Boolean::New(env, committed_));
+    result.Set("rolledBack", Napi::Boolean::New(env, rolled_back_));
+    result.Set("failed", Napi::Number::New(env, failed_));
+    auto endErrors = Napi::Array::New(env, endErrors_.size());
+    for (size_t e = 0; e < endErrors_.size(); ++e) {
+      endErrors.Set(static_cast<uint32_t>(e),
+                    JsObjectMapper::fromOdbcError(env, *endErrors_[e]).Value());
+    }
+    result.Set("errors", endErrors);
+    auto statements = Napi::Array::New(env, outcomes_.size());
+    for (size_t i = 0; i < outcomes_.size(); ++i) {
+      statements.Set(static_cast<uint32_t>(i), to_value(env, outcomes_[i]));
+    }
+    result.Set("statements", statements);
+    Callback().Call({env.Null(), result});
+  } catch (const std::exception& e) {
+    Callback().Call({Napi::Error::New(env, e.what()).Value(), env.Null()});
+  }
+}
+}  // namespace mssql
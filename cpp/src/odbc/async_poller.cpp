@@ -0,0 +1,93 @@
+#include <platform.h>
+#include <odbc/async_poller.h>
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include <utils/Logger.h>
+
+namespace mssql {
+
+constexpr std::chrono::microseconds AsyncPoller::min_interval;
+constexpr std::chrono::microseconds AsyncPoller::max_interval;
+
+AsyncPoller& AsyncPoller::GetInstance() {
+  static AsyncPoller instance;
+  return instance;
+}
+
+AsyncPoller::~AsyncPoller() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void AsyncPoller::Submit(Poll poll, Done done) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the thread is only started once a query is first polled
+    if (!thread_.joinable()) {
+      thread_ = std::thread(&AsyncPoller::run, this);
+    }
+    queue_.push(Entry{Clock::now() + min_interval, min_interval, std::move(poll), std::move(done)});
+  }
+  wake_.notify_one();
+}
+
+size_t AsyncPoller::Pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size() + active_;
+}
+
+void AsyncPoller::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    if (queue_.empty()) {
+      wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      continue;
+    }
+    // a submit may bring an earlier due time, so look again after any wake
+    const auto due = queue_.top().due;
+    if (Clock::now() < due) {
+      wake_.wait_until(lock, due);
+      continue;
+    }
+
+    auto entry = queue_.top();
+    queue_.pop();
+    ++active_;
+    lock.unlock();
+
+    SQLRETURN ret = SQL_ERROR;
+    try {
+      ret = entry.poll();
+    } catch (const std::exception& e) {
+      SQL_LOG_ERROR_STREAM("AsyncPoller poll failed: " << e.what());
+    }
+
+    if (ret == SQL_STILL_EXECUTING) {
+      entry.interval = std::min(entry.interval * 2, max_interval);
+      entry.due = Clock::now() + entry.interval;
+      lock.lock();
+      --active_;
+      queue_.push(std::move(entry));
+      continue;
+    }
+
+    try {
+      entry.done(ret);
+    } catch (const std::exception& e) {
+      SQL_LOG_ERROR_STREAM("AsyncPoller completion failed: " << e.what());
+    }
+    lock.lock();
+    --active_;
+  }
+}
+
+}  // namespace mssql
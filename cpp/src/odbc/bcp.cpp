@@ -59,6 +59,22 @@ bool plugin_bcp::load(const SYN_SIG& shared_lib,
     if (!dll_bcp_done)
       errors->push_back(make_shared<OdbcError>(
           "bcp", "bcp failed to get symbol dll_bcp_done.", -1, 0, "", "", 0));
+    dll_bcp_control = reinterpret_cast<plug_bcp_control>(DYN_SYM(hinstLib, "bcp_control"));
+    if (!dll_bcp_control)
+      errors->push_back(make_shared<OdbcError>(
+          "bcp", "bcp failed to get symbol dll_bcp_control.", -1, 0, "", "", 0));
+    dll_bcp_columns = reinterpret_cast<plug_bcp_columns>(DYN_SYM(hinstLib, "bcp_columns"));
+    if (!dll_bcp_columns)
+      errors->push_back(make_shared<OdbcError>(
+          "bcp", "bcp failed to get symbol dll_bcp_columns.", -1, 0, "", "", 0));
+    dll_bcp_colfmt = reinterpret_cast<plug_bcp_colfmt>(DYN_SYM(hinstLib, "bcp_colfmt"));
+    if (!dll_bcp_colfmt)
+      errors->push_back(make_shared<OdbcError>(
+          "bcp", "bcp failed to get symbol dll_bcp_colfmt.", -1, 0, "", "", 0));
+    dll_bcp_exec = reinterpret_cast<plug_bcp_exec>(DYN_SYM(hinstLib, "bcp_exec"));
+    if (!dll_bcp_exec)
+      errors->push_back(make_shared<OdbcError>(
+          "bcp", "bcp failed to get symbol dll_bcp_exec.", -1, 0, "", "", 0));
     return errors->empty();
   }
   return false;
@@ -95,6 +111,30 @@ inline DBINT plugin_bcp::bcp_done(HDBC const p1) const {
   return (dll_bcp_done != nullptr) ? (dll_bcp_done)(p1) : static_cast<RETCODE>(-1);
 }
 
+inline RETCODE plugin_bcp::bcp_control(HDBC const p1, const INT p2, void* p3) const {
+  return (dll_bcp_control != nullptr) ? (dll_bcp_control)(p1, p2, p3) : static_cast<RETCODE>(-1);
+}
+
+inline RETCODE plugin_bcp::bcp_columns(HDBC const p1, const INT p2) const {
+  return (dll_bcp_columns != nullptr) ? (dll_bcp_columns)(p1, p2) : static_cast<RETCODE>(-1);
+}
+
+inline RETCODE plugin_bcp::bcp_colfmt(HDBC const p1,
+                                      const INT p2,
+                                      const BYTE p3,
+                                      const INT p4,
+                                      const DBINT p5,
+                                      const LPCBYTE p6,
+                                      const INT p7,
+                                      const INT p8) const {
+  return (dll_bcp_colfmt != nullptr) ? (dll_bcp_colfmt)(p1, p2, p3, p4, p5, p6, p7, p8)
+                                     : static_cast<RETCODE>(-1);
+}
+
+inline RETCODE plugin_bcp::bcp_exec(HDBC const p1, LPDBINT p2) const {
+  return (dll_bcp_exec != nullptr) ? (dll_bcp_exec)(p1, p2) : static_cast<RETCODE>(-1);
+}
+
 template <class T>
 struct storage_jagged_t final : basestorage {
   SQLLEN i_indicator;
@@ -175,6 +215,13 @@ bcp::bcp(std::shared_ptr<IOdbcApi> odbcApiPtr,
   _errors = make_shared<vector<shared_ptr<OdbcError>>>();
 }
 
+bcp::bcp(std::shared_ptr<IOdbcApi> odbcApiPtr,
+         const shared_ptr<BcpFileOptions> file_options,
+         shared_ptr<IOdbcConnectionHandle> h)
+    : _ch(std::move(h)), _file_options(file_options), _odbcApi(odbcApiPtr) {
+  _errors = make_shared<vector<shared_ptr<OdbcError>>>();
+}
+
 wstring bcp::table_name() const {
   auto& set = *_param_set;
   if (set.size() == 0)
@@ -186,6 +233,14 @@ wstring bcp::table_name() const {
   return table;
 }
 
+wstring bcp::table_hints() const {
+  auto& set = *_param_set;
+  if (set.size() == 0)
+    return L"";
+  const auto& first = set.atIndex(0);
+  return first->get_storage()->bcp_hints;
+}
+
 bool bcp::init() {
   const auto tn = table_name();
   if (tn.empty())
@@ -239,6 +294,24 @@ inline shared_ptr<basestorage> get_storage(const shared_ptr<BoundDatum> p) {
   return r;
 }
 
+// optional server hints e.g. TABLOCK, applied after init and before any row is bound.
+bool bcp::hints() {
+  const auto h = table_hints();
+  if (h.empty())
+    return true;
+  const auto& ch = *_ch;
+  auto vec = StringUtils::wstr2wcvec(h);
+  vec.push_back(static_cast<uint16_t>(0));
+  const auto retcode = plugin.bcp_control(ch.get_handle(), BCPHINTSW, vec.data());
+  if ((retcode != SUCCEED)) {
+    SQL_LOG_ERROR_STREAM("bcp failed in step `hints` with error code " << retcode);
+    ch.read_errors(_odbcApi, _errors);
+    return false;
+  }
+  SQL_LOG_DEBUG_WSTREAM("bcp hints applied " << h);
+  return true;
+}
+
 bool bcp::bind() {
   const auto& ch = *_ch;
   auto& ps = *_param_set;
@@ -316,22 +389,32 @@ int bcp::clean(const string& step) {
   return -1;
 }
 
-int bcp::insert(int version) {
+bool bcp::load(int version) {
 #ifdef WINDOWS_BUILD
   auto vs = std::to_wstring(version);
   if (!dynload(L"msodbcsql" + vs + L".dll")) {
-    return -1;
+    return false;
   }
 #endif
 #ifdef LINUX_BUILD
   auto vs = std::to_string(version);
   if (!dynload("libmsodbcsql-" + vs + ".so") && !dynload("libmsodbcsql." + vs + ".dylib")) {
-    return -1;
+    return false;
   }
 #endif
+  return true;
+}
+
+int bcp::insert(int version) {
+  if (!load(version)) {
+    return -1;
+  }
   if (!init()) {
     return clean("init");
   }
+  if (!hints()) {
+    return clean("hints");
+  }
   if (!bind()) {
     return clean("bind");
   }
@@ -340,4 +423,145 @@ int bcp::insert(int version) {
   }
   return done();
 }
+
+inline vector<SQLWCHAR> u16_to_wcvec(const std::u16string& s) {
+  vector<SQLWCHAR> vec(s.begin(), s.end());
+  vec.push_back(static_cast<SQLWCHAR>(0));
+  return vec;
+}
+
+// terminators are matched as raw bytes in the file encoding
+inline vector<BYTE> terminator_bytes(const string& term, const bool unicode) {
+  if (!unicode) {
+    return vector<BYTE>(term.begin(), term.end());
+  }
+  const auto wide = StringUtils::Utf8ToU16String(term);
+  const auto* p = reinterpret_cast<const BYTE*>(wide.data());
+  return vector<BYTE>(p, p + wide.size() * sizeof(char16_t));
+}
+
+bool bcp::init_file() {
+  const auto& opt = *_file_options;
+  if (opt.table_name.empty() || opt.file_name.empty())
+    return false;
+  const auto& ch = *_ch;
+  auto table = u16_to_wcvec(opt.table_name);
+  auto file = u16_to_wcvec(opt.file_name);
+  auto error_file = u16_to_wcvec(opt.error_file);
+  const auto retcode = plugin.bcp_init(ch.get_handle(),
+                                       table.data(),
+                                       file.data(),
+                                       opt.error_file.empty() ? nullptr : error_file.data(),
+                                       DB_IN);
+  if ((retcode != SUCCEED)) {
+    SQL_LOG_ERROR_STREAM("bcp failed in step `init_file` with error code " << retcode);
+    ch.read_errors(_odbcApi, _errors);
+    return false;
+  }
+  SQL_LOG_DEBUG_STREAM("bcp init_file succeeded " << opt.toString());
+  return true;
+}
+
+// every field is read as delimited character data; the last field of a row ends
+// with the row terminator. the server converts each field to the column type.
+// bcp splits on the terminators alone and has no notion of rfc 4180 quoting, a
+// quoted field keeps its quotes and any terminator inside it ends the field.
+// the js layer rejects a file whose first rows hold a quoted field.
+bool bcp::format_file() {
+  const auto& opt = *_file_options;
+  const auto& ch = *_ch;
+  const auto n = static_cast<INT>(opt.columns.size());
+  if (n == 0)
+    return false;
+  if (plugin.bcp_columns(ch.get_handle(), n) != SUCCEED) {
+    ch.read_errors(_odbcApi, _errors);
+    return false;
+  }
+  const auto field = terminator_bytes(opt.field_terminator, opt.unicode);
+  const auto row = terminator_bytes(opt.row_terminator, opt.unicode);
+  const BYTE host_type = opt.unicode ? SQLNCHAR : SQLCHARACTER;
+  for (INT i = 0; i < n; ++i) {
+    const auto& term = i == n - 1 ? row : field;
+    if (plugin.bcp_colfmt(ch.get_handle(),
+                          i + 1,
+                          host_type,
+                          0,
+                          SQL_VARLEN_DATA,
+                          term.data(),
+                          static_cast<INT>(term.size()),
+                          opt.columns[i]) != SUCCEED) {
+      ch.read_errors(_odbcApi, _errors);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool bcp::control_file() {
+  const auto& opt = *_file_options;
+  const auto& ch = *_ch;
+  const auto control = [&](const INT option, void* value) {
+    if (plugin.bcp_control(ch.get_handle(), option, value) != SUCCEED) {
+      ch.read_errors(_odbcApi, _errors);
+      return false;
+    }
+    return true;
+  };
+  if (opt.first_row > 0 &&
+      !control(BCPFIRST, reinterpret_cast<void*>(static_cast<intptr_t>(opt.first_row))))
+    return false;
+  if (opt.last_row > 0 &&
+      !control(BCPLAST, reinterpret_cast<void*>(static_cast<intptr_t>(opt.last_row))))
+    return false;
+  if (opt.batch_size > 0 &&
+      !control(BCPBATCH, reinterpret_cast<void*>(static_cast<intptr_t>(opt.batch_size))))
+    return false;
+  if (opt.max_errors > 0 &&
+      !control(BCPMAXERRS, reinterpret_cast<void*>(static_cast<intptr_t>(opt.max_errors))))
+    return false;
+  if (opt.keep_nulls && !control(BCPKEEPNULLS, reinterpret_cast<void*>(static_cast<intptr_t>(1))))
+    return false;
+  // the js layer defaults code_page to 65001 so utf-8 files load as such, 0 leaves
+  // bcp on its own default of the client OEM code page
+  if (!opt.unicode && opt.code_page != 0 &&
+      !control(BCPFILECP, reinterpret_cast<void*>(static_cast<intptr_t>(opt.code_page))))
+    return false;
+  if (!opt.hints.empty()) {
+    auto hints = u16_to_wcvec(opt.hints);
+    if (!control(BCPHINTSW, hints.data()))
+      return false;
+  }
+  return true;
+}
+
+int64_t bcp::insert_file() {
+  _errors->clear();
+  if (!load(_file_options->bcp_version)) {
+    return -1;
+  }
+  const auto fail = [&](const string& step) {
+    if (_errors->empty()) {
+      const string msg = "bcp failed in step `" + step + "`, yet no error was returned.";
+      _errors->push_back(make_shared<OdbcError>("bcp", msg.c_str(), -1, 0, "", "", 0));
+    }
+    return static_cast<int64_t>(-1);
+  };
+  if (!init_file()) {
+    return fail("init_file");
+  }
+  if (!format_file()) {
+    return fail("format_file");
+  }
+  if (!control_file()) {
+    return fail("control_file");
+  }
+  DBINT rows = 0;
+  const auto& ch = *_ch;
+  if (plugin.bcp_exec(ch.get_handle(), &rows) != SUCCEED) {
+    ch.read_errors(_odbcApi, _errors);
+    return fail("exec");
+  }
+  SQL_LOG_DEBUG_STREAM("bcp insert_file copied " << rows << " rows");
+  return rows;
+}
 }  // namespace mssql
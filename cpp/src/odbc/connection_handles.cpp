@@ -16,8 +16,11 @@
 #include <utils/Logger.h>
 
 namespace mssql {
-ConnectionHandles::ConnectionHandles(std::shared_ptr<IOdbcEnvironmentHandle> env)
-    : rawEnvHandle_(env), connectionHandle_(nullptr) {
+ConnectionHandles::ConnectionHandles(std::shared_ptr<IOdbcEnvironmentHandle> env,
+                                     std::shared_ptr<IOdbcApi> odbcApi)
+    : rawEnvHandle_(env),
+      connectionHandle_(nullptr),
+      odbcApi_(odbcApi ? odbcApi : std::make_shared<RealOdbcApi>()) {
   if (!env) {
     SQL_LOG_ERROR("ConnectionHandles constructor received null environment handle");
     return;
@@ -38,6 +41,10 @@ ConnectionHandles::ConnectionHandles(std::shared_ptr<IOdbcEnvironmentHandle> env
 
 ConnectionHandles::~ConnectionHandles() {
   SQL_LOG_DEBUG_STREAM("ConnectionHandles::~ConnectionHandles - free connection handle");
+  {
+    std::lock_guard<std::mutex> lock(_handlesMutex);
+    free_idle_unlocked();
+  }
   if (connectionHandle_) {
     connectionHandle_->free();
   }
@@ -45,7 +52,9 @@ ConnectionHandles::~ConnectionHandles() {
 }
 
 void ConnectionHandles::clear() {
-  std::lock_guard<std::mutex> lock(_handlesMutex);
+  std::unique_lock<std::mutex> lock(_handlesMutex);
+  // a handle being reset by checkin is back on the free list, or freed, before we go on
+  _resetDone.wait(lock, [this] { return _resetting == 0; });
 
   SQL_LOG_DEBUG_STREAM("ConnectionHandles::clear - ENTER - thread="
                        << std::this_thread::get_id() << " size=" << _statementHandles.size());
@@ -94,6 +103,7 @@ void ConnectionHandles::clear() {
   }
 
   _statementHandles.clear();
+  free_idle_unlocked();
   SQL_LOG_DEBUG_STREAM("ConnectionHandles::clear - EXIT - thread=" << std::this_thread::get_id());
 }
 
@@ -177,6 +187,20 @@ shared_ptr<IOdbcStatementHandle> ConnectionHandles::checkout(long statement_id)
     return nullptr;
   }
 
+  // Prefer a handle reset on checkin over a fresh allocation
+  if (!_idleStatements.empty()) {
+    const auto raw = _idleStatements.back();
+    _idleStatements.pop_back();
+    if (safeHandle->adopt(raw)) {
+      _poolStats.reused++;
+      _statementHandles[statement_id] = safeHandle;
+      SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkout - reused pooled handle for statementId="
+                           << statement_id << " idle=" << _idleStatements.size());
+      return safeHandle->get();
+    }
+    free_raw(raw);
+  }
+
   if (!safeHandle->alloc(connRef->get_handle())) {
     SQL_LOG_ERROR_STREAM("ConnectionHandles::checkout - failed to allocate statement handle for statementId="
                          << statement_id << " thread=" << std::this_thread::get_id());
@@ -185,6 +209,7 @@ shared_ptr<IOdbcStatementHandle> ConnectionHandles::checkout(long statement_id)
 
   // Store the SafeHandle wrapper
   _statementHandles[statement_id] = safeHandle;
+  _poolStats.allocated++;
 
   SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkout - created new handle for statementId="
                        << statement_id << " thread=" << std::this_thread::get_id()
@@ -195,31 +220,111 @@ shared_ptr<IOdbcStatementHandle> ConnectionHandles::checkout(long statement_id)
 }
 
 void ConnectionHandles::checkin(long statementId) {
+  SQLHANDLE raw = SQL_NULL_HANDLE;
+  {
+    std::lock_guard<std::mutex> lock(_handlesMutex);
+
+    SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - ENTER statementId=" << statementId
+                         << " thread=" << std::this_thread::get_id()
+                         << " current_handles=" << _statementHandles.size());
+
+    const auto itr = _statementHandles.find(statementId);
+    if (itr == _statementHandles.end()) {
+      // This can happen legitimately if clear() already freed this statement
+      // during connection close - not necessarily an error
+      SQL_LOG_WARNING_STREAM("ConnectionHandles::checkin - statementId=" << statementId
+                             << " not found (may have been freed by clear()) thread="
+                             << std::this_thread::get_id());
+      return;
+    }
+
+    // Detaching leaves the statement's own reference null, so a late call
+    // through it cannot reach the handle once another statement has it.
+    raw = _statementPoolSize > 0 ? itr->second->detach() : SQL_NULL_HANDLE;
+    if (raw == SQL_NULL_HANDLE) {
+      SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - freeing statementId=" << statementId
+                           << " thread=" << std::this_thread::get_id());
+      itr->second->free();
+    } else {
+      _resetting++;
+    }
+    _statementHandles.erase(itr);
+  }
+  if (raw == SQL_NULL_HANDLE) {
+    return;
+  }
+
+  // the driver calls resetting the handle do not hold up other statements
+  const auto reset = reset_statement(raw);
+
   std::lock_guard<std::mutex> lock(_handlesMutex);
+  if (reset && _idleStatements.size() < _statementPoolSize) {
+    _idleStatements.push_back(raw);
+    _poolStats.recycled++;
+  } else {
+    SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - discarding statementId="
+                         << statementId << " idle=" << _idleStatements.size());
+    free_raw(raw);
+    _poolStats.discarded++;
+  }
+  _resetting--;
+  _resetDone.notify_all();
 
-  SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - ENTER statementId=" << statementId
+  SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - EXIT statementId=" << statementId
                        << " thread=" << std::this_thread::get_id()
-                       << " current_handles=" << _statementHandles.size());
+                       << " remaining_handles=" << _statementHandles.size()
+                       << " idle=" << _idleStatements.size());
+}
+
+// put a released statement back in the state SQLAllocHandle leaves it: no
+// cursor, bindings or parameters, and the attributes statements change reset
+bool ConnectionHandles::reset_statement(SQLHANDLE raw) const {
+  if (!SQL_SUCCEEDED(odbcApi_->SQLFreeStmt(raw, SQL_CLOSE)) ||
+      !SQL_SUCCEEDED(odbcApi_->SQLFreeStmt(raw, SQL_UNBIND)) ||
+      !SQL_SUCCEEDED(odbcApi_->SQLFreeStmt(raw, SQL_RESET_PARAMS))) {
+    return false;
+  }
+  const auto set = [this, raw](const SQLINTEGER attribute, const SQLULEN value) {
+    return SQL_SUCCEEDED(odbcApi_->SQLSetStmtAttrW(
+        raw, attribute, reinterpret_cast<SQLPOINTER>(value), SQL_IS_UINTEGER));
+  };
+  return set(SQL_ATTR_ASYNC_ENABLE, SQL_ASYNC_ENABLE_OFF) && set(SQL_ATTR_QUERY_TIMEOUT, 0) &&
+         set(SQL_ATTR_PARAMSET_SIZE, 1) && set(SQL_ATTR_ROW_ARRAY_SIZE, 1) &&
+         set(SQL_ATTR_ROWS_FETCHED_PTR, 0);
+}
 
-  const auto itr = _statementHandles.find(statementId);
-  if (itr == _statementHandles.end()) {
-    // This can happen legitimately if clear() already freed this statement
-    // during connection close - not necessarily an error
-    SQL_LOG_WARNING_STREAM("ConnectionHandles::checkin - statementId=" << statementId
-                           << " not found (may have been freed by clear()) thread="
-                           << std::this_thread::get_id());
+// free a pooled handle through the statement handle type, which owns the SQLFreeHandle
+void ConnectionHandles::free_raw(SQLHANDLE raw) {
+  const auto handle = create_statement_handle();
+  if (handle && handle->adopt(raw)) {
+    handle->free();
     return;
   }
+  SQLFreeHandle(SQL_HANDLE_STMT, raw);
+}
 
-  // Free the handle through SafeHandle
-  SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - freeing statementId=" << statementId
-                       << " thread=" << std::this_thread::get_id());
-  itr->second->free();
-  _statementHandles.erase(statementId);
+void ConnectionHandles::free_idle_unlocked() {
+  // NOTE: caller must hold _handlesMutex, and the connection must still be allocated
+  for (const auto raw : _idleStatements) {
+    free_raw(raw);
+  }
+  _idleStatements.clear();
+}
 
-  SQL_LOG_DEBUG_STREAM("ConnectionHandles::checkin - EXIT statementId=" << statementId
-                       << " thread=" << std::this_thread::get_id()
-                       << " remaining_handles=" << _statementHandles.size());
+void ConnectionHandles::setStatementPoolSize(const size_t size) {
+  std::lock_guard<std::mutex> lock(_handlesMutex);
+  _statementPoolSize = size;
+  while (_idleStatements.size() > size) {
+    free_raw(_idleStatements.back());
+    _idleStatements.pop_back();
+  }
+}
+
+ConnectionHandles::StatementPoolStats ConnectionHandles::statementPoolStats() const {
+  std::lock_guard<std::mutex> lock(_handlesMutex);
+  auto stats = _poolStats;
+  stats.idle = _idleStatements.size();
+  return stats;
 }
 
 // Return the interface pointer
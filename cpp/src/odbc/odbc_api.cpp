@@ -1154,6 +1154,35 @@ SQLRETURN RealOdbcApi::SQLCancelHandle(SQLSMALLINT HandleType, SQLHANDLE Handle)
   return ret;
 }
 
+SQLRETURN RealOdbcApi::SQLParamData(SQLHSTMT StatementHandle, SQLPOINTER* Value) {
+  SQL_LOG_TRACE_STREAM("SQLParamData called - Handle: " << StatementHandle);
+
+  SQLRETURN ret = ::SQLParamData(StatementHandle, Value);
+  SQL_LOG_TRACE_STREAM("SQLParamData returned: " << GetSqlReturnCodeString(ret));
+
+  // SQL_NEED_DATA asks for the next parameter, SQL_NO_DATA is a statement with no result
+  if (!SQL_SUCCEEDED(ret) && ret != SQL_NEED_DATA && ret != SQL_NO_DATA) {
+    LogOdbcError(SQL_HANDLE_STMT, StatementHandle, "SQLParamData failed");
+  }
+
+  return ret;
+}
+
+SQLRETURN RealOdbcApi::SQLPutData(SQLHSTMT StatementHandle,
+                                  SQLPOINTER Data,
+                                  SQLLEN StrLen_or_Ind) {
+  SQL_LOG_TRACE_STREAM("SQLPutData called - Handle: " << StatementHandle
+                                                      << ", Length: " << StrLen_or_Ind);
+
+  SQLRETURN ret = ::SQLPutData(StatementHandle, Data, StrLen_or_Ind);
+
+  if (!SQL_SUCCEEDED(ret)) {
+    LogOdbcError(SQL_HANDLE_STMT, StatementHandle, "SQLPutData failed");
+  }
+
+  return ret;
+}
+
 SQLRETURN RealOdbcApi::SQLGetDiagField(SQLSMALLINT HandleType,
                                        SQLHANDLE Handle,
                                        SQLSMALLINT RecNumber,
@@ -1255,6 +1284,20 @@ SQLRETURN RealOdbcApi::SQLCloseCursor(SQLHSTMT StatementHandle) {
   return ret;
 }
 
+SQLRETURN RealOdbcApi::SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
+  SQL_LOG_TRACE_STREAM("SQLFreeStmt called - Handle: " << StatementHandle
+                                                       << ", Option: " << Option);
+
+  SQLRETURN ret = ::SQLFreeStmt(StatementHandle, Option);
+  SQL_LOG_TRACE_STREAM("SQLFreeStmt returned: " << GetSqlReturnCodeString(ret));
+
+  if (!SQL_SUCCEEDED(ret)) {
+    LogOdbcError(SQL_HANDLE_STMT, StatementHandle, "SQLFreeStmt failed");
+  }
+
+  return ret;
+}
+
 SQLRETURN RealOdbcApi::SQLGetDescField(SQLHDESC DescriptorHandle,
                                        SQLSMALLINT RecNumber,
                                        SQLSMALLINT FieldIdentifier,
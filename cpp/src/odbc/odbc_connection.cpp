@@ -9,11 +9,13 @@
 #include <iostream>
 
 #include <common/string_utils.h>
+#include <odbc/bcp.h>
 #include <odbc/connection_handles.h>
 #include <odbc/iodbc_api.h>
 #include <odbc/odbc_environment.h>
 #include <odbc/odbc_error_handler.h>
 #include <odbc/odbc_handles.h>
+#include <odbc/odbc_statement_cache.h>
 #include <odbc/odbc_statement_factory.h>
 #include <odbc/odbc_statement_legacy.h>
 #include <odbc/odbc_transaction_manager.h>
@@ -43,13 +45,15 @@ OdbcConnection::OdbcConnection(std::shared_ptr<IOdbcEnvironment> environment,
   }
 
   // Create connection handles first
-  _connectionHandles = std::make_shared<ConnectionHandles>(environment_->GetEnvironmentHandle());
+  _connectionHandles =
+      std::make_shared<ConnectionHandles>(environment_->GetEnvironmentHandle(), _odbcApi);
 
   // Create error handler with the connection handles
   _errorHandler = std::make_shared<OdbcErrorHandler>(_connectionHandles, environment_, _odbcApi);
 
   // Create statement factory
   _statementFactory = std::make_shared<OdbcStatementFactory>(_connectionId, _connectionHandles);
+  _statementCache = std::make_shared<OdbcStatementCache>();
 }
 
 OdbcConnection::~OdbcConnection() {
@@ -117,6 +121,11 @@ bool OdbcConnection::Close() {
   std::lock_guard lock(_connectionMutex);
 
   if (connectionState != ConnectionClosed) {
+    {
+      // the handles are freed with the rest below
+      std::vector<std::shared_ptr<OdbcStatementLegacy>> cached;
+      _statementCache->Clear(cached);
+    }
     if (_connectionHandles) {
       // CRITICAL: Free all statement handles BEFORE disconnecting the connection
       // to prevent use-after-free errors
@@ -220,14 +229,20 @@ std::shared_ptr<IOdbcStatement> OdbcConnection::CreateStatement(
       _connectionHandles->connectionHandle(), _odbcApi, type, _errorHandler, operationParams);
 
   // have to create map bewteen query id and statement handle
-  _queryIdToStatementHandle[operationParams->id] = statement->GetStatementHandle();
+  map_query(operationParams->id, statement->GetStatementHandle());
   SQL_LOG_DEBUG_STREAM("OdbcConnection::CreateStatement: "
                        << statement->GetStatementHandle().toString() << " query id "
-                       << operationParams->id << " size " << _queryIdToStatementHandle.size());
+                       << operationParams->id);
 
   return statement;
 }
 
+// cancel and unbind look the query up from other threads under the same lock
+void OdbcConnection::map_query(const int queryId, const StatementHandle& handle) {
+  std::lock_guard lock(_statementMutex);
+  _queryIdToStatementHandle[queryId] = handle;
+}
+
 bool OdbcConnection::RemoveStatement(const std::shared_ptr<OdbcStatement>& statement) {
   std::lock_guard lock(_statementMutex);
 
@@ -248,6 +263,11 @@ bool OdbcConnection::RemoveStatement(const std::shared_ptr<OdbcStatement>& state
 }
 
 bool OdbcConnection::RemoveStatement(int statementId) {
+  // stepping through what is left of the results goes to the server, so it
+  // is done before the lock is taken rather than holding up other queries
+  const auto returning = _statementCache->Returning(statementId);
+  const auto cursorClosed = returning && returning->close_cursor();
+
   std::lock_guard lock(_statementMutex);
 
   // Take a local copy of the shared_ptr so the factory stays alive even if
@@ -258,6 +278,17 @@ bool OdbcConnection::RemoveStatement(int statementId) {
     return false;
   }
 
+  // a cached prepared statement goes back to the cache for the next execute
+  std::vector<std::shared_ptr<OdbcStatementLegacy>> evicted;
+  const auto kept = _statementCache->Release(statementId, cursorClosed, evicted);
+  for (const auto& victim : evicted) {
+    factory->RemoveStatement(victim->GetStatementHandle().getStatementId());
+  }
+  if (kept) {
+    SQL_LOG_DEBUG_STREAM("RemoveStatement ID = " << statementId << " kept prepared");
+    return true;
+  }
+
   // First get the statement from the factory
   auto statement = factory->GetStatement(statementId);
   if (statement) {
@@ -341,9 +372,15 @@ bool OdbcConnection::ExecuteQuery(const std::shared_ptr<QueryOperationParams> op
                                   const std::shared_ptr<BoundDatumSet> parameters,
                                   std::shared_ptr<QueryResult>& result,
                                   std::shared_ptr<IOdbcStateNotifier> stateNotifier) {
-  // Create a transient statement
   SQL_LOG_FUNC_TRACER();
-  auto statement = CreateStatement(StatementType::Legacy, operationParams);
+  const auto key =
+      apply_param_policy(std::hash<std::u16string>{}(operationParams->query_string), parameters);
+
+  // Reuse a prepared statement for hot sql, else create a transient statement
+  auto statement = auto_prepared_statement(operationParams, parameters, key);
+  if (!statement) {
+    statement = CreateStatement(StatementType::Legacy, operationParams);
+  }
   if (!statement) {
     return false;
   }
@@ -356,35 +393,201 @@ bool OdbcConnection::ExecuteQuery(const std::shared_ptr<QueryOperationParams> op
   // Execute it
   result->setHandle(statement->GetStatementHandle());
   const bool executeResult = statement->Execute(parameters, result);
+  if (!executeResult) {
+    invalidate_on_schema_change(statement);
+  }
 
   return executeResult;
 }
 
+// a plan compiled against a table or procedure since dropped or altered keeps
+// failing, so the cached statement is freed when its query is released.
+void OdbcConnection::invalidate_on_schema_change(const std::shared_ptr<IOdbcStatement>& statement) {
+  for (const auto& error : GetErrors()) {
+    if (OdbcStatementCache::InvalidatesPlan(error->code)) {
+      _statementCache->Invalidate(statement->GetStatementHandle().getStatementId());
+      return;
+    }
+  }
+}
+
+// array, tvp and bcp bindings change the statement attributes and are always
+// sent direct, as are polled queries whose prepare could return still executing.
+static bool auto_preparable(const std::shared_ptr<QueryOperationParams>& operationParams,
+                            const std::shared_ptr<BoundDatumSet>& parameters) {
+  if (operationParams->polling) {
+    return false;
+  }
+  if (!parameters) {
+    return true;
+  }
+  for (const auto& binding : *parameters) {
+    if (binding->is_bcp || binding->is_tvp || binding->get_ind_vec().size() > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<IOdbcStatement> OdbcConnection::auto_prepared_statement(
+    const std::shared_ptr<QueryOperationParams>& operationParams,
+    const std::shared_ptr<BoundDatumSet>& parameters,
+    const size_t key) {
+  if (connectionState != ConnectionOpen || !_statementCache->AutoPrepareEnabled() ||
+      !auto_preparable(operationParams, parameters)) {
+    return nullptr;
+  }
+
+  const auto& text = operationParams->query_string;
+  auto cached = _statementCache->Checkout(key, text, CachedStatementKind::AutoPrepared);
+  if (cached) {
+    SQL_LOG_DEBUG_STREAM("OdbcConnection::auto_prepared_statement reuse "
+                         << cached->GetStatementHandle().toString() << " query id "
+                         << operationParams->id);
+    cached->reuse(operationParams);
+    map_query(operationParams->id, cached->GetStatementHandle());
+    return cached;
+  }
+
+  if (!_statementCache->Seen(key)) {
+    return nullptr;
+  }
+
+  const auto statement = std::dynamic_pointer_cast<OdbcStatementLegacy>(
+      CreateStatement(StatementType::Legacy, operationParams));
+  if (!statement) {
+    return nullptr;
+  }
+  statement->set_auto_prepare(true);
+  std::vector<std::shared_ptr<OdbcStatementLegacy>> evicted;
+  _statementCache->Insert(key, text, CachedStatementKind::AutoPrepared, statement, evicted);
+  free_statements(evicted);
+  return statement;
+}
+
+void OdbcConnection::free_statements(
+    const std::vector<std::shared_ptr<OdbcStatementLegacy>>& statements) {
+  if (statements.empty()) {
+    return;
+  }
+  std::lock_guard lock(_statementMutex);
+  auto factory = _statementFactory;
+  if (!factory) {
+    return;
+  }
+  for (const auto& statement : statements) {
+    factory->RemoveStatement(statement->GetStatementHandle().getStatementId());
+  }
+}
+
+void OdbcConnection::SetStatementCache(const uint32_t autoPrepareThreshold,
+                                       const size_t capacity,
+                                       const size_t maxBytes) {
+  std::vector<std::shared_ptr<OdbcStatementLegacy>> evicted;
+  _statementCache->Configure(autoPrepareThreshold, capacity, maxBytes, evicted);
+  free_statements(evicted);
+}
+
+StatementCacheStats OdbcConnection::GetStatementCacheStats() const {
+  return _statementCache->Stats();
+}
+
+void OdbcConnection::SetStatementPoolSize(const size_t size) {
+  if (_connectionHandles) {
+    _connectionHandles->setStatementPoolSize(size);
+  }
+}
+
+ConnectionHandles::StatementPoolStats OdbcConnection::GetStatementPoolStats() const {
+  return _connectionHandles ? _connectionHandles->statementPoolStats()
+                            : ConnectionHandles::StatementPoolStats{};
+}
+
 bool OdbcConnection::BindQuery(int queryId,
                                const std::shared_ptr<BoundDatumSet> parameters,
                                std::shared_ptr<QueryResult>& result) {
-  auto it = _queryIdToStatementHandle.find(queryId);
-  if (it == _queryIdToStatementHandle.end()) {
-    SQL_LOG_ERROR_STREAM("OdbcConnection::BindQuery ID = " << queryId << " - statement not found");
-    return false;
+  int statementId;
+  {
+    std::lock_guard lock(_statementMutex);
+    const auto it = _queryIdToStatementHandle.find(queryId);
+    if (it == _queryIdToStatementHandle.end()) {
+      SQL_LOG_ERROR_STREAM("OdbcConnection::BindQuery ID = " << queryId
+                                                             << " - statement not found");
+      return false;
+    }
+    statementId = it->second.getStatementId();
   }
-
-  const auto statementId = it->second.getStatementId();
   auto statement = _statementFactory->GetStatement(statementId);
   SQL_LOG_DEBUG_STREAM("OdbcConnection::BindQuery ID = " << statementId);
   if (statement) {
+    apply_param_policy(std::hash<int>{}(queryId), parameters);
     result->setHandle(statement->GetStatementHandle());
-    return statement->BindExecute(parameters, result);
+    const auto executed = statement->BindExecute(parameters, result);
+    if (!executed) {
+      invalidate_on_schema_change(statement);
+    }
+    return executed;
   }
   SQL_LOG_ERROR_STREAM("OdbcConnection::BindQuery ID = " << statementId
                                                          << " - statement not found");
   return false;
 }
 
+void OdbcConnection::SetParamSizeBuckets(const std::vector<SQLULEN>& buckets) {
+  std::lock_guard lock(_signatureMutex);
+  _paramSizeBuckets = buckets;
+  std::sort(_paramSizeBuckets.begin(), _paramSizeBuckets.end());
+  _paramSizeBuckets.erase(std::unique(_paramSizeBuckets.begin(), _paramSizeBuckets.end()),
+                          _paramSizeBuckets.end());
+}
+
+size_t OdbcConnection::GetParamSignatureCount() const {
+  std::lock_guard lock(_signatureMutex);
+  return _paramSignatures.size();
+}
+
+// a new sql_type or column size on the same text is a new plan for the server
+// so the buckets are applied before the signature is recorded.
+size_t OdbcConnection::apply_param_policy(const size_t key,
+                                          const std::shared_ptr<BoundDatumSet>& parameters) {
+  if (!parameters) {
+    return key;
+  }
+  std::lock_guard lock(_signatureMutex);
+  parameters->apply_size_buckets(_paramSizeBuckets);
+  const auto signature = key ^ (parameters->signature_hash() << 1);
+  if (_paramSignatures.size() < kMaxTrackedSignatures) {
+    _paramSignatures.insert(signature);
+  }
+  return signature;
+}
+
 bool OdbcConnection::PrepareQuery(const std::shared_ptr<QueryOperationParams> operationParams,
                                   const std::shared_ptr<BoundDatumSet> parameters,
                                   std::shared_ptr<QueryResult>& result,
                                   std::shared_ptr<IOdbcStateNotifier> stateNotifier) {
+  // the bound result columns depend on the max column size so it is part of the key
+  const auto& text = operationParams->query_string;
+  const auto key = std::hash<std::u16string>{}(text) ^
+                   (std::hash<size_t>{}(operationParams->max_prepared_column_size) << 1);
+  const auto cacheable = !operationParams->polling && _statementCache->Enabled();
+  if (connectionState == ConnectionOpen && cacheable) {
+    const auto cached = _statementCache->Checkout(key, text, CachedStatementKind::Prepared);
+    if (cached) {
+      SQL_LOG_DEBUG_STREAM("OdbcConnection::PrepareQuery reuse "
+                           << cached->GetStatementHandle().toString() << " query id "
+                           << operationParams->id);
+      cached->reuse(operationParams);
+      map_query(operationParams->id, cached->GetStatementHandle());
+      if (stateNotifier) {
+        cached->SetStateNotifier(stateNotifier);
+      }
+      result->setHandle(cached->GetStatementHandle());
+      cached->assign_result(result, cached->GetResultSet());
+      return true;
+    }
+  }
+
   // Create a transient statement
   auto statement = CreateStatement(StatementType::Legacy, operationParams);
   if (!statement) {
@@ -400,7 +603,17 @@ bool OdbcConnection::PrepareQuery(const std::shared_ptr<QueryOperationParams> op
   result->setHandle(statement->GetStatementHandle());
   SQL_LOG_DEBUG_STREAM(
       "OdbcConnection::PrepareQuery ID = " << statement->GetStatementHandle().toString());
-  return statement->Prepare(parameters, result);
+  const auto prepared = statement->Prepare(parameters, result);
+  if (prepared && cacheable) {
+    std::vector<std::shared_ptr<OdbcStatementLegacy>> evicted;
+    _statementCache->Insert(key,
+                            text,
+                            CachedStatementKind::Prepared,
+                            std::dynamic_pointer_cast<OdbcStatementLegacy>(statement),
+                            evicted);
+    free_statements(evicted);
+  }
+  return prepared;
 }
 
 bool OdbcConnection::TryReadNextResult(int statementId, std::shared_ptr<QueryResult>& result) {
@@ -425,6 +638,27 @@ bool OdbcConnection::TryReadNextResult(int statementId, std::shared_ptr<QueryRes
   return statement->ReadNextResult(result);
 }
 
+bool OdbcConnection::BcpFile(const std::shared_ptr<BcpFileOptions> options,
+                             int64_t& rowsCopied) {
+  SQL_LOG_DEBUG_STREAM("OdbcConnection::BcpFile " << options->toString());
+  std::lock_guard lock(_connectionMutex);
+  rowsCopied = 0;
+  if (connectionState != ConnectionOpen) {
+    return false;
+  }
+  _errorHandler->ClearErrors();
+  bcp b(_odbcApi, options, _connectionHandles->connectionHandle());
+  const auto rows = b.insert_file();
+  if (rows < 0) {
+    for (const auto& error : *b._errors) {
+      _errorHandler->AddError(error);
+    }
+    return false;
+  }
+  rowsCopied = rows;
+  return true;
+}
+
 const std::vector<std::shared_ptr<OdbcError>>& OdbcConnection::GetErrors() const {
   return _errorHandler->GetErrors();
 }
@@ -0,0 +1,230 @@
+#include <platform.h>
+#include <odbc/odbc_statement_cache.h>
+
+#include <common/odbc_common.h>
+#include <odbc/odbc_statement_legacy.h>
+#include <utils/Logger.h>
+
+#include <algorithm>
+
+namespace mssql {
+
+// counts for keys never reaching the threshold are forgotten wholesale once
+// the map grows past this, so one off sql cannot grow it without bound.
+static constexpr size_t max_seen_keys = 4096;
+
+void OdbcStatementCache::Configure(const uint32_t threshold,
+                                   const size_t capacity,
+                                   const size_t maxBytes,
+                                   statements& evicted) {
+  std::lock_guard lock(_mutex);
+  _threshold = threshold;
+  _capacity = capacity;
+  _maxBytes = maxBytes;
+  _seen.clear();
+  trim(evicted);
+}
+
+bool OdbcStatementCache::Enabled() const {
+  std::lock_guard lock(_mutex);
+  return _capacity > 0;
+}
+
+bool OdbcStatementCache::AutoPrepareEnabled() const {
+  std::lock_guard lock(_mutex);
+  return _threshold > 0 && _capacity > 0;
+}
+
+bool OdbcStatementCache::Seen(const size_t key) {
+  std::lock_guard lock(_mutex);
+  if (_threshold == 0 || _capacity == 0) {
+    return false;
+  }
+  if (_seen.size() >= max_seen_keys) {
+    _seen.clear();
+  }
+  const auto count = ++_seen[key];
+  if (count < _threshold) {
+    return false;
+  }
+  _seen.erase(key);
+  return true;
+}
+
+std::shared_ptr<OdbcStatementLegacy> OdbcStatementCache::Checkout(
+    const size_t key, const std::u16string& text, const CachedStatementKind kind) {
+  std::lock_guard lock(_mutex);
+  const auto it = _byKey.find(key);
+  if (it == _byKey.end()) {
+    ++_stats.misses;
+    return nullptr;
+  }
+  auto& entry = *it->second;
+  if (entry.in_use || entry.discard || entry.kind != kind || entry.text != text) {
+    ++_stats.misses;
+    return nullptr;
+  }
+  ++_stats.hits;
+  entry.in_use = true;
+  _entries.splice(_entries.begin(), _entries, it->second);
+  return entry.statement;
+}
+
+void OdbcStatementCache::Insert(const size_t key,
+                                const std::u16string& text,
+                                const CachedStatementKind kind,
+                                std::shared_ptr<OdbcStatementLegacy> statement,
+                                statements& evicted) {
+  std::lock_guard lock(_mutex);
+  if (_capacity == 0 || !statement) {
+    return;
+  }
+  const auto existing = _byKey.find(key);
+  if (existing != _byKey.end()) {
+    // a busy entry for the same key - the newer statement is not kept
+    return;
+  }
+  const auto statementId = statement->GetStatementHandle().getStatementId();
+  const auto bytes = statement->memory_footprint();
+  _entries.push_front(Entry{key, text, kind, std::move(statement), bytes, true, false});
+  _byKey[key] = _entries.begin();
+  _byStatement[statementId] = _entries.begin();
+  _stats.bytes += bytes;
+  trim(evicted);
+}
+
+void OdbcStatementCache::Invalidate(const long statementId) {
+  std::lock_guard lock(_mutex);
+  const auto it = _byStatement.find(statementId);
+  if (it != _byStatement.end() && !it->second->discard) {
+    SQL_LOG_DEBUG_STREAM("OdbcStatementCache::Invalidate statement " << statementId);
+    it->second->discard = true;
+    ++_stats.invalidations;
+  }
+}
+
+// the entry stays in use until Release so no other query can check it out
+// while the cursor is closed.
+std::shared_ptr<OdbcStatementLegacy> OdbcStatementCache::Returning(const long statementId) const {
+  std::lock_guard lock(_mutex);
+  const auto it = _byStatement.find(statementId);
+  if (it == _byStatement.end() || !it->second->in_use || it->second->discard) {
+    return nullptr;
+  }
+  return it->second->statement;
+}
+
+bool OdbcStatementCache::Release(const long statementId,
+                                 const bool cursorClosed,
+                                 statements& evicted) {
+  std::lock_guard lock(_mutex);
+  const auto it = _byStatement.find(statementId);
+  if (it == _byStatement.end()) {
+    return false;
+  }
+  const auto entry = it->second;
+  if (entry->discard || !cursorClosed) {
+    SQL_LOG_DEBUG_STREAM("OdbcStatementCache::Release discard statement " << statementId);
+    erase(entry);
+    return false;
+  }
+  entry->in_use = false;
+
+  // parameter buffers bound by the execute are now part of its footprint
+  const auto bytes = entry->statement->memory_footprint();
+  _stats.bytes = _stats.bytes - entry->bytes + bytes;
+  entry->bytes = bytes;
+  const auto statement = entry->statement;
+  trim(evicted);
+  if (_byStatement.find(statementId) != _byStatement.end()) {
+    return true;
+  }
+  // too big to keep on its own - the caller frees it as for any statement
+  evicted.erase(std::remove(evicted.begin(), evicted.end(), statement), evicted.end());
+  return false;
+}
+
+void OdbcStatementCache::Clear(statements& evicted) {
+  std::lock_guard lock(_mutex);
+  for (auto& entry : _entries) {
+    evicted.push_back(entry.statement);
+  }
+  _entries.clear();
+  _byKey.clear();
+  _byStatement.clear();
+  _seen.clear();
+  _stats.bytes = 0;
+}
+
+StatementCacheStats OdbcStatementCache::Stats() const {
+  std::lock_guard lock(_mutex);
+  auto stats = _stats;
+  stats.size = _entries.size();
+  return stats;
+}
+
+bool OdbcStatementCache::InvalidatesPlan(const int nativeError) {
+  switch (nativeError) {
+    case 207:    // invalid column name
+    case 208:    // invalid object name
+    case 213:    // supplied values do not match table definition
+    case 2812:   // could not find stored procedure
+    case 4121:   // cannot find column or user defined function
+    case 8144:   // procedure or function has too many arguments specified
+    case 8145:   // is not a parameter for procedure
+    case 16943:  // cursor operation failed as the table schema changed
+      return true;
+    default:
+      return false;
+  }
+}
+
+// idle statements go first from the least recently used end, busy ones are
+// only marked to drop on release when evicting every idle one is not enough.
+void OdbcStatementCache::trim(statements& evicted) {
+  // statements already marked leave on release and no longer count
+  size_t count = 0;
+  size_t bytes = 0;
+  for (const auto& entry : _entries) {
+    if (!entry.discard) {
+      ++count;
+      bytes += entry.bytes;
+    }
+  }
+  const auto over = [&]() {
+    return count > _capacity || (_maxBytes > 0 && bytes > _maxBytes);
+  };
+  auto it = _entries.end();
+  while (over() && it != _entries.begin()) {
+    --it;
+    if (it->in_use) {
+      continue;
+    }
+    SQL_LOG_DEBUG_STREAM("OdbcStatementCache::trim evict statement "
+                         << it->statement->GetStatementHandle().getStatementId());
+    if (!it->discard) {
+      --count;
+      bytes -= it->bytes;
+    }
+    evicted.push_back(it->statement);
+    ++_stats.evictions;
+    const auto victim = it;
+    ++it;
+    erase(victim);
+  }
+  for (auto busy = _entries.rbegin(); over() && busy != _entries.rend(); ++busy) {
+    if (!busy->discard) {
+      busy->discard = true;
+      --count;
+      bytes -= busy->bytes;
+    }
+  }
+}
+
+void OdbcStatementCache::erase(const entry_list::iterator it) {
+  _stats.bytes -= it->bytes;
+  _byKey.erase(it->key);
+  _byStatement.erase(it->statement->GetStatementHandle().getStatementId());
+  _entries.erase(it);
+}
+}  // namespace mssql
@@ -4,6 +4,7 @@
 #include <common/odbc_common.h>
 #include <common/string_utils.h>
 #include <core/bound_datum_set.h>
+#include <core/param_stream.h>
 #include <odbc/iodbc_api.h>
 #include <odbc/odbc_driver_types.h>
 #include <odbc/odbc_error_handler.h>
@@ -69,6 +70,36 @@ bool OdbcStatementLegacy::Execute(const std::shared_ptr<BoundDatumSet> parameter
   SQL_LOG_FUNC_TRACER();
   lock_guard<recursive_mutex> lock(g_i_mutex);
   auto res = try_execute_direct(_operationParams, parameters);
+  if (_executePending.load()) {
+    // still running, the result is assigned by CompleteExecute
+    return res;
+  }
+  assign_result(result, _resultset);
+  return res;
+}
+
+SQLRETURN OdbcStatementLegacy::PollExecute() {
+  lock_guard<recursive_mutex> lock(g_i_mutex);
+  if (!_executePending.load() || !_statement) {
+    return SQL_ERROR;
+  }
+  const auto ret = _odbcApi->SQLExecDirect(_statement->get_handle(),
+                                           reinterpret_cast<SQLWCHAR*>(_pendingQuery.data()),
+                                           _pendingQuery.size());
+  if (ret == SQL_STILL_EXECUTING && _cancelRequested.load()) {
+    cancel_handle();
+  }
+  return ret;
+}
+
+bool OdbcStatementLegacy::CompleteExecute(const SQLRETURN ret,
+                                          std::shared_ptr<QueryResult>& result) {
+  SQL_LOG_FUNC_TRACER();
+  lock_guard<recursive_mutex> lock(g_i_mutex);
+  const auto param_set = std::move(_pendingParams);
+  _pendingQuery.clear();
+  _executePending.store(false);
+  const auto res = param_set ? finish_execute_direct(ret, param_set) : false;
   assign_result(result, _resultset);
   return res;
 }
@@ -83,6 +114,9 @@ bool OdbcStatementLegacy::BindExecute(const std::shared_ptr<BoundDatumSet> param
   lock_guard<recursive_mutex> lock(g_i_mutex);
   SQL_LOG_DEBUG_STREAM("OdbcStatementLegacy::BindExecute [" << _handle.toString()
                                                             << "] Enter BindExecute");
+  // errors are reported per execute, not carried over from the last one
+  _errors->clear();
+  _errorHandler->ClearErrors();
   auto res = bind_fetch(parameters);
   assign_result(result, _resultset);
   SQL_LOG_DEBUG_STREAM("OdbcStatementLegacy::BindExecute [" << _handle.toString()
@@ -187,6 +221,8 @@ OdbcStatementLegacy::OdbcStatementLegacy(
     StatementHandle handle,
     const std::shared_ptr<QueryOperationParams> operationParams)
     : _prepared(false),
+      _autoPrepare(false),
+      _autoPrepared(false),
       _cancelRequested(false),
       _pollingEnabled(false),
       _numericStringEnabled(false),
@@ -344,6 +380,8 @@ bool OdbcStatementLegacy::Cancel() {
 
   if (!_pollingEnabled && (state == OdbcStatementState::STATEMENT_SUBMITTED ||
                            state == OdbcStatementState::STATEMENT_READING)) {
+    // a streamed parameter waiting on js checks for this
+    _cancelRequested.store(true);
     cancel_handle();
     set_state(OdbcStatementState::STATEMENT_CANCEL_HANDLE);
     SQL_LOG_DEBUG_STREAM("OdbcStatementLegacy::Cancel ["
@@ -625,6 +663,21 @@ bool OdbcStatementLegacy::bind_params(const shared_ptr<BoundDatumSet>& params) {
   return true;
 }
 
+// a prepared statement executed again with the same parameter layout keeps
+// its bindings, only the values are copied into the buffers bound last time.
+bool OdbcStatementLegacy::bind_prepared_params(const shared_ptr<BoundDatumSet>& params) {
+  if (_preparedParams && _preparedParams->take_values(*params)) {
+    SQL_LOG_DEBUG_STREAM("[" << _handle.toString() << "] bind_prepared_params re-use bindings");
+    return true;
+  }
+  _preparedParams.reset();
+  if (!bind_params(params)) {
+    return false;
+  }
+  _preparedParams = params;
+  return true;
+}
+
 Napi::Array OdbcStatementLegacy::unbind_params(Napi::Env env) const {
   if (_boundParamsSet != nullptr) {
     return _boundParamsSet->unbind(env);
@@ -880,6 +933,7 @@ bool OdbcStatementLegacy::try_prepare(const shared_ptr<QueryOperationParams>& q)
   }
 
   _resultset->_end_of_rows = true;
+  _preparedResultset = _resultset;
   _prepared = true;
 
   set_state(OdbcStatementState::STATEMENT_PREPARED);
@@ -967,17 +1021,18 @@ bool OdbcStatementLegacy::bind_fetch(const shared_ptr<BoundDatumSet>& param_set)
   if (!_statement)
     return false;
   const auto& statement = *_statement;
-  const bool polling_mode = get_polling();
-  const auto bound = bind_params(param_set);
+  // a streamed parameter is sent from this thread while execute waits for it
+  const bool polling_mode = get_polling() && !param_set->has_data_at_exec();
+  const auto bound = bind_prepared_params(param_set);
   if (!bound) {
     // error already set in BindParams
     return false;
   }
-  if (polling_mode) {
-    const auto s = _odbcApi->SQLSetStmtAttr(statement.get_handle(),
-                                            SQL_ATTR_ASYNC_ENABLE,
-                                            reinterpret_cast<SQLPOINTER>(SQL_ASYNC_ENABLE_ON),
-                                            0);
+  if (polling_mode || param_set->has_data_at_exec()) {
+    // a handle polled on an earlier execute stays async unless turned off
+    const auto async = polling_mode ? SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF;
+    const auto s = _odbcApi->SQLSetStmtAttr(
+        statement.get_handle(), SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<SQLPOINTER>(async), 0);
     if (!check_odbc_error(s)) {
       SQL_LOG_DEBUG_STREAM("[" << _handle.toString() << "] bind_fetch failed to set stmt attr");
       return false;
@@ -990,6 +1045,9 @@ bool OdbcStatementLegacy::bind_fetch(const shared_ptr<BoundDatumSet>& param_set)
     const auto vec = make_shared<vector<uint16_t>>();
     ret = poll_check(ret, vec, false);
   }
+  if (ret == SQL_NEED_DATA) {
+    ret = send_data_at_exec(*param_set);
+  }
   const auto state = get_state();
   if (state == OdbcStatementState::STATEMENT_CANCELLED) {
     return raise_cancel();
@@ -1064,14 +1122,14 @@ bool OdbcStatementLegacy::try_execute_direct(const shared_ptr<QueryOperationPara
       return try_bcp(param_set, first->bcp_version);
     }
   }
-  const bool polling_mode = get_polling();
+  const bool polling_mode = get_polling() && !pars.has_data_at_exec();
   {
     lock_guard<recursive_mutex> lock(g_i_mutex);
     set_state(OdbcStatementState::STATEMENT_BINDING);
     // Initialize _resultset before bind_params to ensure it's always available
     _resultset = make_unique<ResultSet>(0);
 
-    const auto bound = bind_params(param_set);
+    const auto bound = _autoPrepare ? bind_prepared_params(param_set) : bind_params(param_set);
     if (!bound) {
       // error already set in BindParams
       _resultset->_end_of_rows = true;
@@ -1090,11 +1148,11 @@ bool OdbcStatementLegacy::try_execute_direct(const shared_ptr<QueryOperationPara
       return false;
     }
 
-    if (polling_mode) {
-      auto ret = _odbcApi->SQLSetStmtAttr(_statement->get_handle(),
-                                          SQL_ATTR_ASYNC_ENABLE,
-                                          reinterpret_cast<SQLPOINTER>(SQL_ASYNC_ENABLE_ON),
-                                          0);
+    if (polling_mode || pars.has_data_at_exec()) {
+      // a handle polled on an earlier execute stays async unless turned off
+      const auto async = polling_mode ? SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF;
+      auto ret = _odbcApi->SQLSetStmtAttr(
+          _statement->get_handle(), SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<SQLPOINTER>(async), 0);
       if (!check_odbc_error(ret)) {
         SQL_LOG_DEBUG_STREAM("[" << _handle.toString()
                                  << "] try_execute_direct failed to set stmt attr");
@@ -1105,8 +1163,10 @@ bool OdbcStatementLegacy::try_execute_direct(const shared_ptr<QueryOperationPara
   auto query = q->query_string;
 
   set_state(OdbcStatementState::STATEMENT_SUBMITTED);
-  SQLRETURN ret = _odbcApi->SQLExecDirect(
-      _statement->get_handle(), reinterpret_cast<SQLWCHAR*>(query.data()), query.size());
+  SQLRETURN ret = _autoPrepare ? execute_auto_prepared(query)
+                               : _odbcApi->SQLExecDirect(_statement->get_handle(),
+                                                         reinterpret_cast<SQLWCHAR*>(query.data()),
+                                                         query.size());
   {
     // we may have cancelled this query on a different thread
     // so only switch state if this query completed.
@@ -1120,7 +1180,25 @@ bool OdbcStatementLegacy::try_execute_direct(const shared_ptr<QueryOperationPara
   }
   if (polling_mode) {
     set_state(OdbcStatementState::STATEMENT_POLLING);
-    ret = poll_check(ret, make_shared<vector<uint16_t>>(query.begin(), query.end()), true);
+    if (ret == SQL_STILL_EXECUTING && q->defer_polling && !_autoPrepare) {
+      // the caller polls from the shared poller rather than holding this thread
+      lock_guard<recursive_mutex> lock(g_i_mutex);
+      _pendingQuery = query;
+      _pendingParams = param_set;
+      _executePending.store(true);
+      return true;
+    }
+    ret = poll_check(
+        ret, make_shared<vector<uint16_t>>(query.begin(), query.end()), !_autoPrepare);
+  }
+  return finish_execute_direct(ret, param_set);
+}
+
+bool OdbcStatementLegacy::finish_execute_direct(SQLRETURN ret,
+                                                const shared_ptr<BoundDatumSet>& param_set) {
+  auto& pars = *param_set;
+  if (ret == SQL_NEED_DATA) {
+    ret = send_data_at_exec(pars);
   }
 
   if (ret == SQL_NO_DATA) {
@@ -1166,6 +1244,170 @@ bool OdbcStatementLegacy::try_execute_direct(const shared_ptr<QueryOperationPara
   return start_reading_results();
 }
 
+SQLRETURN OdbcStatementLegacy::execute_auto_prepared(std::u16string& query) {
+  const auto handle = _statement->get_handle();
+  if (!_autoPrepared) {
+    const auto ret = _odbcApi->SQLPrepare(
+        handle, reinterpret_cast<SQLWCHAR*>(query.data()), static_cast<SQLINTEGER>(query.size()));
+    if (!SQL_SUCCEEDED(ret)) {
+      return ret;
+    }
+    _autoPrepared = true;
+    SQL_LOG_DEBUG_STREAM("[" << _handle.toString() << "] execute_auto_prepared prepared");
+  }
+  return _odbcApi->SQLExecute(handle);
+}
+
+// each streamed parameter is asked for in turn by SQLParamData and written
+// chunk by chunk, or batch by batch for a table, the last SQLParamData
+// returns the result of the execute.
+SQLRETURN OdbcStatementLegacy::send_data_at_exec(const BoundDatumSet& param_set) {
+  const auto handle = _statement->get_handle();
+  const auto fail = [&](const string& message) {
+    SQL_LOG_DEBUG_STREAM("[" << _handle.toString() << "] send_data_at_exec " << message);
+    _odbcApi->SQLCancelHandle(SQL_HANDLE_STMT, handle);
+    _errors->push_back(make_shared<OdbcError>("IMNOD", message.c_str(), -1, 0, "", "", 0));
+    return SQL_ERROR;
+  };
+
+  // js is waited on with no call into the driver, so neither a cancel nor
+  // the query timeout would otherwise end a source that never delivers
+  const auto timeout = _operationParams ? _operationParams->timeout : 0;
+  const auto deadline = chrono::steady_clock::now() + chrono::seconds(timeout);
+  const ParamStream::Abort abort = [this, timeout, deadline](string& reason) {
+    if (_cancelRequested.load()) {
+      reason = "[msnodesql] parameter stream cancelled";
+      return true;
+    }
+    if (timeout > 0 && chrono::steady_clock::now() >= deadline) {
+      reason = "[msnodesql] parameter stream timed out after " + to_string(timeout) + " seconds";
+      return true;
+    }
+    return false;
+  };
+
+  SQLPOINTER token = nullptr;
+  auto ret = _odbcApi->SQLParamData(handle, &token);
+  while (ret == SQL_NEED_DATA) {
+    const auto datum = param_set.data_at_exec(token);
+    if (!datum) {
+      return fail("[msnodesql] driver asked for data of a parameter which is not streamed");
+    }
+    const auto stream = datum->get_stream();
+    if (datum->is_tvp) {
+      // one batch per request, the driver asks for the table again until
+      // it is sent a batch of no rows
+      SQLLEN rows = 0;
+      if (stream->Next(abort)) {
+        rows = datum->get_stream_rows();
+      } else if (stream->HasError()) {
+        return fail("[msnodesql] table parameter stream failed: " + stream->Error());
+      }
+      const auto put = _odbcApi->SQLPutData(handle, nullptr, rows);
+      if (!SQL_SUCCEEDED(put)) {
+        return put;
+      }
+      ret = _odbcApi->SQLParamData(handle, &token);
+      continue;
+    }
+    vector<char> chunk;
+    auto sent = false;
+    while (stream->Next(chunk, abort)) {
+      if (chunk.empty()) {
+        continue;
+      }
+      const auto put = _odbcApi->SQLPutData(handle, chunk.data(), static_cast<SQLLEN>(chunk.size()));
+      if (!SQL_SUCCEEDED(put)) {
+        return put;
+      }
+      sent = true;
+    }
+    if (stream->HasError()) {
+      return fail("[msnodesql] parameter stream failed: " + stream->Error());
+    }
+    if (!sent) {
+      // an empty stream is an empty value rather than null
+      const auto put = _odbcApi->SQLPutData(handle, chunk.data(), 0);
+      if (!SQL_SUCCEEDED(put)) {
+        return put;
+      }
+    }
+    ret = _odbcApi->SQLParamData(handle, &token);
+  }
+  return ret;
+}
+
+void OdbcStatementLegacy::reuse(const shared_ptr<QueryOperationParams>& q) {
+  lock_guard<recursive_mutex> lock(g_i_mutex);
+  _operationParams = q;
+  _numericStringEnabled = q->numeric_string;
+  _bigIntAsNativeEnabled = q->bigint_as_native;
+  _pollingEnabled.store(q->polling);
+  _cancelRequested.store(false);
+  _stateNotifier.reset();
+  _stateNotifierShared.reset();
+  _errors->clear();
+  if (_prepared && _preparedResultset) {
+    // an execute returning no data replaces the set holding the column metadata
+    _resultset = _preparedResultset;
+    _resultset->_end_of_rows = true;
+    _statementState.store(OdbcStatementState::STATEMENT_PREPARED);
+  } else {
+    _statementState.store(OdbcStatementState::STATEMENT_CREATED);
+  }
+}
+
+size_t OdbcStatementLegacy::memory_footprint() const {
+  size_t bytes = _operationParams ? _operationParams->query_string.size() * sizeof(char16_t) : 0;
+  for (const auto& set : {_preparedStorage, _boundParamsSet, _preparedParams}) {
+    if (!set) {
+      continue;
+    }
+    for (const auto& datum : *set) {
+      bytes += static_cast<size_t>(max(datum->buffer_len, static_cast<SQLLEN>(0))) *
+               datum->get_ind_vec().size();
+    }
+  }
+  return bytes;
+}
+
+bool OdbcStatementLegacy::close_cursor() {
+  lock_guard<recursive_mutex> lock(g_i_mutex);
+  if (!_statement) {
+    return false;
+  }
+  // once every result has been read the driver has already closed the cursor
+  if (_resultset && _resultset->EndOfResults()) {
+    return true;
+  }
+  // step past whatever is left rather than SQLCloseCursor, which fails with
+  // 24000 on a statement that never opened a cursor e.g. an insert.
+  SQLRETURN ret;
+  do {
+    ret = _odbcApi->SQLMoreResults(_statement->get_handle());
+  } while (SQL_SUCCEEDED(ret));
+  return ret == SQL_NO_DATA;
+}
+
+bool OdbcStatementLegacy::Abandon() {
+  lock_guard<recursive_mutex> lock(g_i_mutex);
+  if (!_statement) {
+    return false;
+  }
+  if (_resultset && _resultset->EndOfResults()) {
+    return true;
+  }
+  // SQL_CLOSE drops the rest of this result and every one after it in one
+  // call, where close_cursor steps through them with SQLMoreResults
+  const auto ret = _odbcApi->SQLFreeStmt(_statement->get_handle(), SQL_CLOSE);
+  if (_resultset) {
+    _resultset->_end_of_rows = true;
+    _resultset->_end_of_results = true;
+  }
+  SQL_LOG_DEBUG_STREAM("OdbcStatementLegacy::Abandon [" << _handle.toString() << "] " << ret);
+  return check_odbc_error(ret);
+}
+
 bool OdbcStatementLegacy::dispatch_prepared(
     const SQLSMALLINT t,
     const size_t column_size,
@@ -2088,6 +2330,7 @@ bool OdbcStatementLegacy::reserved_chars(const size_t row_count,
       u8_store->reserve(actual_size + offset);
     }
     const auto value = make_shared<CharColumn>(column, u8_store, offset, to_read);
+    value->SetBorrowed();
     _resultset->add_column(row_id, value);
   }
   return true;
@@ -2118,6 +2361,7 @@ bool OdbcStatementLegacy::reserved_string(const size_t row_count,
     }
     auto to_read = column_size > 0 ? min(actual_size, column_size) : actual_size;
     const auto value = make_shared<StringColumn>(column, uint16_store, offset, to_read);
+    value->SetBorrowed();
     _resultset->add_column(row_id, value);
   }
   return true;
@@ -2141,6 +2385,7 @@ bool OdbcStatementLegacy::reserved_binary(const size_t row_count,
       uint8_store->reserve(str_len_or_ind_ptr + offset);
     }
     const auto value = make_shared<BinaryColumn>(column, storage, offset, str_len_or_ind_ptr);
+    value->SetBorrowed();
     _resultset->add_column(row_id, value);
   }
   return true;
@@ -0,0 +1,137 @@
+#include "handle_diagnostics.h"
+#include "common/platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+#if !defined(_WIN32) && defined(__has_include)
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define MSSQL_HAVE_EXECINFO 1
+#endif
+#endif
+
+namespace mssql {
+
+namespace {
+constexpr int max_frames = 32;
+// frames for capture_stack and Record themselves
+constexpr int skip_frames = 2;
+
+std::string capture_stack() {
+  void* frames[max_frames];
+  std::ostringstream ss;
+#if defined(_WIN32)
+  const auto count = CaptureStackBackTrace(skip_frames, max_frames, frames, nullptr);
+  for (USHORT i = 0; i < count; ++i) {
+    ss << "  " << frames[i] << "\n";
+  }
+#elif defined(MSSQL_HAVE_EXECINFO)
+  const auto count = backtrace(frames, max_frames);
+  char** symbols = backtrace_symbols(frames, count);
+  if (symbols) {
+    for (auto i = skip_frames; i < count; ++i) {
+      ss << "  " << symbols[i] << "\n";
+    }
+    std::free(symbols);
+  }
+#else
+  (void)frames;
+#endif
+  return ss.str();
+}
+}  // namespace
+
+HandleDiagnostics& HandleDiagnostics::GetInstance() {
+  static HandleDiagnostics instance;
+  return instance;
+}
+
+void HandleDiagnostics::Configure(const bool enabled,
+                                  const uint32_t sample_every,
+                                  const size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sample_every_.store(std::max<uint32_t>(sample_every, 1), std::memory_order_relaxed);
+  const auto bounded = std::max<size_t>(capacity, 1);
+  if (bounded != capacity_ || !enabled) {
+    ring_.clear();
+    next_ = 0;
+  }
+  capacity_ = bounded;
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void HandleDiagnostics::Record(const HandleEventKind kind,
+                               const std::string& name,
+                               const void* handle) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  HandleEvent event;
+  event.kind = kind;
+  event.name = name;
+  event.handle = handle;
+  event.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  std::ostringstream thread;
+  thread << std::this_thread::get_id();
+  event.thread = thread.str();
+  event.stack = capture_stack();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  event.sequence = ++sequence_;
+  if (ring_.size() < capacity_) {
+    ring_.push_back(std::move(event));
+  } else {
+    ring_[next_] = std::move(event);
+  }
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<HandleEvent> HandleDiagnostics::Events() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<HandleEvent> events;
+  events.reserve(ring_.size());
+  // once full the oldest entry is the one next to be overwritten
+  const auto start = ring_.size() < capacity_ ? 0 : next_;
+  for (size_t i = 0; i < ring_.size(); ++i) {
+    events.push_back(ring_[(start + i) % ring_.size()]);
+  }
+  return events;
+}
+
+std::string HandleDiagnostics::Dump(const std::string& name) const {
+  std::ostringstream ss;
+  for (const auto& event : Events()) {
+    if (event.name != name) {
+      continue;
+    }
+    ss << "#" << event.sequence << " " << KindName(event.kind) << " " << event.name << " "
+       << event.handle << " thread=" << event.thread << "\n"
+       << event.stack;
+  }
+  return ss.str();
+}
+
+const char* HandleDiagnostics::KindName(const HandleEventKind kind) {
+  switch (kind) {
+    case HandleEventKind::Alloc:
+      return "alloc";
+    case HandleEventKind::Free:
+      return "free";
+    case HandleEventKind::Detach:
+      return "detach";
+    case HandleEventKind::Adopt:
+      return "adopt";
+    case HandleEventKind::DoubleFree:
+      return "double-free";
+  }
+  return "unknown";
+}
+
+}  // namespace mssql
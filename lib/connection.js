@@ -14,6 +14,11 @@ const { BasePromises } = require('./base-promises')
 const { PreparedStatement } = require('./prepared-statement')
 const { logger } = require('./logger')
 const cppDriver = new utilModule.Native().cppDriver
+const defaultParamSizeBuckets = [32, 128, 512, 4000]
+// closes each statement of a batch, see ConnectionWrapper.batch
+const batchMarker = '~msnodesql_batch'
+// statements the server requires to be alone in, or first in, their batch
+const batchAlone = /^(?:\s|--[^\n]*\n|\/\*[\s\S]*?\*\/)*(?:create|alter|create\s+or\s+alter)\s+(?:proc|procedure|view|function|trigger|schema|rule|default)\b/i
 
 class PrivateConnection {
   constructor (sqlMeta, userTypes, parentFn, p, cb, id) {
@@ -132,6 +137,22 @@ class ConnectionWrapperPromises extends BasePromises {
   async rollback () {
     return this.op(cb => this.connection.rollback(cb))
   }
+
+  async bcpFile (options) {
+    return this.op(cb => this.connection.bcpFile(options, cb))
+  }
+
+  async exportQuery (sql, fd, options) {
+    return this.op(cb => this.connection.exportQuery(sql, fd, options, cb))
+  }
+
+  async transaction (batch, options) {
+    return this.op(cb => this.connection.transaction(batch, options, cb))
+  }
+
+  async batch (batch, options) {
+    return this.op(cb => this.connection.batch(batch, options, cb))
+  }
 }
 
 class ConnectionWrapper {
@@ -143,9 +164,12 @@ class ConnectionWrapper {
     this.notifier = new notifyModule.NotifyFactory()
     this.nextQueryId = 0
     this.dead = false
+    this.inTransaction = false
     this.useUTC = true
     this.driverVersion = 0
     this.maxPreparedColumnSize = null
+    this.paramSizeBuckets = []
+    this.statementCache = { capacity: 0, maxBytes: 0, autoPrepareThreshold: 0 }
     this.useNumericString = false
     this.useBigIntAsNative = false
     this.procedureCache = null
@@ -180,6 +204,93 @@ class ConnectionWrapper {
     this.maxPreparedColumnSize = m
   }
 
+  // value sized string and binary parameters are rounded up to a bucket so
+  // the server sees a handful of signatures rather than one per length.
+
+  setParamSizeBuckets (buckets) {
+    if (buckets === true) {
+      buckets = defaultParamSizeBuckets
+    } else if (!buckets) {
+      buckets = []
+    }
+    if (!Array.isArray(buckets) || buckets.some(b => !Number.isInteger(b) || b <= 0)) {
+      throw new Error('[msnodesql] setParamSizeBuckets expects an array of positive integers.')
+    }
+    this.paramSizeBuckets = buckets.slice().sort((a, b) => a - b)
+    this.driverMgr.setParamSizeBuckets(this.paramSizeBuckets)
+  }
+
+  getParamSizeBuckets () {
+    return this.paramSizeBuckets
+  }
+
+  getParamSignatureCount () {
+    return this.driverMgr.getParamSignatureCount()
+  }
+
+  // prepared statements are kept on the connection once released, up to
+  // capacity statements or maxBytes of bound buffers. with autoPrepareThreshold
+  // set, ad hoc sql with the same parameter signature run that many times is
+  // prepared as well.
+
+  setStatementCache (opts) {
+    opts = opts || {}
+    const current = this.statementCache
+    const capacity = opts.capacity === undefined ? 64 : opts.capacity
+    const maxBytes = opts.maxBytes === undefined ? 16 * 1024 * 1024 : opts.maxBytes
+    const autoPrepareThreshold = opts.autoPrepareThreshold === undefined ? current.autoPrepareThreshold : opts.autoPrepareThreshold
+    const valid = v => Number.isInteger(v) && v >= 0
+    if (!valid(capacity) || !valid(maxBytes) || !valid(autoPrepareThreshold)) {
+      throw new Error('[msnodesql] setStatementCache expects non negative integer capacity, maxBytes and autoPrepareThreshold.')
+    }
+    this.statementCache = { capacity, maxBytes, autoPrepareThreshold }
+    this.driverMgr.setStatementCache(autoPrepareThreshold, capacity, maxBytes)
+  }
+
+  getStatementCache () {
+    return this.statementCache
+  }
+
+  getStatementCacheStats () {
+    return this.driverMgr.getStatementCacheStats()
+  }
+
+  // statement handles released by finished queries are reset and kept for
+  // the next query rather than freed, up to size handles (default 16).
+
+  setStatementPoolSize (size) {
+    if (!Number.isInteger(size) || size < 0) {
+      throw new Error('[msnodesql] setStatementPoolSize expects a non negative integer size.')
+    }
+    this.driverMgr.setStatementPoolSize(size)
+  }
+
+  getStatementPoolStats () {
+    return this.driverMgr.getStatementPoolStats()
+  }
+
+  // the auto prepare api from before the statement cache, kept as a wrapper
+  // setting only its threshold and capacity.
+
+  setAutoPrepare (threshold, capacity) {
+    threshold = threshold || 0
+    if (capacity === undefined) {
+      capacity = this.statementCache.capacity || 64
+    }
+    if (!Number.isInteger(threshold) || threshold < 0 || !Number.isInteger(capacity) || capacity < 0) {
+      throw new Error('[msnodesql] setAutoPrepare expects non negative integer threshold and capacity.')
+    }
+    this.setStatementCache({
+      capacity,
+      maxBytes: this.statementCache.maxBytes || undefined,
+      autoPrepareThreshold: threshold
+    })
+  }
+
+  getAutoPrepare () {
+    return { threshold: this.statementCache.autoPrepareThreshold, capacity: this.statementCache.capacity }
+  }
+
   getUseUTC () {
     return this.useUTC
   }
@@ -340,7 +451,11 @@ class ConnectionWrapper {
       throw new Error('[msnodesql] Connection is closed.')
     }
     callback = callback || this.defaultCallback
-    this.driverMgr.beginTransaction(callback)
+    this.inTransaction = true
+    this.driverMgr.beginTransaction((err, more) => {
+      if (err) this.inTransaction = false
+      callback(err, more)
+    })
   }
 
   cancelQuery (notify, callback) {
@@ -384,7 +499,7 @@ class ConnectionWrapper {
     }
 
     callback = callback || this.defaultCallback
-
+    this.inTransaction = false
     this.driverMgr.commit(callback)
   }
 
@@ -394,9 +509,240 @@ class ConnectionWrapper {
     }
 
     callback = callback || this.defaultCallback
+    this.inTransaction = false
     this.driverMgr.rollback(callback)
   }
 
+  bcpFile (options, callback) {
+    if (this.dead) {
+      throw new Error('[msnodesql] Connection is closed.')
+    }
+
+    callback = callback || this.defaultCallback
+    this.driverMgr.bcpFile(options, callback)
+  }
+
+  // stream a query result to an open file descriptor as csv, tsv or ndjson.
+  // the caller owns the descriptor and closes it once the callback fires.
+
+  exportQuery (queryOrObj, fd, options, callback) {
+    if (this.dead) {
+      throw new Error('[msnodesql] Connection is closed.')
+    }
+    if (typeof options === 'function') {
+      callback = options
+      options = {}
+    }
+    options = options || {}
+    callback = callback || this.defaultCallback
+
+    const format = options.format || 'csv'
+    if (!['csv', 'tsv', 'ndjson'].includes(format)) {
+      throw new Error(`[msnodesql] exportQuery unknown format '${format}'.`)
+    }
+    const queryObj = this.notifier.validateQuery(queryOrObj, this.useUTC, 'exportQuery')
+    const exportOptions = {
+      fd,
+      format,
+      header: options.header !== false,
+      null_value: options.nullValue || '',
+      buffer_size: options.bufferSize || 1024 * 1024,
+      batch_size: options.batchSize || 5000,
+      progress_interval_ms: options.progressInterval === undefined ? 250 : options.progressInterval
+    }
+    if (typeof options.progress === 'function') {
+      exportOptions.progress = options.progress
+    }
+    this.driverMgr.exportQuery(this.nextQueryId++, queryObj, options.params || [], exportOptions, callback)
+  }
+
+  // run a batch of statements in one transaction on the driver, committed when
+  // all succeed else rolled back at the first error. each entry is sql or
+  // { sql, params } - the results of every statement come back together.
+  // it cannot nest inside a transaction opened with beginTransaction.
+
+  transaction (batch, options, callback) {
+    if (this.dead) {
+      throw new Error('[msnodesql] Connection is closed.')
+    }
+    if (typeof options === 'function') {
+      callback = options
+      options = {}
+    }
+    options = options || {}
+    callback = callback || this.defaultCallback
+    if (!Array.isArray(batch)) {
+      callback(new Error('[msnodesql] transaction expects an array of statements.'))
+      return
+    }
+    if (this.inTransaction) {
+      callback(new Error('[msnodesql] transaction cannot start while a transaction from beginTransaction is open, commit or roll back first.'))
+      return
+    }
+    const statements = batch.map(entry => {
+      const s = typeof entry === 'string' ? { sql: entry } : entry
+      const queryObj = this.notifier.validateQuery(s.sql, this.useUTC, 'transaction')
+      if (!Object.hasOwnProperty.call(queryObj, 'numeric_string')) {
+        queryObj.numeric_string = this.useNumericString
+      }
+      if (!Object.hasOwnProperty.call(queryObj, 'bigint_as_native')) {
+        queryObj.bigint_as_native = this.useBigIntAsNative
+      }
+      queryObj.query_id = this.nextQueryId++
+      return { query: queryObj, params: s.params || [] }
+    })
+    const nativeOptions = {
+      batch_size: options.batchSize || 5000
+    }
+    this.driverMgr.transaction(statements, nativeOptions, (err, res) => {
+      if (err) {
+        callback(err)
+        return
+      }
+      const results = {
+        committed: res.committed,
+        rolledBack: res.rolledBack,
+        statements: res.statements.map(s => this.statementResults(s))
+      }
+      const failed = res.failed >= 0 ? results.statements[res.failed] : null
+      const e = failed?.errors[0] || res.errors[0] || null
+      if (e) {
+        e._results = results
+      }
+      callback(e, results)
+    })
+  }
+
+  // lay out what one statement returned as the query aggregator does, a
+  // result per set of columns and a count per statement without any.
+
+  statementResults (s) {
+    const ret = {
+      executed: s.executed,
+      meta: [],
+      first: null,
+      results: [],
+      counts: [],
+      info: null,
+      errors: []
+    }
+    const route = errors => {
+      errors.forEach(e => {
+        if (e.sqlstate && e.sqlstate.substring(0, 2) === '01') {
+          ret.info = ret.info || []
+          ret.info.push(e.message.substring(e.message.lastIndexOf(']') + 1))
+        } else {
+          ret.errors.push(e)
+        }
+      })
+    }
+    route(s.errors)
+    if (!s.executed || !s.meta) {
+      return ret
+    }
+    let current = s.meta
+    const open = r => {
+      if (r.meta && r.meta.length > 0) {
+        ret.meta.push(r.meta)
+        ret.results.push([])
+      }
+    }
+    open(current)
+    for (const step of s.steps || []) {
+      switch (step.step) {
+        case 'fetchRows': {
+          if (step.errors) {
+            route(step.errors)
+            break
+          }
+          const rows = ret.results[ret.results.length - 1]
+          const meta = ret.meta[ret.meta.length - 1]
+          rows.push(...this.driverMgr.objectify({ meta, rows: step.data }))
+          break
+        }
+        case 'nextResultSet':
+          route(step.errors)
+          if (!current.meta || current.meta.length === 0) {
+            ret.counts.push(current.rowCount)
+          }
+          if (!step.endOfResults) {
+            current = step
+            open(current)
+          }
+          break
+      }
+    }
+    ret.first = ret.results.length > 0 ? ret.results[0] : null
+    return ret
+  }
+
+  // independent statements sent to the server as one batch in one round
+  // trip. parameters are positional so those of each statement are simply
+  // appended in order. each entry is sql or { sql, params } and gets back its
+  // own results and errors. the server runs on after a statement error, so do
+  // the later statements - only those after an aborted batch are reported as
+  // not run. the statements share the batch scope, so a variable declared in
+  // one is seen by the rest and cannot be declared again. create procedure,
+  // view, function, trigger or schema must be alone in a batch and is refused.
+
+  batch (batch, options, callback) {
+    if (this.dead) {
+      throw new Error('[msnodesql] Connection is closed.')
+    }
+    if (typeof options === 'function') {
+      callback = options
+      options = {}
+    }
+    options = options || {}
+    callback = callback || this.defaultCallback
+    if (!Array.isArray(batch)) {
+      callback(new Error('[msnodesql] batch expects an array of statements.'))
+      return
+    }
+    if (batch.length === 0) {
+      setImmediate(() => callback(null, []))
+      return
+    }
+    let line = 1
+    const lines = []
+    const params = []
+    const text = batch.map((entry, i) => {
+      const s = typeof entry === 'string' ? { sql: entry } : entry
+      if (typeof s.sql !== 'string') {
+        throw new Error(`[msnodesql] batch statement ${i} has no sql.`)
+      }
+      if (batchAlone.test(s.sql)) {
+        throw new Error(`[msnodesql] batch statement ${i} must be alone in its batch.`)
+      }
+      lines.push(line)
+      line += s.sql.split('\n').length + 1
+      params.push(...(s.params || []))
+      // terminated so a following with or throw starts a new statement
+      return `${s.sql}\n;select ${i} as [${batchMarker}];\n`
+    }).join('')
+    const queryObj = this.notifier.validateQuery(options.timeoutSecs
+      ? { query_str: text, query_timeout: options.timeoutSecs }
+      : text, this.useUTC, 'batch')
+    if (!Object.hasOwnProperty.call(queryObj, 'numeric_string')) {
+      queryObj.numeric_string = this.useNumericString
+    }
+    if (!Object.hasOwnProperty.call(queryObj, 'bigint_as_native')) {
+      queryObj.bigint_as_native = this.useBigIntAsNative
+    }
+    const nativeOptions = {
+      marker: batchMarker,
+      lines,
+      batch_size: options.batchSize || 5000
+    }
+    this.driverMgr.batch(this.nextQueryId++, queryObj, params, nativeOptions, (err, statements) => {
+      if (err) {
+        callback(err)
+        return
+      }
+      callback(null, statements.map(s => this.statementResults(s)))
+    })
+  }
+
   // inform driver to prepare the sql statement and reserve it for repeated use with parameters.
 
   prepare (queryOrObj, callback) {
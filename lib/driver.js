@@ -7,6 +7,7 @@ const driverModule = ((() => {
   const { DriverRead } = require('./reader')
   const { NativePreparedQueryHandler, NativeQueryHandler, NativeProcedureQueryHandler } = require('./query-handler')
   const { logger } = require('./logger')
+  const { packParams } = require('./param-descriptor')
   const driverCommandEnum = {
     CANCEL: 10,
     COMMIT: 11,
@@ -16,7 +17,13 @@ const driverModule = ((() => {
     FREE_STATEMENT: 15,
     QUERY: 16,
     CLOSE: 17,
-    UNBIND: 18
+    UNBIND: 18,
+    BCP_FILE: 19,
+    EXPORT: 20,
+    EXECUTE_MANY: 21,
+    ABANDON: 22,
+    TRANSACTION: 23,
+    BATCH: 24
   }
 
   class DriverMgr {
@@ -31,6 +38,30 @@ const driverModule = ((() => {
       this.reader.setUseUTC(utc)
     }
 
+    setParamSizeBuckets (buckets) {
+      this.cppDriver.setParamSizeBuckets(buckets)
+    }
+
+    getParamSignatureCount () {
+      return this.cppDriver.getParamSignatureCount()
+    }
+
+    setStatementCache (threshold, capacity, maxBytes) {
+      this.cppDriver.setStatementCache(threshold, capacity, maxBytes)
+    }
+
+    getStatementCacheStats () {
+      return this.cppDriver.getStatementCacheStats()
+    }
+
+    setStatementPoolSize (size) {
+      this.cppDriver.setStatementPoolSize(size)
+    }
+
+    getStatementPoolStats () {
+      return this.cppDriver.getStatementPoolStats()
+    }
+
     emptyQueue () {
       this.workQueue.emptyQueue()
     }
@@ -65,7 +96,11 @@ const driverModule = ((() => {
       const qid = notify.getQueryId()
       const handle = notify.getHandle()
 
-      if (queueItem.operationId === peek.operationId) {
+      if (queueItem.operationId === peek.operationId && notify.isReleased()) {
+        // read to the end and freed natively, nothing is left to cancel
+        logger.debugLazy(() => `${queueItem.operationId} already released, cancel is local`)
+        this.forwardCancel(null, callback)
+      } else if (queueItem.operationId === peek.operationId) {
         logger.debugLazy(() => `send ${queueItem.operationId} cancel to the driver`)
         this.cppDriver.cancelQuery(qid, handle, (e) => {
           this.forwardCancel(e, callback)
@@ -194,6 +229,11 @@ const driverModule = ((() => {
       const queryId = notify.getQueryId()
       if (handle) {
         this.workQueue.enqueue(driverCommandEnum.FREE_STATEMENT, () => {
+          if (notify.isReleased()) {
+            logger.debugLazy(() => `statement ${queryId} already released by pipeline`, 'DriverMgr.freeStatement')
+            this.raiseFree(queryId, notify, callback)
+            return
+          }
           logger.debugLazy(() => `free statement ${queryId}`, 'DriverMgr.freeStatement')
           this.cppDriver.releaseStatement(queryId, handle,
             () => {
@@ -206,6 +246,37 @@ const driverModule = ((() => {
       }
     }
 
+    // a reader stopping part way - the rows and results left are dropped
+    // natively by closing the cursor, neither fetched nor cancelled. the
+    // statement is freed unless it is kept prepared for another execute.
+
+    abandonStatement (notify, release, callback) {
+      const handle = notify.getHandle()
+      const queryId = notify.getQueryId()
+      this.workQueue.enqueue(driverCommandEnum.ABANDON, () => {
+        if (!handle || notify.isReleased()) {
+          logger.debugLazy(() => `statement ${queryId} has nothing left to abandon`, 'DriverMgr.abandonStatement')
+          if (release) {
+            this.raiseFree(queryId, notify, callback)
+          } else {
+            this.next(callback)
+          }
+          return
+        }
+        logger.debugLazy(() => `abandon statement ${queryId} release ${release}`, 'DriverMgr.abandonStatement')
+        this.cppDriver.abandonStatement(queryId, handle, release, (err) => {
+          if (err) {
+            logger.debugLazy(() => `abandon statement ${queryId} error ${JSON.stringify(err)}`, 'DriverMgr.abandonStatement')
+          }
+          if (release) {
+            this.raiseFree(queryId, notify, callback)
+          } else {
+            this.next(callback, err)
+          }
+        })
+      }, [])
+    }
+
     onStatementComplete (notify, outputParams, callback, results, more) {
       if (!more) {
         this.freeStatement(notify, () => {
@@ -251,6 +322,86 @@ const driverModule = ((() => {
       }, [])
     }
 
+    // the driver reads the file on the worker thread, rows never reach js.
+
+    bcpFile (options, callback) {
+      this.workQueue.enqueue(driverCommandEnum.BCP_FILE, () => {
+        this.cppDriver.bcpFile(options, (err, rows) => {
+          setImmediate(() => {
+            callback(err || null, rows)
+            setImmediate(() => {
+              this.workQueue.nextOp()
+            })
+          })
+        })
+      }, [])
+    }
+
+    // rows are fetched and written to the fd on the worker thread, only
+    // progress counts and the final summary come back to js.
+
+    exportQuery (queryId, queryObj, params, options, callback) {
+      this.workQueue.enqueue(driverCommandEnum.EXPORT, () => {
+        this.cppDriver.exportQuery(queryId, queryObj, params, options, (err, summary) => {
+          setImmediate(() => {
+            callback(err || null, summary)
+            setImmediate(() => {
+              this.workQueue.nextOp()
+            })
+          })
+        })
+      }, [])
+    }
+
+    // every parameter set is bound and executed on the worker thread, the
+    // outcome of each set comes back to js in one callback.
+
+    executeMany (notify, paramSets, options, callback) {
+      this.workQueue.enqueue(driverCommandEnum.EXECUTE_MANY, () => {
+        this.cppDriver.executeMany(notify.getQueryId(), paramSets.map(packParams), options, (err, results) => {
+          setImmediate(() => {
+            callback(err || null, results)
+            setImmediate(() => {
+              this.workQueue.nextOp()
+            })
+          })
+        })
+      }, [])
+    }
+
+    // the statements run between a begin and a commit or rollback on the
+    // worker thread, every result of every statement comes back in one callback.
+
+    transaction (statements, options, callback) {
+      this.workQueue.enqueue(driverCommandEnum.TRANSACTION, () => {
+        const packed = statements.map(s => ({ query: s.query, params: packParams(s.params) }))
+        this.cppDriver.transaction(packed, options, (err, results) => {
+          setImmediate(() => {
+            callback(err || null, results)
+            setImmediate(() => {
+              this.workQueue.nextOp()
+            })
+          })
+        })
+      }, [])
+    }
+
+    // statements joined into one batch are executed once, their results are
+    // split back to each statement natively.
+
+    batch (queryId, queryObj, params, options, callback) {
+      this.workQueue.enqueue(driverCommandEnum.BATCH, () => {
+        this.cppDriver.batch(queryId, queryObj, packParams(params), options, (err, results) => {
+          setImmediate(() => {
+            callback(err || null, results)
+            setImmediate(() => {
+              this.workQueue.nextOp()
+            })
+          })
+        })
+      }, [])
+    }
+
     prepare (notify, queryOrObj, callback) {
       this.workQueue.enqueue(driverCommandEnum.PREPARE, () => {
         this.cppDriver.prepare(notify.getQueryId(), queryOrObj, (err, meta) => {
@@ -273,7 +424,7 @@ const driverModule = ((() => {
 
     readAllPrepared (notify, queryObj, params, cb) {
       this.readOperation(notify, queryObj, params,
-        () => new NativePreparedQueryHandler(this.cppDriver), cb)
+        () => new NativePreparedQueryHandler(this.cppDriver, this), cb)
     }
 
     readAllProc (notify, queryObj, params, cb) {
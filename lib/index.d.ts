@@ -2,7 +2,7 @@ declare namespace MsNodeSqlV8 {
   export type sqlJsColumnType = string | boolean | Date | number | Buffer
   export type sqlRecordType = Record<string | number, sqlJsColumnType>
   export type sqlObjectType = sqlRecordType | object | any
-  export type sqlQueryParamType = sqlJsColumnType | sqlJsColumnType[] | ConcreteColumnType | ConcreteColumnType[] | TvpParam
+  export type sqlQueryParamType = sqlJsColumnType | sqlJsColumnType[] | ConcreteColumnType | ConcreteColumnType[] | TvpParam | StreamParam
   export type sqlPoolEventType = MessageCb | PoolStatusRecordCb | PoolOptionsEventCb | StatusCb | ErrorEventCb
   export type sqlQueryEventType = SubmittedEventCb | ColumnEventCb | EventColumnCb | StatusCb | RowEventCb | MetaEventCb | RowCountEventCb | ErrorEventCb
   export type sqlProcParamType = sqlObjectType | sqlQueryParamType
@@ -144,6 +144,36 @@ declare namespace MsNodeSqlV8 {
     Cat: string
   }
 
+  export interface StatementCacheOptions {
+    capacity?: number
+    maxBytes?: number
+    autoPrepareThreshold?: number
+  }
+
+  export interface StatementCacheStats {
+    size: number
+    bytes: number
+    hits: number
+    misses: number
+    evictions: number
+    invalidations: number
+  }
+
+  export interface StatementPoolStats {
+    allocated: number
+    reused: number
+    recycled: number
+    discarded: number
+    idle: number
+  }
+
+  export interface ExecutorStats {
+    maxThreads: number
+    threads: number
+    busy: number
+    polling: number
+  }
+
   export interface PoolOptions {
     /**
      * minimum number of connections to keep open even when quiet.
@@ -183,6 +213,30 @@ declare namespace MsNodeSqlV8 {
      * nvarchar(max) prepared columns must be constrained (Default 8k)
      */
     maxPreparedColumnSize?: number
+    /**
+     * round string and binary parameter sizes up to these buckets on each
+     * connection so the server reuses plans, true for the default buckets.
+     */
+    paramSizeBuckets?: number[] | boolean
+    /**
+     * keep ad hoc sql prepared on each connection once executed this many
+     * times with the same parameter signature, 0 (default) disables.
+     */
+    autoPrepareThreshold?: number
+    /**
+     * most auto prepared statements held per connection (default 64)
+     */
+    autoPrepareCapacity?: number
+    /**
+     * keep prepared statements on each connection once freed, see
+     * Connection.setStatementCache
+     */
+    statementCache?: StatementCacheOptions
+    /**
+     * idle statement handles kept for reuse on each connection, see
+     * Connection.setStatementPoolSize
+     */
+    statementPoolSize?: number
     /**
      * the connection string used for each connection opened in pool
      */
@@ -316,6 +370,11 @@ declare namespace MsNodeSqlV8 {
      * replace meta empty col name with Column0, Column1
      */
     replaceEmptyColumnNames?: boolean
+    /**
+     * read every result set natively in one trip while the rows held stay
+     * under this many bytes, then stream the rest. default 16MB, 0 to stream.
+     */
+    drainMaxBytes?: number
   }
 
   export interface PoolPromises extends AggregatorPromises {
@@ -349,6 +408,18 @@ declare namespace MsNodeSqlV8 {
      * @returns promise of bound proc to call.
      */
     getProc: (name: string) => Promise<ProcedureDefinition>
+    /**
+     * insert rows from source into table, partitioned into chunks which are
+     * loaded concurrently over several pooled connections, by default with bcp.
+     * on error the source is no longer read, in flight chunks complete and the
+     * first error is thrown with the aggregated summary attached, its errors
+     * being those after the one thrown.
+     * @param name of table to load.
+     * @param source async iterable, iterable or Readable of row objects.
+     * @param options concurrency (default pool ceiling), batchSize, tabLock.
+     * @returns promise of total rows, batches and errors.
+     */
+    bulkLoad: (name: string, source: BulkRowSource, options?: BulkLoadOptions) => Promise<BulkStreamSummary>
 
     beginTransaction: () => Promise<PoolDescription>
     commitTransaction: (description: PoolDescription) => Promise<void>
@@ -405,6 +476,8 @@ declare namespace MsNodeSqlV8 {
     getQueryId (): Query | number
     isPendingCancel (): boolean
     cancelQuery (cb?: StatusCb): void
+    abandonQuery (cb?: StatusCb): void
+    toReadable (options?: { highWaterMark?: number }): NodeJS.ReadableStream & AsyncIterable<any>
     pauseQuery (): void
     resumeQuery (): void
     setQueryObj (q: Query, chunky: PoolChunky): void
@@ -731,8 +804,104 @@ declare namespace MsNodeSqlV8 {
      * @returns promise to await for transaction to be rolled back
      */
     rollback: () => Promise<void>
+    /**
+     * run the query and write the first result set with columns to an open file
+     * descriptor. rows are formatted natively and never become JS objects.
+     * @param sql the query to export
+     * @param fd descriptor from fs.open, closed by the caller
+     * @param options format, header, batching and progress callback
+     * @returns promise resolving to rows and bytes written
+     */
+    exportQuery: (sql: sqlQueryType, fd: number, options?: ExportOptions) => Promise<ExportSummary>
+    /**
+     * run the statements in one transaction on the driver thread, committed
+     * when all succeed else rolled back at the first error, which rejects with
+     * the results so far on its _results property. rejected while a
+     * transaction opened with beginTransaction is still open.
+     * @param batch sql, or sql with its parameters, for each statement
+     * @param options rows fetched per batch
+     * @returns promise resolving to what each statement returned
+     */
+    transaction: (batch: TransactionStatement[], options?: TransactionOptions) => Promise<TransactionResults>
+    /**
+     * send independent statements to the server as one batch in a single round
+     * trip, the results are split back to each statement. parameters are
+     * positional so each statement binds its own in order. the statements
+     * after an error still run unless it aborts the batch, then they come back
+     * with executed false. statements share the batch scope - declare a
+     * variable once - and create procedure, view, function, trigger or schema
+     * is refused as it must be alone in a batch.
+     * @param batch sql, or sql with its parameters, for each statement
+     * @param options rows fetched per batch and a timeout for the whole batch
+     * @returns promise resolving to the results of each statement in order
+     */
+    batch: (batch: BatchStatement[], options?: BatchOptions) => Promise<BatchResult[]>
+  }
+
+  export interface ExportOptions {
+    // default 'csv'
+    format?: 'csv' | 'tsv' | 'ndjson'
+    // column names as the first line for csv and tsv, default true
+    header?: boolean
+    // text written for a null in csv and tsv, default empty
+    nullValue?: string
+    // bytes buffered before each write, default 1MB
+    bufferSize?: number
+    // rows fetched per batch, default 5000
+    batchSize?: number
+    params?: sqlQueryParamType[]
+    // called on the js thread as batches are written, at most once per
+    // progressInterval, and may skip intermediate counts
+    progress?: (rows: number, bytes: number) => void
+    // least milliseconds between progress calls, default 250, 0 for every batch
+    progressInterval?: number
+  }
+
+  export interface ExportSummary {
+    rows: number
+    bytes: number
+  }
+
+  export type ExportCb = (err: Error | null, summary?: ExportSummary) => void
+
+  export type TransactionStatement = sqlQueryType | { sql: sqlQueryType, params?: sqlQueryParamType[] }
+
+  export interface TransactionOptions {
+    // rows fetched per batch, default 5000
+    batchSize?: number
+  }
+
+  export interface TransactionStatementResult {
+    // false when the statement did not run, bound in error or after a failure
+    executed: boolean
+    meta: Meta[][]
+    first: any[] | null
+    results: any[][]
+    counts: number[]
+    info: string[] | null
+    errors: Error[]
+  }
+
+  export interface TransactionResults {
+    committed: boolean
+    rolledBack: boolean
+    statements: TransactionStatementResult[]
   }
 
+  export type TransactionCb = (err: Error | null, results?: TransactionResults) => void
+
+  export type BatchStatement = string | { sql: string, params?: sqlQueryParamType[] }
+
+  export interface BatchOptions {
+    // rows fetched per batch, default 5000
+    batchSize?: number
+    timeoutSecs?: number
+  }
+
+  export type BatchResult = TransactionStatementResult
+
+  export type BatchCb = (err: Error | null, results?: BatchResult[]) => void
+
   export interface Connection extends GetSetUTC, SubmitQuery {
     /**
      * collection of promises to close connection, get a proc, table, prepare a query
@@ -783,6 +952,50 @@ declare namespace MsNodeSqlV8 {
      */
     setMaxPreparedColumnSize: (size: number) => void
     getMaxPreparedColumnSize: () => number
+    /**
+     * string, varchar and varbinary parameters are sized from each value, so
+     * nvarchar(7) and nvarchar(8) compile as different plans on the server.
+     * with buckets set a size is rounded up to the first bucket holding it,
+     * larger values keep their own size or bind as max. true applies
+     * [32, 128, 512, 4000], false or an empty array restores value sizing.
+     * @param buckets ascending sizes in characters (bytes for binary)
+     */
+    setParamSizeBuckets: (buckets: number[] | boolean) => void
+    getParamSizeBuckets: () => number[]
+    /**
+     * count of distinct sql text and parameter type / size combinations
+     * sent on this connection - a proxy for plans compiled by the server.
+     */
+    getParamSignatureCount: () => number
+    /**
+     * every query is sent with SQLExecDirect. with auto prepare on, sql text
+     * plus parameter signature seen threshold times is prepared once and then
+     * re-executed, least recently used statements are freed past capacity.
+     * results are read exactly as for a direct query. kept as shorthand for
+     * setStatementCache({ capacity, autoPrepareThreshold: threshold }).
+     * @param threshold executions before preparing, 0 disables
+     * @param capacity most prepared statements kept (default 64)
+     */
+    setAutoPrepare: (threshold: number, capacity?: number) => void
+    getAutoPrepare: () => { threshold: number, capacity: number }
+    /**
+     * statements prepared on this connection are kept once freed, a later
+     * prepare of the same sql re-uses the handle. least recently used idle
+     * statements are freed past capacity or maxBytes, a statement failing
+     * as its table or procedure changed is dropped rather than kept.
+     * @param opts capacity (default 64, 0 disables), maxBytes (default 16MB)
+     * and autoPrepareThreshold (see setAutoPrepare)
+     */
+    setStatementCache: (opts?: StatementCacheOptions) => void
+    getStatementCache: () => StatementCacheOptions
+    getStatementCacheStats: () => StatementCacheStats
+    /**
+     * statement handles of finished queries are reset and kept for the next
+     * query rather than freed, up to size idle handles.
+     * @param size idle handles kept (default 16), 0 frees each on release
+     */
+    setStatementPoolSize: (size: number) => void
+    getStatementPoolStats: () => StatementPoolStats
     /**
      * permanently closes connection and frees unmanaged native resources
      * related to connection ie. connection ODBC handle along with any
@@ -793,6 +1006,9 @@ declare namespace MsNodeSqlV8 {
     beginTransaction: (cb?: StatusCb) => void
     commit: (cb?: StatusCb) => void
     rollback: (cb?: StatusCb) => void
+    exportQuery: (sql: sqlQueryType, fd: number, options: ExportOptions | ExportCb, cb?: ExportCb) => void
+    transaction: (batch: TransactionStatement[], options: TransactionOptions | TransactionCb, cb?: TransactionCb) => void
+    batch: (batch: BatchStatement[], options: BatchOptions | BatchCb, cb?: BatchCb) => void
     /**
      *  note - can use promises.callProc, callProc or callprocAggregator directly.
      *  provides access to procedure manager where proc definitions can be manually
@@ -884,6 +1100,20 @@ declare namespace MsNodeSqlV8 {
      * @param qcb status callback indicating the cancel has been actioned.
      */
     cancelQuery: (qcb?: StatusCb) => void
+    /**
+     * stop reading the results part way. the rows and result sets not yet
+     * read are dropped by the native driver closing the cursor, rather than
+     * fetched or cancelled, and the statement is freed.
+     * @param qcb callback once the query is done.
+     */
+    abandonQuery: (qcb?: StatusCb) => void
+    /**
+     * the rows of each result as objects on a Readable, read from the driver
+     * only as fast as they are consumed. destroying the stream, as a break
+     * out of for await does, abandons the rest of the results.
+     * @param options - highWaterMark in rows, default 1024
+     */
+    toReadable: (options?: { highWaterMark?: number }) => NodeJS.ReadableStream & AsyncIterable<any>
     /**
      * temporarily suspend flow of data sent by native driver to be used
      * as flow control where for example expensive time consuming processing
@@ -929,6 +1159,20 @@ declare namespace MsNodeSqlV8 {
     query_timeout?: number
     query_polling?: boolean
     query_tz_adjustment?: number
+    /**
+     * rows returned along with the metadata of the first result, saving a
+     * fetch for small results. defaults to 50, 0 fetches separately.
+     */
+    first_batch_size?: number
+    /**
+     * read every result set natively before returning, for a caller that
+     * wants the whole result - see drain_max_bytes
+     */
+    drain?: boolean
+    /**
+     * with drain, stream the rest once the rows held pass this. default 16MB
+     */
+    drain_max_bytes?: number
     /**
      * constrain nvarchar(max) columns for prepared statements - i.e. will
      * set aefault 8k max size on nvarchar(max) columns. Note this
@@ -1058,8 +1302,94 @@ declare namespace MsNodeSqlV8 {
     delete: (rows: sqlBulkType) => Promise<void>
 
     update: (rows: sqlBulkType) => Promise<void>
+
+    /**
+     * merge rows on the where columns in one set based statement - matched rows
+     * are updated, the rest inserted. counts on each result hold rows affected.
+     * @param rows - array of objects keyed by column name.
+     */
+    upsert: (rows: sqlBulkType) => Promise<QueryAggregatorResults[]>
+
+    /**
+     * promise to insert rows pulled from an async iterable or Readable
+     * (object mode) in chunks of batchSize. the source is only read ahead
+     * by one chunk while the previous chunk is being sent, so memory is
+     * bounded regardless of the total row count.
+     * @param source - async iterable, iterable or Readable of row objects.
+     * @param options - batchSize, defaults to setBatchSize value or 5000,
+     * concurrency of chunks in flight, default 1.
+     */
+    insertStream: (source: BulkRowSource, options?: BulkStreamOptions) => Promise<BulkStreamSummary>
+
+    /**
+     * bulk copy a local delimited file into the table with native bcp, the
+     * file is read and split by the driver so no rows are created in js.
+     * fields are plain delimited text split on the terminators alone - rfc 4180
+     * quoted csv is not supported, so options.quoting must be set to 'none'.
+     * only available on a connection, not a pool.
+     * @param fileName - path to the file on the client.
+     * @param options - terminators, header row, column order etc.
+     */
+    insertFile: (fileName: string, options: BulkFileOptions) => Promise<BulkFileSummary>
+  }
+
+  export interface BulkFileOptions {
+    // required - fields are never quoted, bcp splits on the terminators alone
+    quoting: 'none'
+    // table column names in the order they appear in the file, default assignable columns
+    columns?: string[]
+    // default ','
+    fieldTerminator?: string
+    // default '\n'
+    rowTerminator?: string
+    // skip the first line
+    header?: boolean
+    firstRow?: number
+    lastRow?: number
+    // rows per server transaction, default the whole file
+    batchSize?: number
+    maxErrors?: number
+    // client side file for rows which fail conversion
+    errorFile?: string
+    // file code page, default 65001 (utf-8), 0 for the bcp default of the OEM code page
+    codePage?: number
+    // file is utf-16
+    unicode?: boolean
+    keepNulls?: boolean
+    tabLock?: boolean
+    hints?: string
   }
 
+  export interface BulkFileSummary {
+    rows: number
+  }
+
+  export type BulkRowSource = AsyncIterable<object> | Iterable<object>
+
+  export interface BulkStreamOptions {
+    batchSize?: number
+    // number of chunks in flight, on a pool spread over connections
+    concurrency?: number
+    useBcp?: boolean
+    // bcp server hints e.g. 'TABLOCK'
+    bcpHints?: string
+  }
+
+  export interface BulkLoadOptions extends BulkStreamOptions {
+    // shorthand for bcpHints: 'TABLOCK' - parallel heap load
+    tabLock?: boolean
+  }
+
+  export interface BulkStreamSummary {
+    rows: number
+    batches: number
+    errors: Error[]
+  }
+
+  export type BulkStreamCb = (err: Error, summary: BulkStreamSummary) => void
+
+  export type BulkFileCb = (err: Error, summary: BulkFileSummary) => void
+
   export interface BulkTableMgr {
     asTableType: (name?: string) => Table
     /**
@@ -1069,6 +1399,11 @@ declare namespace MsNodeSqlV8 {
      * @param name
      */
     asUserType: (name?: string) => string
+    /**
+     * SQL definition of the user table type used for set based update, delete and
+     * upsert - assignable columns plus the where columns.
+     */
+    asTvpUserType: () => string
     deleteRows: (rows: object[], cb: StatusCb) => void
     getAssignableColumns: () => TableColumn[]
 
@@ -1080,6 +1415,13 @@ declare namespace MsNodeSqlV8 {
      */
     getBcpVersion: () => number
 
+    /**
+     * bcp server hints sent with each insert when bcp is on e.g. 'TABLOCK'
+     */
+    getBcpHints: () => string
+
+    setBcpHints: (hints: string) => void
+
     getColumnsByName: () => TableColumn[]
 
     getDeleteSignature: () => string
@@ -1104,8 +1446,23 @@ declare namespace MsNodeSqlV8 {
 
     getWhereColumns: () => TableColumn[]
 
+    /**
+     * is set based update / delete via a table valued parameter on
+     */
+    getUseTvp: () => boolean
+
+    /**
+     * name of the user table type bound for set based operations,
+     * default schema.tableBulkType_hash where hash follows the columns
+     */
+    getTvpTypeName: () => string
+
     insertRows: (rows: object[], cb: StatusCb) => void
 
+    insertStream: (source: BulkRowSource, options: BulkStreamOptions | BulkStreamCb, cb?: BulkStreamCb) => void
+
+    insertFile: (fileName: string, options: BulkFileOptions, cb: BulkFileCb) => void
+
     /**
      * for a set of objects extract primary key fields only
      * @param vec - array of objects
@@ -1143,8 +1500,25 @@ declare namespace MsNodeSqlV8 {
 
     setWhereCols: (cols: object[]) => void
 
+    /**
+     * update and delete bind all rows of a batch as one table valued parameter
+     * joined on the where columns, rather than running the statement per row.
+     * the user table type is created on first use if it does not exist.
+     * upsert always runs this way, whatever this is set to.
+     * @param tvp - switch set based update / delete on/off
+     */
+    setUseTvp: (tvp: boolean) => void
+
+    /**
+     * use an existing user table type for set based operations, it must
+     * hold the columns described by asTvpUserType
+     */
+    setTvpTypeName: (name: string) => void
+
     updateRows: (rows: object[], cb: StatusCb) => void
 
+    upsertRows: (rows: object[], cb: StatusCb) => void
+
     useMetaType: (yn: boolean) => void
   }
 
@@ -1549,6 +1923,32 @@ declare namespace MsNodeSqlV8 {
      * @returns promise to await for query results
      */
     query: (params?: any[], options?: QueryAggregatorOptions) => Promise<QueryAggregatorResults>
+
+    /**
+     * execute the prepared query once per parameter set in one driver call
+     * @param paramSets one parameter array per execution
+     * @param options stopOnError and the row fetch batchSize
+     * @returns promise to await for the outcome of each set run
+     */
+    executeMany: (paramSets: any[][], options?: ExecuteManyOptions) => Promise<ExecuteManyResult[]>
+  }
+
+  export interface ExecuteManyOptions {
+    /**
+     * stop at the first set failing to bind or execute, later sets are not run.
+     */
+    stopOnError?: boolean
+    /**
+     * rows fetched per native read (default 5000)
+     */
+    batchSize?: number
+  }
+
+  export interface ExecuteManyResult {
+    executed: boolean
+    rowCount: number
+    rows: any[]
+    errors: Error[]
   }
 
   export interface PreparedStatement {
@@ -1564,6 +1964,15 @@ declare namespace MsNodeSqlV8 {
      */
     preparedQuery: (params?: any[], cb?: QueryCb) => Query
 
+    /**
+     * execute once per parameter set on the driver thread, a single callback
+     * receives the rowCount, rows and errors of each set run.
+     * @param paramSets one parameter array per execution
+     * @param options stopOnError and batchSize
+     * @param cb - called with the results of every set run
+     */
+    executeMany: (paramSets: any[][], options?: ExecuteManyOptions, cb?: (err: Error | null, results?: ExecuteManyResult[]) => void) => void
+
     /**
      * free the prepared statement
      * @param cb called when server frees the statement
@@ -1589,6 +1998,37 @@ declare namespace MsNodeSqlV8 {
     getMeta: () => Meta[]
   }
 
+  export interface StreamOptions {
+    /**
+     * varbinary (default) sends the chunks as they are, nvarchar reads
+     * strings or utf8 buffers and sends them as utf16.
+     */
+    type?: 'varbinary' | 'nvarchar'
+    /**
+     * size of the slices a Buffer source is sent in, default 64k.
+     */
+    chunkSize?: number
+  }
+
+  export interface TvpStreamOptions {
+    /**
+     * rows sent to the server per batch, the driver reserves column buffers
+     * for this many rows. default 1000.
+     */
+    batchSize?: number
+    /**
+     * characters reserved per row for a max column e.g. nvarchar(max), a
+     * longer value fails the query. default 4000.
+     */
+    maxColumnLength?: number
+  }
+
+  export interface StreamParam {
+    sql_type: number
+    data_at_exec: true
+    pull: (deliver: (err: Error | null, chunk: Buffer | null) => void) => void
+  }
+
   export interface ConcreteColumnType {
     /***
      * the ODBC type which will be used to bind parameter. If this is not
@@ -1651,13 +2091,17 @@ declare namespace MsNodeSqlV8 {
 
     Float: (v: number) => ConcreteColumnType
 
-    Numeric: (v: number) => ConcreteColumnType
+    /**
+     * a string or BigInt value is bound exactly rather than via a double,
+     * a BigInt being the value multiplied by 10^scale e.g. Numeric(12345n, 38, 2) is 123.45
+     */
+    Numeric: (v: number | string | bigint | (number | string | bigint | null)[], precision?: number, scale?: number) => ConcreteColumnType
 
-    Money: (v: number) => ConcreteColumnType
+    Money: (v: number | string) => ConcreteColumnType
 
-    SmallMoney: (v: number) => ConcreteColumnType
+    SmallMoney: (v: number | string) => ConcreteColumnType
 
-    Decimal: (v: number) => ConcreteColumnType
+    Decimal: (v: number | string | bigint | (number | string | bigint | null)[], precision?: number, scale?: number) => ConcreteColumnType
 
     Double: (v: number) => ConcreteColumnType
 
@@ -1734,6 +2178,7 @@ declare namespace MsNodeSqlV8 {
     query_polling?: boolean
     query_timeout?: number
     max_prepared_column_size?: number
+    first_batch_size?: number
   }
 
   export interface NativeCustomBinding {
@@ -1844,6 +2289,22 @@ declare namespace MsNodeSqlV8 {
     logFile: string | null
   }
 
+  export interface HandleDiagnosticsOptions {
+    enabled?: boolean
+    sampleEvery?: number
+    capacity?: number
+  }
+
+  export interface HandleEvent {
+    sequence: number
+    kind: 'alloc' | 'free' | 'detach' | 'adopt' | 'double-free'
+    name: string
+    handle: string
+    timestamp: number
+    thread: string
+    stack: string
+  }
+
   export interface Logger {
     /**
      * Initialize the logger with the native module
@@ -1869,6 +2330,18 @@ declare namespace MsNodeSqlV8 {
      */
     setLogFile: (filePath: string | null) => void
 
+    /**
+     * Record the alloc and free history of native ODBC handles, off by default.
+     * 1 in sampleEvery handles is followed with a stack trace into a ring of the
+     * last capacity events, which is logged with any double free detected.
+     */
+    setHandleDiagnostics: (options?: HandleDiagnosticsOptions) => void
+
+    /**
+     * The recorded handle events, oldest first
+     */
+    getHandleEvents: () => HandleEvent[]
+
     /**
      * Check if a log level is enabled
      * @param level
@@ -2029,6 +2502,39 @@ declare namespace MsNodeSqlV8 {
      * @returns the Table Value Parameter instance ready for use in query
      */
     TvpFromTable: (table: Table) => TvpParam
+    /**
+     * construct a tvp parameter whose rows are read from the source in
+     * batches while the query executes, so a very large table is never
+     * held in memory at once. rows are arrays in column order or objects
+     * keyed by column name. the source is consumed once.
+     * @param table the table type e.g. from getUserTypeTable
+     * @param source async iterable or iterable of rows
+     * @param options batch size and max column length
+     * @returns the Table Value Parameter instance ready for use in query
+     */
+    TvpStream: (table: Table, source: AsyncIterable<any[] | object> | Iterable<any[] | object>, options?: TvpStreamOptions) => TvpParam
+    /**
+     * a varbinary(max) or nvarchar(max) parameter read from the source in
+     * chunks while the query executes, so the whole value is never held
+     * in memory. the source is consumed once, e.g. a file read stream.
+     * @param source Readable, async iterable, iterable, Buffer or string
+     * @param options target type and chunk size
+     * @returns the parameter ready for use in a query
+     */
+    Stream: (source: NodeJS.ReadableStream | AsyncIterable<Buffer | string> | Iterable<Buffer | string> | Buffer | string, options?: StreamOptions) => StreamParam
+    /**
+     * set the most threads running driver calls at once. queries run on their own
+     * pool rather than the libuv one, with work for one connection in submit order.
+     * defaults to 32, or MSNODESQLV8_EXECUTOR_THREADS if set.
+     * @param count thread limit, at least 1
+     * @returns the limit now in force
+     */
+    setExecutorThreads: (count: number) => number
+    /**
+     * threads started and running driver calls now, and polled queries
+     * waiting on the driver without holding a thread.
+     */
+    getExecutorStats: () => ExecutorStats
     /**
      * Logger instance for configuring JavaScript and C++ logging
      */
@@ -2070,6 +2576,15 @@ declare module 'msnodesqlv8/types' {
   export import TableColumn = MsNodeSqlV8.TableColumn
   export import ConnectionPromises = MsNodeSqlV8.ConnectionPromises
   export import Connection = MsNodeSqlV8.Connection
+  export import ExportOptions = MsNodeSqlV8.ExportOptions
+  export import ExportSummary = MsNodeSqlV8.ExportSummary
+  export import ExportCb = MsNodeSqlV8.ExportCb
+  export import TransactionStatement = MsNodeSqlV8.TransactionStatement
+  export import TransactionOptions = MsNodeSqlV8.TransactionOptions
+  export import TransactionResults = MsNodeSqlV8.TransactionResults
+  export import BatchStatement = MsNodeSqlV8.BatchStatement
+  export import BatchOptions = MsNodeSqlV8.BatchOptions
+  export import BatchResult = MsNodeSqlV8.BatchResult
   export import QueryPromises = MsNodeSqlV8.QueryPromises
   export import Query = MsNodeSqlV8.Query
 
@@ -2107,6 +2622,14 @@ declare module 'msnodesqlv8/types' {
   export import BulkMgrSummary = MsNodeSqlV8.BulkMgrSummary
   export import BulkTableMgrPromises = MsNodeSqlV8.BulkTableMgrPromises
   export import BulkTableMgr = MsNodeSqlV8.BulkTableMgr
+  export import BulkRowSource = MsNodeSqlV8.BulkRowSource
+  export import BulkStreamOptions = MsNodeSqlV8.BulkStreamOptions
+  export import BulkLoadOptions = MsNodeSqlV8.BulkLoadOptions
+  export import BulkStreamSummary = MsNodeSqlV8.BulkStreamSummary
+  export import BulkStreamCb = MsNodeSqlV8.BulkStreamCb
+  export import BulkFileOptions = MsNodeSqlV8.BulkFileOptions
+  export import BulkFileSummary = MsNodeSqlV8.BulkFileSummary
+  export import BulkFileCb = MsNodeSqlV8.BulkFileCb
   export import TableValueColumn = MsNodeSqlV8.TableValueColumn
   export import ProcedureParam = MsNodeSqlV8.ProcedureParam
   export import TvpParam = MsNodeSqlV8.TvpParam
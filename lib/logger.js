@@ -116,6 +116,27 @@ class Logger {
     }
   }
 
+  /**
+   * Record the alloc and free history of native ODBC handles, off by default.
+   * 1 in sampleEvery handles is followed with a stack trace into a ring of the
+   * last capacity events, which is logged with any double free detected.
+   * @param {{ enabled?: boolean, sampleEvery?: number, capacity?: number }} [options]
+   */
+  setHandleDiagnostics (options = {}) {
+    const { enabled = true, sampleEvery = 1, capacity = 256 } = options
+    if (this.nativeModule?.setHandleDiagnostics) {
+      this.nativeModule.setHandleDiagnostics(!!enabled, sampleEvery, capacity)
+    }
+  }
+
+  /**
+   * The recorded handle events, oldest first
+   * @returns {Array<{ sequence: number, kind: string, name: string, handle: string, timestamp: number, thread: string, stack: string }>}
+   */
+  getHandleEvents () {
+    return this.nativeModule?.getHandleEvents ? this.nativeModule.getHandleEvents() : []
+  }
+
   /**
    * Sync current configuration with native module
    */
@@ -6,7 +6,7 @@
 const { logger } = require('./logger')
 
 const notifyModule = ((() => {
-  const { EventEmitter } = require('stream')
+  const { EventEmitter, Readable } = require('stream')
   class QueryObject {
     constructor (p, to, po) {
       this.query_str = p
@@ -31,6 +31,56 @@ const notifyModule = ((() => {
     }
   }
 
+  // rows of each result of a query as objects, read only as fast as they are
+  // consumed. destroying the stream, e.g. a break out of for await, abandons
+  // the rest. q is a query, or a pool's stand in for one.
+  function rowReadable (q, options) {
+    options = options || {}
+    let names = []
+    let row = null
+    let finished = false
+    const readable = new Readable({
+      objectMode: true,
+      highWaterMark: options.highWaterMark || 1024,
+      read: () => {
+        if (q.isPaused()) {
+          q.resumeQuery()
+        }
+      },
+      destroy: (err, cb) => {
+        if (finished) {
+          cb(err)
+          return
+        }
+        finished = true
+        q.abandonQuery(() => cb(err))
+      }
+    })
+    q.on('meta', meta => {
+      names = meta.map((m, i) => m.name || `Column${i}`)
+    })
+    q.on('row', () => {
+      row = {}
+    })
+    q.on('column', (index, value) => {
+      row[names[index]] = value
+      if (index === names.length - 1 && !readable.push(row)) {
+        q.pauseQuery()
+      }
+    })
+    // an error may leave results to come, destroy abandons them
+    q.on('error', err => {
+      readable.destroy(err)
+    })
+    q.on('done', () => {
+      if (!finished) {
+        finished = true
+        readable.push(null)
+      }
+    })
+    return readable
+  }
+
   class StreamEventsPromises {
     constructor (se) {
       this.se = se
@@ -80,8 +130,12 @@ const notifyModule = ((() => {
       this.queryWorker = null
       this.operation = null
       this.paused = null
+      this.abandoned = false
       this.canelSent = false
       this.prepared = null
+      this.released = false
+      this.unbound = null
+      this.drainMaxBytes = 0
       this.handle = null
       this.cancelToken = null
       this.promises = new StreamEventsPromises(this)
@@ -102,6 +156,33 @@ const notifyModule = ((() => {
       return this.prepared
     }
 
+    // the statement was freed natively along with the last rows read
+    setReleased () {
+      this.released = true
+    }
+
+    isReleased () {
+      return this.released
+    }
+
+    // output parameters read natively once the results ran out
+    setUnbound (output) {
+      this.unbound = output
+    }
+
+    getUnbound () {
+      return this.unbound
+    }
+
+    // read every result natively before returning, up to maxBytes of rows
+    setDrain (maxBytes) {
+      this.drainMaxBytes = maxBytes
+    }
+
+    getDrain () {
+      return this.drainMaxBytes
+    }
+
     getLastStateChange () {
       return this.lastStateChange
     }
@@ -151,7 +232,10 @@ const notifyModule = ((() => {
 
     setQueryWorker (qw) {
       this.queryWorker = qw
-      if (this.paused) {
+      if (this.abandoned) {
+        logger.debugLazy(() => `${this.queryId} abandoned before it started.`)
+        this.queryWorker.abandon()
+      } else if (this.paused) {
         logger.debugLazy(() => `${this.queryId} pausing the query worker.`)
         this.queryWorker.pause()
       }
@@ -181,6 +265,32 @@ const notifyModule = ((() => {
       }
     }
 
+    // stop reading the results part way. what is left is dropped natively by
+    // closing the cursor, with no further fetch or a cancel, and the statement
+    // is freed. cb once the query is done.
+    abandonQuery (cb) {
+      if (this.abandoned) {
+        if (cb) setImmediate(() => cb(null))
+        return
+      }
+      this.abandoned = true
+      if (!this.queryWorker) {
+        // still queued, the query ends as it starts
+        if (cb) this.once('done', () => cb(null))
+        return
+      }
+      if (this.queryWorker.abandon()) {
+        if (cb) this.once('done', () => cb(null))
+      } else if (cb) {
+        setImmediate(() => cb(null))
+      }
+    }
+
+    // rows of each result as objects, see rowReadable
+    toReadable (options) {
+      return rowReadable(this, options)
+    }
+
     pauseQuery () {
       this.paused = true
       if (this.queryWorker) {
@@ -304,7 +414,8 @@ const notifyModule = ((() => {
   return {
     NotifyFactory,
     StreamEvents,
-    LexicalParam
+    LexicalParam,
+    rowReadable
   }
 })())
 
@@ -0,0 +1,110 @@
+'use strict'
+
+// user typed parameters e.g. sql.Int(5) or sql.NVarChar('a', 20) are objects
+// the native binder reads property by property. packParams moves their type,
+// precision and scale into one Int32Array attached to the parameter array as
+// "descriptors", leaving only the raw value in each slot. the layout must
+// match PackedDescriptor in cpp/include/core/bound_datum.h
+
+const KIND = 0
+const SQL_TYPE = 1
+const PRECISION = 2
+const SCALE = 3
+const MAX_LENGTH = 4
+const OFFSET = 5
+const FLAGS = 6
+const STRIDE = 7
+
+const KIND_TYPED = 1
+
+const HAS_PRECISION = 1
+const HAS_SCALE = 2
+const HAS_MAX_LENGTH = 4
+const HAS_OFFSET = 8
+const MONEY = 16
+
+const SQL_SS_TABLE = -153
+
+const SQL_TYPE_DATE = 91
+const SQL_TYPE_TIMESTAMP = 93
+const SQL_SS_TIME2 = -154
+const SQL_SS_TIMESTAMPOFFSET = -155
+
+const DATE_TYPES = new Set([SQL_TYPE_DATE, SQL_TYPE_TIMESTAMP, SQL_SS_TIME2, SQL_SS_TIMESTAMPOFFSET])
+
+function isNumber (v) {
+  return typeof v === 'number' && Number.isFinite(v)
+}
+
+// bcp, tvp, streamed and procedure parameters carry more than a type and keep
+// the object form, as does any value the binder would need to inspect.
+
+function isPackable (p) {
+  if (p === null || typeof p !== 'object' || Array.isArray(p) || Buffer.isBuffer(p) || p instanceof Date) {
+    return false
+  }
+  if (!isNumber(p.sql_type) || p.sql_type === 0 || p.sql_type === SQL_SS_TABLE) {
+    return false
+  }
+  return !p.bcp && !p.is_user_defined && !p.data_at_exec && p.is_output === undefined
+}
+
+function describe (descriptors, i, p) {
+  const base = i * STRIDE
+  let flags = 0
+  descriptors[base + KIND] = KIND_TYPED
+  descriptors[base + SQL_TYPE] = p.sql_type
+  if (isNumber(p.precision)) {
+    descriptors[base + PRECISION] = p.precision
+    flags |= HAS_PRECISION
+  }
+  if (isNumber(p.scale)) {
+    descriptors[base + SCALE] = p.scale
+    flags |= HAS_SCALE
+  }
+  if (isNumber(p.max_length)) {
+    descriptors[base + MAX_LENGTH] = p.max_length
+    flags |= HAS_MAX_LENGTH
+  }
+  if (isNumber(p.offset)) {
+    descriptors[base + OFFSET] = p.offset
+    flags |= HAS_OFFSET
+  }
+  if (p.money) {
+    flags |= MONEY
+  }
+  descriptors[base + FLAGS] = flags
+}
+
+// a column of dates goes to the binder as epoch milliseconds, NaN for null,
+// which it converts in one pass without touching each Date object.
+
+function toEpochColumn (p) {
+  if (!DATE_TYPES.has(p.sql_type) || !Array.isArray(p.value)) {
+    return p.value
+  }
+  const column = new Float64Array(p.value.length)
+  for (let i = 0; i < column.length; ++i) {
+    const v = p.value[i]
+    column[i] = v == null ? NaN : +v
+  }
+  return column
+}
+
+function packParams (params) {
+  if (!Array.isArray(params) || params.descriptors || !params.some(isPackable)) {
+    return params
+  }
+  const descriptors = new Int32Array(params.length * STRIDE)
+  const values = params.map((p, i) => {
+    if (!isPackable(p)) {
+      return p
+    }
+    describe(descriptors, i, p)
+    return toEpochColumn(p)
+  })
+  values.descriptors = descriptors
+  return values
+}
+
+exports.packParams = packParams
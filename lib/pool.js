@@ -7,6 +7,7 @@ const poolModule = (() => {
   const { driverModule } = require('./driver')
   const sqlClientModule = require('./sql-client').sqlCLientModule
   const { notifyModule } = require('./notifier')
+  const { rowReadable } = notifyModule
   const { utilModule } = require('./util')
   const { tableModule } = require('./table')
   const userModule = require('./user').userModule
@@ -92,6 +93,7 @@ const poolModule = (() => {
       this.queryObj = null
       this.paused = false
       this.pendingCancel = false
+      this.drainMaxBytes = 0
     }
 
     isPaused () {
@@ -123,6 +125,23 @@ const poolModule = (() => {
       }
     }
 
+    // not yet run, the query is dropped as for a cancel
+    abandonQuery (cb) {
+      if (this.queryObj) {
+        this.queryObj.abandonQuery(cb)
+      } else {
+        this.pendingCancel = true
+        this.paused = false
+        if (cb) {
+          this.once('done', () => cb(null))
+        }
+      }
+    }
+
+    toReadable (options) {
+      return rowReadable(this, options)
+    }
+
     pauseQuery () {
       this.paused = true
       if (this.queryObj) {
@@ -137,8 +156,19 @@ const poolModule = (() => {
       }
     }
 
+    // passed on to the query once a pooled connection runs it
+    setDrain (maxBytes) {
+      this.drainMaxBytes = maxBytes
+      if (this.queryObj) {
+        this.queryObj.setDrain(maxBytes)
+      }
+    }
+
     setQueryObj (q, chunky) {
       this.queryObj = q
+      if (this.drainMaxBytes > 0) {
+        q.setDrain(this.drainMaxBytes)
+      }
       q.on('submitted', (d) => {
         this.emit('submitted', d)
       })
@@ -193,6 +223,11 @@ const poolModule = (() => {
       this.useNumericString = this.getOpt(opt, 'useNumericString', null)
       this.useBigIntAsNative = this.getOpt(opt, 'useBigIntAsNative', null)
       this.maxPreparedColumnSize = this.getOpt(opt, 'maxPreparedColumnSize', null)
+      this.paramSizeBuckets = this.getOpt(opt, 'paramSizeBuckets', null)
+      this.autoPrepareThreshold = this.getOpt(opt, 'autoPrepareThreshold', 0)
+      this.autoPrepareCapacity = this.getOpt(opt, 'autoPrepareCapacity', 64)
+      this.statementCache = this.getOpt(opt, 'statementCache', null)
+      this.statementPoolSize = this.getOpt(opt, 'statementPoolSize', null)
       this.floor = Math.min(this.floor, this.ceiling)
       this.inactivityTimeoutSecs = Math.max(this.inactivityTimeoutSecs, this.heartbeatSecs)
 
@@ -227,6 +262,7 @@ const poolModule = (() => {
       this.getUserTypeTable = pool.getUserTypeTable
       this.getTable = pool.getTable
       this.getProc = pool.getProc
+      this.bulkLoad = pool.bulkLoad
       this.beginTransaction = util.promisify(pool.beginTransaction)
       this.commitTransaction = util.promisify(pool.commitTransaction)
       this.rollbackTransaction = util.promisify(pool.rollbackTransaction)
@@ -635,6 +671,23 @@ const poolModule = (() => {
         return checkClosedPromise().then(async () => procedureManager.promises.getProc(name))
       }
 
+      // partition the source into chunks inserted concurrently over up to
+      // concurrency pooled connections, by default with bcp. tabLock requests
+      // a bulk update lock which lets parallel bcp sessions load a heap together.
+      async function bulkLoad (name, source, loadOptions) {
+        return checkClosedPromise().then(async () => {
+          loadOptions = loadOptions || {}
+          const table = await tableMgr.promises.getTable(name)
+          const hints = loadOptions.tabLock ? 'TABLOCK' : loadOptions.bcpHints
+          return table.promises.insertStream(source, {
+            batchSize: loadOptions.batchSize,
+            concurrency: loadOptions.concurrency || options.ceiling,
+            useBcp: loadOptions.useBcp === undefined ? true : loadOptions.useBcp,
+            bcpHints: hints
+          })
+        })
+      }
+
       // returns a promise of aggregated results not a query
       async function callprocAggregator (name, params, options) {
         return checkClosedPromise().then(async () => aggregator.callProc(name, params, options))
@@ -734,6 +787,18 @@ const poolModule = (() => {
           if (options.maxPreparedColumnSize) {
             c.setMaxPreparedColumnSize(options.maxPreparedColumnSize)
           }
+          if (options.paramSizeBuckets) {
+            c.setParamSizeBuckets(options.paramSizeBuckets)
+          }
+          if (options.statementCache) {
+            c.setStatementCache(Object.assign({ autoPrepareThreshold: options.autoPrepareThreshold },
+              options.statementCache))
+          } else if (options.autoPrepareThreshold > 0) {
+            c.setAutoPrepare(options.autoPrepareThreshold, options.autoPrepareCapacity)
+          }
+          if (Number.isInteger(options.statementPoolSize)) {
+            c.setStatementPoolSize(options.statementPoolSize)
+          }
           if (options.useUTC === true || options.useUTC === false) {
             c.setUseUTC(options.useUTC)
           }
@@ -1025,6 +1090,7 @@ const poolModule = (() => {
       this.getUserTypeTable = getUserTypeTable
       this.getTable = getTable
       this.getProc = getProc
+      this.bulkLoad = bulkLoad
       this.queryAggregator = queryAggregator
       this.promises = new PoolPromises(this)
       this.getUseUTC = getUseUTC
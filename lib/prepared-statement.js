@@ -7,6 +7,10 @@ class PreparedStatementPromises extends BasePromises {
     return this.aggregator.queryPrepared(q, options)
   }
 
+  async executeMany (paramSets, options) {
+    return this.op(cb => this.prepared.executeMany(paramSets, options, cb))
+  }
+
   async free () {
     return this.op(cb => this.prepared.free(cb))
   }
@@ -77,6 +81,41 @@ class PreparedStatement {
     return this.notify
   }
 
+  // run the statement once per parameter set in a single trip to the driver,
+  // each set reports its own rowCount, rows and errors.
+
+  executeMany (paramSets, options, callback) {
+    if (typeof options === 'function') {
+      callback = options
+      options = {}
+    }
+    options = options || {}
+    if (!this.active) {
+      callback(new Error('[msnodesql] prepared statement has been freed.'))
+      return
+    }
+    if (!Array.isArray(paramSets)) {
+      callback(new Error('[msnodesql] executeMany expects an array of parameter arrays.'))
+      return
+    }
+    const nativeOptions = {
+      stop_on_error: options.stopOnError === true,
+      batch_size: options.batchSize || 5000
+    }
+    this.driverMgr.executeMany(this.notify, paramSets, nativeOptions, (err, results) => {
+      if (err) {
+        callback(err)
+        return
+      }
+      callback(null, results.map(r => ({
+        executed: r.executed,
+        rowCount: r.rowCount,
+        rows: this.driverMgr.objectify({ meta: this.meta, rows: r.rows }),
+        errors: r.errors
+      })))
+    })
+  }
+
   free (callback) {
     this.driverMgr.freeStatement(this.notify, err => {
       this.active = false
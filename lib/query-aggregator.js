@@ -1,4 +1,5 @@
 const { logger } = require('./logger')
+const { defaultDrainMaxBytes } = require('./reader')
 
 class AggregatorResults {
   constructor (options) {
@@ -128,6 +129,9 @@ class AggregatorOptions {
     this.timeoutMs = this.getOpt(options, 'timeoutMs', 0)
     this.raw = this.getOpt(options, 'raw', false)
     this.replaceEmptyColumnNames = this.getOpt(options, 'replaceEmptyColumnNames', false)
+    // the whole result is wanted, so read it natively in one trip up to this
+    // much, 0 to stream it batch by batch
+    this.drainMaxBytes = this.getOpt(options, 'drainMaxBytes', defaultDrainMaxBytes)
   }
 
   getOpt (src, p, def) {
@@ -162,6 +166,9 @@ class QueryAggregator {
 
       const options = new AggregatorOptions(opt)
       const ret = this.emptyResults(options)
+      if (options.drainMaxBytes > 0) {
+        q.setDrain(options.drainMaxBytes)
+      }
 
       if (options.timeoutMs) {
         handle = this.timeOut(q, options.timeoutMs, (e) => {
@@ -1,19 +1,34 @@
 'use strict'
 
 const { logger } = require('./logger')
+const { packParams } = require('./param-descriptor')
 
 class QueryHandler {
   constructor (cppDriver) {
     this.cppDriver = cppDriver
   }
 
-  begin (queryId, query, params, callback) { }
+  // readAhead - first_batch_size and read_ahead_bytes, see Query.readAheadOptions
+  begin (queryId, query, params, callback, readAhead) { }
   end (queryId, outputParams, callback, results, more) { }
+  // the reader stopped part way, drop the rest of the results
+  abandon (not, callback) { }
+
+  // true if the statement is freed once its results are read, so the reader
+  // may release it natively in the same trip as the last fetch
+  releasesOnEnd () {
+    return false
+  }
 }
 
 class NativePreparedQueryHandler extends QueryHandler {
+  constructor (cppDriver, driverMgr) {
+    super(cppDriver)
+    this.driverMgr = driverMgr
+  }
+
   begin (queryId, query, params, callback) {
-    this.cppDriver.bindQuery(queryId, params, (err, meta) => {
+    this.cppDriver.bindQuery(queryId, packParams(params), (err, meta) => {
       if (callback) {
         callback(err, meta)
       }
@@ -25,6 +40,11 @@ class NativePreparedQueryHandler extends QueryHandler {
       callback(null, results, more, outputParams)
     }
   }
+
+  // the cursor is closed, the statement stays prepared
+  abandon (not, callback) {
+    this.driverMgr.abandonStatement(not, false, callback)
+  }
 }
 
 class NativeQueryHandler extends QueryHandler {
@@ -33,8 +53,10 @@ class NativeQueryHandler extends QueryHandler {
     this.onStatementCompleteHandler = onStatementComplete
   }
 
-  begin (queryId, query, params, callback) {
-    this.cppDriver.query(queryId, query, params, (err, results, more) => {
+  // a result read to its end by then frees its statement in the same trip
+  begin (queryId, query, params, callback, readAhead) {
+    const nativeQuery = Object.assign({}, query, readAhead, { release_on_end: true })
+    this.cppDriver.query(queryId, nativeQuery, packParams(params), (err, results, more) => {
       if (callback) {
         callback(err, results, more)
       }
@@ -44,6 +66,14 @@ class NativeQueryHandler extends QueryHandler {
   end (not, outputParams, callback, results, endMore) {
     this.onStatementCompleteHandler.onStatementComplete(not, outputParams, callback, results, endMore)
   }
+
+  abandon (not, callback) {
+    this.onStatementCompleteHandler.abandonStatement(not, true, callback)
+  }
+
+  releasesOnEnd () {
+    return true
+  }
 }
 
 class NativeProcedureQueryHandler extends QueryHandler {
@@ -54,8 +84,13 @@ class NativeProcedureQueryHandler extends QueryHandler {
     this.unbindEnum = unbindEnum
   }
 
-  begin (queryId, procedure, params, callback) {
-    this.cppDriver.callProcedure(queryId, procedure, params, (err, results, params) => {
+  // output parameters are unbound before the statement is freed
+  begin (queryId, procedure, params, callback, readAhead) {
+    const nativeProcedure = Object.assign({}, procedure, readAhead, {
+      unbind_on_end: true,
+      release_on_end: true
+    })
+    this.cppDriver.callProcedure(queryId, nativeProcedure, params, (err, results, params) => {
       if (callback) {
         callback(err, results, params)
       }
@@ -86,7 +121,7 @@ class NativeProcedureQueryHandler extends QueryHandler {
       return
     }
 
-    this.cppDriver.unbind(qid, (err, outputVector) => {
+    const onUnbind = (err, outputVector) => {
       if (err && callback) {
         callback(err, results)
       }
@@ -95,7 +130,14 @@ class NativeProcedureQueryHandler extends QueryHandler {
       if (!more) {
         this.workQueue.nextOp()
       }
-    })
+    }
+
+    const unbound = not.getUnbound()
+    if (unbound) {
+      onUnbind(null, unbound)
+      return
+    }
+    this.cppDriver.unbind(qid, onUnbind)
   }
 
   end (not, outputParams, callback, results, endMore) {
@@ -107,6 +149,11 @@ class NativeProcedureQueryHandler extends QueryHandler {
       this.onStatementCompleteHandler.onStatementComplete(not, null, callback, results, endMore)
     }
   }
+
+  // output parameters follow the last result, so are dropped along with it
+  abandon (not, callback) {
+    this.onStatementCompleteHandler.abandonStatement(not, true, callback)
+  }
 }
 
 exports.NativePreparedQueryHandler = NativePreparedQueryHandler
@@ -9,6 +9,11 @@
 const { BasePromises } = require('./base-promises')
 const { logger } = require('./logger')
 
+// rows held natively before a drained query falls back to streaming
+const defaultDrainMaxBytes = 16 * 1024 * 1024
+// rows per fetch when draining, each is one batch replayed to dispatch
+const drainBatchSize = 1000
+
 class DriverRead {
   constructor (cppDriver, queue, version) {
     this.native = cppDriver
@@ -50,6 +55,7 @@ class Query extends BasePromises {
     this.queryRowIndex = 0
     this.batchRowIndex = 0
     this.batchData = null
+    this.readAhead = []
     this.running = true
     this.paused = false
     this.done = false
@@ -57,6 +63,9 @@ class Query extends BasePromises {
     this.rowBatchSize = 50 /* ignored for prepared statements */
     this.currentQueryResult = null
     this.cancelled = false
+    this.abandoned = false
+    this.started = false
+    this.nativeInFlight = false
     this.timeoutTriggered = false
     this.context = ''
 
@@ -110,6 +119,36 @@ class Query extends BasePromises {
     }, cb))
   }
 
+  // fetch, and once the rows run out move to the next result and free the
+  // statement, in one native call. steps stop where js has work to do.
+  pipelineSteps () {
+    const steps = ['fetchRows', 'nextResultSet']
+    if (this.queryHandler.releasesOnEnd()) {
+      steps.push('release')
+    }
+    return steps
+  }
+
+  async nativePipeline (rowBatchSize) {
+    logger.debugLazy(() => `queue op to native::pipeline ${this.queryId}`, this.context)
+    return this.op(cb => this.native.pipeline(this.queryId, this.notify.getHandle(), {
+      asArrays: true,
+      batchSize: rowBatchSize,
+      asObjects: false
+    }, this.pipelineSteps(), cb))
+  }
+
+  async nativeFetch (rowBatchSize) {
+    const ahead = this.takeReadAhead('fetchRows')
+    if (ahead) {
+      return this.replay(ahead.errors, [ahead])
+    }
+    if (typeof this.native.pipeline !== 'function') {
+      return this.nativeGetRows(this.queryId, rowBatchSize).then(d => [d])
+    }
+    return this.nativePipeline(rowBatchSize)
+  }
+
   close () {
     if (!this.running) return // Already closed
     this.running = false
@@ -149,18 +188,30 @@ class Query extends BasePromises {
     return []
   }
 
+  // may contain info messages e.g. raised by PRINT statements - do not want to reject these
+  acceptNextResult (e) {
+    this.infoFromNextResult = false
+    const errorMessages = e ? this.dispatchInfoReturnErrors(e) : []
+    if (errorMessages.length === 0) {
+      this.infoFromNextResult = e != null && Array.isArray(e) && e.length > 0
+    }
+    return errorMessages
+  }
+
   async nativeNextResult (queryId) {
+    const ahead = this.takeReadAhead('nextResultSet')
+    if (ahead) {
+      return this.readNextResult(ahead)
+    }
     return new Promise((resolve, reject) => {
       this.infoFromNextResult = false
       logger.debugLazy(() => `native::nextResultSet ${this.queryId}`, this.context)
       this.native.nextResultSet(this.queryId, this.notify.getHandle(), (e, res) => {
         setImmediate(() => {
-          // may contain info messages e.g. raised by PRINT statements - do not want to reject these
-          const errorMessages = e ? this.dispatchInfoReturnErrors(e) : []
+          const errorMessages = this.acceptNextResult(e)
           if (errorMessages.length > 0) {
             reject(errorMessages)
           } else {
-            this.infoFromNextResult = e != null && Array.isArray(e) && e.length > 0
             resolve(res)
           }
         })
@@ -168,9 +219,93 @@ class Query extends BasePromises {
     })
   }
 
+  // a next result already read natively, as if from nativeNextResult
+  async readNextResult (next) {
+    return new Promise((resolve, reject) => {
+      setImmediate(() => {
+        const errorMessages = this.acceptNextResult(next.errors && next.errors.length > 0 ? next.errors : null)
+        if (errorMessages.length > 0) {
+          reject(errorMessages)
+        } else {
+          resolve(next)
+        }
+      })
+    })
+  }
+
+  pipelinedNextResult (next) {
+    this.inFlight(this.readNextResult(next)).then(nextResultSetInfo => {
+      this.acceptNextResultSet(nextResultSetInfo)
+    }).catch(err => {
+      this.rejectNextResultSet(err)
+    })
+  }
+
+  // rows read along with the metadata: the first batch, or for a caller
+  // wanting the whole result every result set up to a cap on the rows held
+  readAheadOptions () {
+    const query = this.query
+    let drainMaxBytes = this.notify.getDrain ? this.notify.getDrain() : 0
+    if (query.drain) {
+      drainMaxBytes = query.drain_max_bytes || defaultDrainMaxBytes
+    }
+    const defaultSize = drainMaxBytes > 0 ? drainBatchSize : this.rowBatchSize
+    return {
+      first_batch_size: Object.hasOwnProperty.call(query, 'first_batch_size')
+        ? query.first_batch_size
+        : defaultSize,
+      read_ahead_bytes: drainMaxBytes
+    }
+  }
+
+  // steps the native query ran on past the execute. fetches and next results
+  // are replayed in place of the native calls, a release or unbind is noted
+  // for when the statement is freed.
+  acceptReadAhead (steps) {
+    this.readAhead = []
+    if (!steps) return
+    steps.forEach(s => {
+      switch (s.step) {
+        case 'release':
+          if (s.released) {
+            this.notify.setReleased()
+          }
+          break
+        case 'unbind':
+          this.notify.setUnbound(s.output)
+          break
+        default:
+          this.readAhead.push(s)
+          break
+      }
+    })
+    logger.debugLazy(() => `read ahead ${this.readAhead.length} steps for queryId ${this.queryId}, released=${this.notify.isReleased()}`, this.context)
+  }
+
+  takeReadAhead (step) {
+    const head = this.readAhead[0]
+    if (!head || head.step !== step) {
+      return null
+    }
+    return this.readAhead.shift()
+  }
+
+  async replay (errors, v) {
+    return new Promise((resolve, reject) => {
+      setImmediate(() => {
+        if (errors && errors.length > 0) {
+          reject(errors)
+        } else {
+          resolve(v)
+        }
+      })
+    })
+  }
+
   async beginQuery (queryId) {
     return new Promise((resolve, reject) => {
       logger.debugLazy(() => `call query handler begin ${this.queryId}`, this.context)
+      const readAhead = this.readAheadOptions()
       this.queryHandler.begin(queryId, this.query, this.params, (e, queryResult, procOutputOrMore) => {
         if (queryResult) {
           this.notify.setHandle(queryResult.handle)
@@ -209,7 +344,7 @@ class Query extends BasePromises {
             })
           }
         })
-      })
+      }, readAhead)
     })
   }
 
@@ -251,7 +386,7 @@ class Query extends BasePromises {
     const numberRows = resultRows.length
     logger.traceLazy(() => `[${JSON.stringify(this.notify.getHandle())}] dispatchRows processing ${numberRows} rows for queryId ${this.queryId}, batchRowIndex=${this.batchRowIndex}`, this.context)
 
-    while (!this.paused && this.batchRowIndex < numberRows) {
+    while (!this.paused && !this.abandoned && this.batchRowIndex < numberRows) {
       const driverRow = resultRows[this.batchRowIndex]
       this.notify.emit('row', this.queryRowIndex)
       const currentRow = this.getRow()
@@ -312,6 +447,9 @@ class Query extends BasePromises {
 
   moveToNextResult (nextResultSetInfo) {
     setImmediate(() => {
+      if (this.abandoned) {
+        return
+      }
       if (this.cancelled) {
         this.running = false
         logger.debugLazy(() => `[${this.notify.getHandle()}] query ${this.queryId} has been cancelled - ending query ${this.queryId} `, this.context)
@@ -373,38 +511,132 @@ class Query extends BasePromises {
     }
 
     logger.traceLazy(() => `dispatch fetching rows for queryId ${this.queryId}, rowBatchSize=${this.rowBatchSize}`, this.context)
-    this.nativeGetRows(this.queryId, this.rowBatchSize).then(d => {
-      logger.traceLazy(() => `dispatch received ${d?.data?.length || 0} rows for queryId ${this.queryId}, endOfRows=${d?.endOfRows} endOfResults=${d?.endOfResults}`, this.context)
-      this.batchRowIndex = 0
-      this.batchData = d
-      this.dispatchRows(d)
-      if (!d.endOfRows) {
-        this.dispatch()
-      } else if (!d.endOfResults) {
-        this.nextResult()
-      } else {
-        d.meta = []
-        this.moveToNextResult(d)
+    this.inFlight(this.nativeFetch(this.rowBatchSize)).then(steps => {
+      if (steps.some(s => s.step === 'release' && s.released)) {
+        this.notify.setReleased()
       }
+      if (this.abandoned) {
+        this.endAbandoned()
+        return
+      }
+      const d = steps[0]
+      const next = steps.find(s => s.step === 'nextResultSet')
+      logger.traceLazy(() => `dispatch received ${d?.data?.length || 0} rows for queryId ${this.queryId}, endOfRows=${d?.endOfRows} endOfResults=${d?.endOfResults}`, this.context)
+      this.acceptRows(d, next)
     }).catch(err => {
       logger.debugLazy(() => `dispatch error for queryId ${this.queryId}: ${err}`, 'DriverRead.dispatch', this.context)
+      if (this.abandoned) {
+        this.endAbandoned()
+        return
+      }
       this.end(err)
     })
   }
 
+  // a batch of rows, with the next result when it was read in the same trip
+  acceptRows (d, next) {
+    this.batchRowIndex = 0
+    this.batchData = d
+    this.dispatchRows(d)
+    if (!d.endOfRows) {
+      this.dispatch()
+    } else if (!d.endOfResults) {
+      if (next) {
+        this.pipelinedNextResult(next)
+      } else {
+        this.nextResult()
+      }
+    } else {
+      d.meta = []
+      this.moveToNextResult(d)
+    }
+  }
+
   nextResult () {
+    if (this.abandoned) {
+      return
+    }
     this.infoFromNextResult = false
-    this.nativeNextResult(this.queryId)
+    this.inFlight(this.nativeNextResult(this.queryId))
       .then(nextResultSetInfo => {
-        this.moveToNextResult(nextResultSetInfo)
+        this.acceptNextResultSet(nextResultSetInfo)
       }).catch(err => {
-        this.end(err)
+        this.rejectNextResultSet(err)
       })
   }
 
+  acceptNextResultSet (nextResultSetInfo) {
+    if (this.abandoned) {
+      this.endAbandoned()
+      return
+    }
+    this.moveToNextResult(nextResultSetInfo)
+  }
+
+  rejectNextResultSet (err) {
+    if (this.abandoned) {
+      this.endAbandoned()
+      return
+    }
+    this.end(err)
+  }
+
+  // a native call the reader waits on - an abandon asked for meanwhile is
+  // acted on once it has returned
+  inFlight (p) {
+    this.nativeInFlight = true
+    return p.finally(() => {
+      this.nativeInFlight = false
+    })
+  }
+
+  // stop reading part way. nothing more is emitted bar done, and free once
+  // the statement is released - what is left of the results is dropped
+  // natively rather than fetched or cancelled. false if already ending.
+  abandon () {
+    if (this.abandoned || this.done || !this.running) {
+      return false
+    }
+    logger.debugLazy(() => `abandon queryId ${this.queryId}, in flight ${this.nativeInFlight}`, this.context)
+    this.abandoned = true
+    if (this.paused) {
+      this.queue.resume(this.notify.getOperation())
+      this.paused = false
+    }
+    if (this.started && !this.nativeInFlight) {
+      this.endAbandoned()
+    }
+    return true
+  }
+
+  endAbandoned () {
+    if (this.done) return
+    this.done = true
+    this.notify.clearTimeout()
+    this.queryHandler.abandon(this.notify, () => {
+      logger.debugLazy(() => `emit done on abandoned query ${this.queryId}`, this.context)
+      this.notify.emit('done', this.queryId)
+    })
+    this.close()
+  }
+
   begin () {
-    this.beginQuery(this.queryId, this.query, this.params).then(res => {
+    if (this.abandoned) {
+      // abandoned while queued, never sent to the driver
+      this.done = true
+      this.close()
+      this.notify.emit('done', this.queryId)
+      this.notify.emit('free', this.queryId)
+      return
+    }
+    this.started = true
+    this.inFlight(this.beginQuery(this.queryId, this.query, this.params)).then(res => {
       this.notify.setHandle(res.queryResult.handle)
+      this.acceptReadAhead(res.queryResult.steps)
+      if (this.abandoned) {
+        this.endAbandoned()
+        return
+      }
 
       if (res.warning) {
         this.routeStatementError(res.warning, this.callback, this.notify)
@@ -444,7 +676,7 @@ class Query extends BasePromises {
   }
 
   pause () {
-    if (this.paused) return
+    if (this.paused || this.abandoned) return
     logger.debugLazy(() => `DriverRead.pause() called for queryId ${this.queryId}`, this.context)
     this.paused = true
     this.queue.park(this.notify.getOperation())
@@ -533,3 +765,4 @@ class Query extends BasePromises {
 }
 
 exports.DriverRead = DriverRead
+exports.defaultDrainMaxBytes = defaultDrainMaxBytes
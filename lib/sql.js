@@ -23,6 +23,7 @@ const cw = require('./sql-client').sqlCLientModule
 const pm = require('./pool').poolModule
 const us = cw.userTypes
 const { logger, LogLevel } = require('./logger')
+const { utilModule } = require('./util')
 
 exports.module = module
 
@@ -38,9 +39,21 @@ function open (params, callback) {
   return cw.open(params, callback)
 }
 
+// the most threads running driver calls at once, separate from the libuv pool
+function setExecutorThreads (count) {
+  return new utilModule.Native().cppDriver.setExecutorThreads(count)
+}
+
+// threads running driver calls now, and statements waiting on the poller
+function getExecutorStats () {
+  return new utilModule.Native().cppDriver.getExecutorStats()
+}
+
 exports.query = query
 exports.queryRaw = queryRaw
 exports.open = open
+exports.setExecutorThreads = setExecutorThreads
+exports.getExecutorStats = getExecutorStats
 exports.promises = cw.promises
 
 exports.Bit = us.Bit
@@ -88,6 +101,8 @@ exports.TzOffsetQuery = us.TzOffsetQuery
 
 exports.Table = us.Table
 exports.TvpFromTable = us.TvpFromTable
+exports.TvpStream = us.TvpStream
+exports.Stream = us.Stream
 exports.Pool = pm.Pool
 
 // Export logger for configuration
@@ -1,5 +1,6 @@
 'use strict'
 
+const crypto = require('crypto')
 const { BasePromises } = require('./base-promises')
 class BulkPromises extends BasePromises {
   constructor (bulk) {
@@ -22,10 +23,22 @@ class BulkPromises extends BasePromises {
   async update (rows) {
     return this.op(cb => this.bulk.updateRows(rows, cb))
   }
+
+  async upsert (rows) {
+    return this.op(cb => this.bulk.upsertRows(rows, cb))
+  }
+
+  async insertStream (source, options) {
+    return this.op(cb => this.bulk.insertStream(source, options, cb))
+  }
+
+  async insertFile (fileName, options) {
+    return this.op(cb => this.bulk.insertFile(fileName, options, cb))
+  }
 }
 
 class TableTypedParam {
-  constructor (col, valueVector, usebcp, bcpVersion, tableName) {
+  constructor (col, valueVector, usebcp, bcpVersion, tableName, bcpHints) {
     this.value = valueVector
     this.offset = col.offset || 0
     this.sql_type = col.sql_type
@@ -35,6 +48,7 @@ class TableTypedParam {
     this.bcp_version = bcpVersion
     this.ordinal_position = col.ordinal_position
     this.table_name = usebcp ? tableName : ''
+    this.bcp_hints = usebcp ? (bcpHints || '') : ''
   }
 }
 
@@ -48,6 +62,11 @@ class TableBulkOpMgr {
     this.summary = this.meta.getSummary()
     this.bcp = false
     this.bcpVersion = 17
+    this.bcpHints = ''
+    this.tvp = false
+    this.tvpTypeName = null
+    this.tvpTypeCreated = null
+    this.streamBatchSize = 5000
     this.promises = new BulkPromises(this)
     // node_mssql JS lib requires this poperty from meta
     this.columns = this.meta.cols
@@ -152,13 +171,14 @@ class TableBulkOpMgr {
     return Object.prototype.hasOwnProperty.call(parent, name)
   }
 
-  arrayPerColumnForCols (rows, colSubSet, usebcp) {
+  arrayPerColumnForCols (rows, colSubSet, usebcp, bcpHints) {
     const dataColsByName = this.arrayPerColumn(rows).arrays_by_name
+    const hints = bcpHints === undefined ? this.bcpHints : bcpHints
     return colSubSet.reduce((agg, col) => {
       if (this.hasProp(dataColsByName, col.name)) {
         const valueVector = dataColsByName[col.name]
         const v = this.usetMetaType
-          ? new TableTypedParam(col, valueVector, usebcp, this.bcpVersion, this.meta.bcpTableName)
+          ? new TableTypedParam(col, valueVector, usebcp, this.bcpVersion, this.meta.bcpTableName, hints)
           : valueVector
         agg.push(v)
       }
@@ -187,6 +207,58 @@ class TableBulkOpMgr {
     return results
   }
 
+  // pull rows from an async iterable (or Readable) into fixed size chunks. at most
+  // concurrency chunks are in flight while the next is being filled, the source
+  // is not read further until one of those is acknowledged. on a pool each chunk
+  // is dispatched to whichever connection is idle. the first error stops the
+  // source, in flight chunks are allowed to finish and all errors are collected.
+
+  async streamIterator (sql, source, batchSize, concurrency, iterate) {
+    const summary = {
+      rows: 0,
+      batches: 0,
+      errors: []
+    }
+    const inFlight = new Set()
+    const flush = chunk => {
+      const p = this.theConnection.promises.query(sql, iterate(chunk))
+        .then(() => {
+          summary.rows += chunk.length
+          summary.batches++
+        })
+        .catch(e => {
+          summary.errors.push(e)
+        })
+        .finally(() => inFlight.delete(p))
+      inFlight.add(p)
+    }
+
+    let chunk = []
+    for await (const row of source) {
+      chunk.push(row)
+      if (chunk.length >= batchSize) {
+        while (inFlight.size >= concurrency) {
+          await Promise.race(inFlight)
+        }
+        if (summary.errors.length > 0) break
+        flush(chunk)
+        chunk = []
+      }
+    }
+    if (summary.errors.length === 0 && chunk.length > 0) {
+      flush(chunk)
+    }
+    await Promise.all(inFlight)
+
+    if (summary.errors.length > 0) {
+      // the summary carries the errors after the one thrown, so it never refers back to it
+      const [err, ...others] = summary.errors
+      err.summary = { rows: summary.rows, batches: summary.batches, errors: others }
+      throw err
+    }
+    return summary
+  }
+
   runOp (rows, signature, cols, bcp, callback) {
     this.runOp2(rows, signature, cols, null, bcp, callback)
   }
@@ -206,15 +278,183 @@ class TableBulkOpMgr {
     this.runOp(rows, this.summary.insertSignature, this.summary.assignableColumns, this.bcp, callback)
   }
 
+  insertStream (source, options, callback) {
+    if (typeof options === 'function') {
+      callback = options
+      options = null
+    }
+    options = options || {}
+    const batchSize = options.batchSize || this.batch || this.streamBatchSize
+    const concurrency = Math.max(1, options.concurrency || 1)
+    const bcp = options.useBcp === undefined ? this.bcp : options.useBcp
+    const hints = options.bcpHints === undefined ? this.bcpHints : options.bcpHints
+    if (bcp) {
+      this.useMetaType(true)
+    }
+    const cols = this.summary.assignableColumns
+    this.streamIterator(this.summary.insertSignature, source, batchSize, concurrency,
+      b => this.arrayPerColumnForCols(b, cols, bcp, hints))
+      .then(res => {
+        callback(null, res)
+      }).catch(e => callback(e, null))
+  }
+
+  // native bcp of a delimited file - fields are matched in order to the named
+  // columns (default all assignable columns) and converted by the server to
+  // the column type. bcp splits on the terminators alone, so rfc 4180 quoting
+  // is not understood - a quoted field would load with its quotes and split on
+  // any terminator inside it. a file cannot be checked for that short of reading
+  // all of it, so the caller must declare quoting: 'none' for the file to load.
+
+  bcpFileOptions (fileName, options) {
+    if (options.quoting !== 'none') {
+      throw new Error('[msnodesql] insertFile splits fields on the terminators alone and cannot read quoted fields, set quoting: \'none\' for a file with none.')
+    }
+    const colsByName = this.summary.columns.reduce((agg, col) => {
+      agg[col.name] = col
+      return agg
+    }, {})
+    const cols = options.columns
+      ? options.columns.map(name => {
+        const col = colsByName[name]
+        if (!col) {
+          throw new Error(`[msnodesql] bcp file column ${name} not found on table.`)
+        }
+        return col
+      })
+      : this.summary.assignableColumns
+    const hints = options.tabLock ? 'TABLOCK' : (options.hints || this.bcpHints)
+    return {
+      table_name: this.meta.bcpTableName,
+      file_name: fileName,
+      error_file: options.errorFile || '',
+      field_terminator: options.fieldTerminator || ',',
+      row_terminator: options.rowTerminator || '\n',
+      hints: hints || '',
+      columns: cols.map(c => c.ordinal_position),
+      first_row: options.firstRow || (options.header ? 2 : 0),
+      last_row: options.lastRow || 0,
+      batch_size: options.batchSize || 0,
+      max_errors: options.maxErrors || 0,
+      code_page: options.codePage === undefined ? 65001 : options.codePage,
+      bcp_version: this.bcpVersion,
+      unicode: options.unicode || false,
+      keep_nulls: options.keepNulls || false
+    }
+  }
+
+  insertFile (fileName, options, callback) {
+    if (typeof options === 'function') {
+      callback = options
+      options = null
+    }
+    options = options || {}
+    if (typeof this.theConnection.bcpFile !== 'function') {
+      setImmediate(() => callback(new Error('[msnodesql] insertFile requires a connection.'), null))
+      return
+    }
+    let native
+    try {
+      native = this.bcpFileOptions(fileName, options)
+    } catch (e) {
+      setImmediate(() => callback(e, null))
+      return
+    }
+    this.theConnection.bcpFile(native, (err, rows) => {
+      callback(err, err ? null : { rows })
+    })
+  }
+
+  // set based update, delete and merge. each batch of rows is bound as one
+  // table valued parameter and joined to the table in a single statement
+  // rather than the statement being executed once per row. the user table
+  // type is created on first use unless one has been named via setTvpTypeName.
+  // the generated name carries a hash of the column declarations, so a type
+  // left by an earlier shape of the table is never bound in place of this one.
+
+  tvpTypeParts () {
+    const first = this.summary.columns[0]
+    const shape = crypto.createHash('sha1')
+      .update(this.tvpUserTypeCols().map(c => `${c.name} ${c.userType}`).join(','))
+      .digest('hex')
+      .substring(0, 8)
+    return {
+      schema: first.table_schema || 'dbo',
+      name: `${first.table_name}BulkType_${shape}`
+    }
+  }
+
+  getTvpTypeName () {
+    if (this.tvpTypeName) return this.tvpTypeName
+    const parts = this.tvpTypeParts()
+    return `${parts.schema}.${parts.name}`
+  }
+
+  quotedTvpTypeName () {
+    const parts = this.tvpTypeParts()
+    const quote = s => `[${s.replace(/]/g, ']]')}]`
+    return `${quote(parts.schema)}.${quote(parts.name)}`
+  }
+
+  setTvpTypeName (name) {
+    this.tvpTypeName = name
+  }
+
+  tvpUserTypeCols () {
+    const useUTC = this.theConnection.getUseUTC()
+    return this.meta.tvpColumns().map(c => c.asUserType(useUTC))
+  }
+
+  asTvpUserType () {
+    const declarations = this.tvpUserTypeCols().map(c => `[${c.name}] ${c.userType}`).join(', ')
+    return `CREATE TYPE ${this.quotedTvpTypeName()} AS TABLE (${declarations})`
+  }
+
+  async ensureTvpType () {
+    if (this.tvpTypeName) return
+    const name = this.getTvpTypeName()
+    if (this.tvpTypeCreated === name) return
+    const literal = this.quotedTvpTypeName().replace(/'/g, "''")
+    await this.theConnection.promises.query(`IF TYPE_ID(N'${literal}') IS NULL ${this.asTvpUserType()}`)
+    this.tvpTypeCreated = name
+  }
+
+  tvpParam (rows) {
+    const table = new this.user.Table(this.getTvpTypeName(), this.tvpUserTypeCols())
+    table.addRowsFromObjects(rows)
+    return [this.user.TvpFromTable(table)]
+  }
+
+  runTvpOp (rows, signature, callback) {
+    this.ensureTvpType()
+      .then(() => this.batchIterator(signature, rows, b => this.tvpParam(b)))
+      .then(res => {
+        callback(null, res)
+      }).catch(e => callback(e, null))
+  }
+
   deleteRows (rows, callback) {
+    if (this.tvp) {
+      this.runTvpOp(rows, this.meta.tvpDeleteStatement(), callback)
+      return
+    }
     this.runOp(rows, this.summary.deleteSignature, this.summary.assignableColumns, false, callback)
   }
 
   updateRows (rows, callback) {
+    if (this.tvp) {
+      this.runTvpOp(rows, this.meta.tvpUpdateStatement(), callback)
+      return
+    }
     this.runOp2(rows, this.summary.updateSignature,
       this.summary.updateColumns, this.summary.whereColumns, false, callback)
   }
 
+  // merge on the where columns - always set based.
+  upsertRows (rows, callback) {
+    this.runTvpOp(rows, this.meta.tvpMergeStatement(), callback)
+  }
+
   selectRows (rows, callback) {
     const res = []
     const colArray = this.arrayPerColumnForCols(rows, this.summary.whereColumns)
@@ -265,10 +505,28 @@ class TableBulkOpMgr {
     return this.bcpVersion
   }
 
+  // bcp only - server hints such as 'TABLOCK' or 'ORDER(id ASC)'
+  setBcpHints (v) {
+    this.bcpHints = v || ''
+  }
+
+  getBcpHints () {
+    return this.bcpHints
+  }
+
   getUseBcp () {
     return this.bcp
   }
 
+  // update and delete, upsert is always set based
+  setUseTvp (v) {
+    this.tvp = v
+  }
+
+  getUseTvp () {
+    return this.tvp
+  }
+
   useMetaType (v) {
     this.usetMetaType = v
   }
@@ -119,6 +119,44 @@ class TableMeta {
     return `insert into ${this.fullTableName} ( ${this.columnList(subSet)} ) ${values}`
   }
 
+  // set based forms - the rows arrive as a table valued parameter aliased s
+  // and are joined on the where columns to the target aliased t.
+
+  tvpColumns () {
+    const whereByName = this.whereColumns.reduce((agg, col) => {
+      agg[col.name] = col
+      return agg
+    }, {})
+    return this.allColumns.filter(col => !col.isReadOnly() ||
+      Object.prototype.hasOwnProperty.call(whereByName, col.name))
+  }
+
+  tvpAssign (colSubSet) {
+    return colSubSet.map(c => `t.[${c.name}] = s.[${c.name}]`)
+  }
+
+  tvpJoin () {
+    return this.tvpAssign(this.whereColumns).join(' and ')
+  }
+
+  tvpUpdateStatement () {
+    return `update t set ${this.tvpAssign(this.updateColumns).join(', ')} from ${this.fullTableName} as t inner join ? as s on ${this.tvpJoin()}`
+  }
+
+  tvpDeleteStatement () {
+    return `delete t from ${this.fullTableName} as t inner join ? as s on ${this.tvpJoin()}`
+  }
+
+  tvpMergeStatement () {
+    const insertCols = this.assignableColumns
+    const matched = this.updateColumns.length > 0
+      ? ` when matched then update set ${this.tvpAssign(this.updateColumns).join(', ')}`
+      : ''
+    return `merge ${this.fullTableName} as t using ? as s on ( ${this.tvpJoin()} )${matched}` +
+      ` when not matched then insert ( ${this.columnList(insertCols)} )` +
+      ` values ( ${insertCols.map(c => `s.[${c.name}]`).join(', ')} );`
+  }
+
   filteredSet (colSubSet) {
     return colSubSet.reduce((agg, c) => {
       if (Object.prototype.hasOwnProperty.call(this.colByName, c.name)) {
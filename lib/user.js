@@ -1,5 +1,7 @@
 'use strict'
 
+const { StringDecoder } = require('string_decoder')
+
 const userModule = ((() => {
   /*
  sql.UDT(value)
@@ -118,9 +120,10 @@ const userModule = ((() => {
         precision = precision > 0
           ? precision
           : 0
-        scale = scale > 0
+        // left undefined when not given, so a declared scale of 0 is kept apart
+        scale = scale >= 0
           ? scale
-          : 0
+          : undefined
 
         this.sql_type = sqlType
         this.value = value
@@ -224,6 +227,79 @@ const userModule = ((() => {
       return new ConcreteColumnType(SQL_WLONGVARCHAR, p, 0, 0)
     }
 
+    // sql.Stream(source, { type: 'varbinary' | 'nvarchar' }) -- a varbinary(max) or
+    // nvarchar(max) value read from a Readable, async iterable or Buffer only as
+    // the driver sends it with SQLPutData. a source can be consumed once.
+
+    const STREAM_CHUNK_SIZE = 64 * 1024
+
+    function * bufferSlices (buffer, size) {
+      for (let i = 0; i < buffer.length; i += size) {
+        yield buffer.subarray(i, i + size)
+      }
+    }
+
+    function streamSource (source, size) {
+      if (Buffer.isBuffer(source)) {
+        return bufferSlices(source, size)
+      }
+      if (typeof source === 'string') {
+        return [source]
+      }
+      if (source && (typeof source[Symbol.asyncIterator] === 'function' ||
+        typeof source[Symbol.iterator] === 'function')) {
+        return source
+      }
+      throw new TypeError('sql.Stream expects a Readable, iterable, Buffer or string')
+    }
+
+    // nvarchar chunks are sent as utf16le, a utf8 buffer split mid character
+    // is carried into the next chunk by the decoder.
+    async function * streamChunks (source, wide, size) {
+      const decoder = wide ? new StringDecoder('utf8') : null
+      for await (const chunk of streamSource(source, size)) {
+        if (typeof chunk === 'string') {
+          yield Buffer.from(chunk, wide ? 'utf16le' : 'utf8')
+        } else if (wide) {
+          const text = decoder.write(chunk)
+          if (text.length > 0) {
+            yield Buffer.from(text, 'utf16le')
+          }
+        } else {
+          yield chunk
+        }
+      }
+      if (wide) {
+        const tail = decoder.end()
+        if (tail.length > 0) {
+          yield Buffer.from(tail, 'utf16le')
+        }
+      }
+    }
+
+    function Stream (source, options) {
+      const opts = options || {}
+      const wide = opts.type === 'nvarchar'
+      const size = opts.chunkSize > 0 ? opts.chunkSize : STREAM_CHUNK_SIZE
+      let chunks = null
+      // called by the driver for each chunk, deliver(err, buffer) with null ending the value
+      const pull = deliver => {
+        try {
+          if (!chunks) {
+            chunks = streamChunks(source, wide, size)
+          }
+          chunks.next().then(r => deliver(null, r.done ? null : r.value), e => deliver(e))
+        } catch (e) {
+          deliver(e)
+        }
+      }
+      return {
+        sql_type: wide ? SQL_WLONGVARCHAR : SQL_LONGVARBINARY,
+        data_at_exec: true,
+        pull
+      }
+    }
+
     // sql.DateTimeOffset(value, [scale]) -- optional scale definition
 
     function DateTimeOffset (p, scale, offset) {
@@ -406,6 +482,80 @@ const userModule = ((() => {
       return tp
     }
 
+    // sql.TvpStream(table, source, { batchSize }) -- a table parameter whose rows,
+    // arrays or objects keyed by column name, are read from an async iterable
+    // batchSize at a time as the driver sends them, rather than copied up front.
+
+    const TVP_STREAM_BATCH_SIZE = 1000
+    const TVP_STREAM_MAX_COLUMN_LENGTH = 4000
+
+    // characters (or bytes for binary) each row reserves for a column
+    function streamWidth (col, maxColumnLength) {
+      const ty = col.type || {}
+      const length = ty.length || col.length
+      if (!(length > 0)) {
+        return maxColumnLength
+      }
+      switch (ty.declaration || ty.type || ty.type_id) {
+        case 'nchar':
+        case 'nvarchar':
+          return length / 2
+        default:
+          return length
+      }
+    }
+
+    function TvpStream (table, source, options) {
+      const opts = options || {}
+      const batchSize = opts.batchSize > 0 ? opts.batchSize : TVP_STREAM_BATCH_SIZE
+      const maxColumnLength = opts.maxColumnLength > 0 ? opts.maxColumnLength : TVP_STREAM_MAX_COLUMN_LENGTH
+      const cols = table.columns
+      const declared = cols.map(c => {
+        const { scale, precision, type: ty } = c
+        return { scale, precision, ...ty }
+      })
+      const tp = {
+        sql_type: SQL_SS_TABLE,
+        table_name: table.name,
+        type_id: table.name,
+        is_user_defined: true,
+        is_output: false,
+        value: table,
+        table_value_param: declared.map((dt, c) => {
+          const column = getSqlTypeFromDeclaredType(dt, [null])
+          column.stream_width = streamWidth(cols[c], maxColumnLength)
+          return column
+        }),
+        row_count: batchSize,
+        schema: table.schema || 'dbo',
+        data_at_exec: true
+      }
+
+      const toRow = r => Array.isArray(r) ? r : cols.map(c => r[c.name])
+      let rows = null
+      async function nextBatch () {
+        if (!rows) {
+          rows = typeof source[Symbol.asyncIterator] === 'function'
+            ? source[Symbol.asyncIterator]()
+            : source[Symbol.iterator]()
+        }
+        const batch = []
+        while (batch.length < batchSize) {
+          const r = await rows.next()
+          if (r.done) break
+          batch.push(toRow(r.value))
+        }
+        if (batch.length === 0) return null
+        return declared.map((dt, c) => getSqlTypeFromDeclaredType(dt, batch.map(row => row[c])))
+      }
+
+      // called by the driver for each batch, deliver(err, columns) with null ending the table
+      tp.pull = deliver => {
+        nextBatch().then(columns => deliver(null, columns), e => deliver(e))
+      }
+      return tp
+    }
+
     function getSqlTypeFromDeclaredType (dt, p) {
       const type = dt.declaration || dt.type || dt.type_id
       switch (type) {
@@ -527,7 +677,9 @@ const userModule = ((() => {
       SmallDateTime: DateTime2,
       DateTimeOffset,
       TvpFromTable,
+      TvpStream,
       Table,
+      Stream,
       getSqlTypeFromDeclaredType
     }
   }
@@ -876,4 +876,78 @@ describe('bcp', function () {
     })
     await bcp.runner()
   })
+
+  it('bcp insertFile - delimited file with header', async function handler () {
+    const fs = require('fs')
+    const os = require('os')
+    const path = require('path')
+    const tableName = 'test_table_bcp'
+    const helper = env.bulkTableTest({
+      tableName,
+      columns: [
+        {
+          name: 'id',
+          type: 'INT PRIMARY KEY'
+        },
+        {
+          name: 's1',
+          type: 'NVARCHAR(50)'
+        },
+        {
+          name: 'n1',
+          type: 'numeric(18,4)'
+        }]
+    })
+    const rows = 1000
+    const expected = []
+    const lines = ['n1,id,s1']
+    for (let i = 0; i < rows; ++i) {
+      expected.push({ id: i, s1: `row${i}`, n1: i + 0.5 })
+      lines.push(`${i + 0.5},${i},row${i}`)
+    }
+    const fileName = path.join(os.tmpdir(), `msnodesqlv8-bcp-${process.pid}.csv`)
+    fs.writeFileSync(fileName, lines.join('\n') + '\n')
+    try {
+      const table = await helper.create()
+      const res = await table.promises.insertFile(fileName, {
+        quoting: 'none',
+        header: true,
+        columns: ['n1', 'id', 's1']
+      })
+      assert.deepStrictEqual(res.rows, rows)
+      const top = await env.theConnection.promises.query(`select top 100 * from ${tableName} order by id`)
+      assert.deepStrictEqual(top.first, expected.slice(0, 100))
+    } finally {
+      fs.unlinkSync(fileName)
+    }
+  })
+
+  it('bcp insertFile - file without quoting none is rejected', async function handler () {
+    const fs = require('fs')
+    const os = require('os')
+    const path = require('path')
+    const helper = env.bulkTableTest({
+      tableName: 'test_table_bcp',
+      columns: [
+        {
+          name: 'id',
+          type: 'INT PRIMARY KEY'
+        },
+        {
+          name: 's1',
+          type: 'NVARCHAR(50)'
+        }]
+    })
+    const fileName = path.join(os.tmpdir(), `msnodesqlv8-bcp-quoted-${process.pid}.csv`)
+    fs.writeFileSync(fileName, 'id,s1\n1,plain\n2,"with, comma"\n')
+    try {
+      const table = await helper.create()
+      await expect(table.promises.insertFile(fileName, { header: true }))
+        .to.be.rejectedWith("set quoting: 'none'")
+      const res = await env.theConnection.promises.query('select count(*) as n from test_table_bcp')
+      assert.deepStrictEqual(res.first[0].n, 0)
+    } finally {
+      fs.unlinkSync(fileName)
+    }
+  })
 })
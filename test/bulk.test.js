@@ -365,6 +365,111 @@ describe('bulk', function () {
     await env.asPool(t2)
   })
 
+  async function t2stream (proxy) {
+    const bulkTableDef = {
+      tableName: 'test_table_bulk',
+      columns: [
+        {
+          name: 'id',
+          type: 'INT PRIMARY KEY'
+        },
+        {
+          name: 's1',
+          type: 'VARCHAR (255) NOT NULL'
+        }
+      ]
+    }
+
+    const helper = env.bulkTableTest(bulkTableDef, proxy)
+    const rows = 1250
+    const batchSize = 100
+    const expected = []
+    for (let i = 0; i < rows; ++i) {
+      expected.push({
+        id: i,
+        s1: `testing${i}Data`
+      })
+    }
+    async function * source () {
+      for (const row of expected) {
+        yield row
+      }
+    }
+    const table = await helper.create()
+    const summary = await table.promises.insertStream(source(), { batchSize })
+    assert.deepStrictEqual(summary, {
+      rows,
+      batches: Math.ceil(rows / batchSize),
+      errors: []
+    })
+    const res = await table.promises.select(expected)
+    assert.deepStrictEqual(res, expected)
+  }
+
+  it('connection: stream rows from async generator', async function handler () {
+    await t2stream(env.theConnection)
+  })
+
+  it('pool: stream rows from async generator', async function handler () {
+    await env.asPool(t2stream)
+  })
+
+  async function t2tvp (proxy) {
+    const bulkTableDef = {
+      tableName: 'test_table_bulk',
+      columns: [
+        {
+          name: 'id',
+          type: 'INT PRIMARY KEY'
+        },
+        {
+          name: 's1',
+          type: 'VARCHAR (255) NOT NULL'
+        }
+      ]
+    }
+
+    const helper = env.bulkTableTest(bulkTableDef, proxy)
+    const rows = 500
+    const vec = []
+    for (let i = 0; i < rows; ++i) {
+      vec.push({
+        id: i,
+        s1: `testing${i}Data`
+      })
+    }
+    const table = await helper.create()
+    const typeName = table.getTvpTypeName()
+    assert.match(typeName, /\.test_table_bulkBulkType_[0-9a-f]{8}$/)
+    assert.match(table.asTvpUserType(), /^CREATE TYPE \[[^\]]+\]\.\[test_table_bulkBulkType_[0-9a-f]{8}\] AS TABLE/)
+    await proxy.promises.query(`IF TYPE_ID(N'${typeName}') IS NOT NULL DROP TYPE ${typeName}`)
+    await table.promises.insert(vec)
+    table.setUseTvp(true)
+    const affected = res => res.reduce((agg, r) => agg + r.counts.reduce((a, c) => a + c, 0), 0)
+
+    const updated = vec.map(r => ({ id: r.id, s1: `updated${r.id}` }))
+    assert.deepStrictEqual(affected(await table.promises.update(updated)), rows)
+    assert.deepStrictEqual(await table.promises.select(vec), updated)
+
+    const removed = updated.filter(r => r.id % 2 === 0)
+    assert.deepStrictEqual(affected(await table.promises.delete(removed)), removed.length)
+
+    const merged = updated.slice(0, 10).map(r => ({ id: r.id, s1: `merged${r.id}` }))
+    assert.deepStrictEqual(affected(await table.promises.upsert(merged)), merged.length)
+    const res = await table.promises.select(merged)
+    assert.deepStrictEqual(res, merged)
+    const total = await proxy.promises.query('select count(*) as n from test_table_bulk')
+    assert.deepStrictEqual(total.first[0].n, rows / 2 + removed.filter(r => r.id < 10).length)
+  }
+
+  it('connection: set based update, delete and upsert via tvp', async function handler () {
+    await t2tvp(env.theConnection)
+  })
+
+  it('pool: set based update, delete and upsert via tvp', async function handler () {
+    await env.asPool(t2tvp)
+  })
+
   async function t4typed (proxy, type) {
     const helper = env.typeTableHelper(type, proxy)
     const testDate = new Date('Mon Apr 26 2021 22:05:38 GMT-0500 (Central Daylight Time)')
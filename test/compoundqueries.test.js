@@ -373,4 +373,44 @@ describe('compoundqueries', function () {
       done()
     }) // end of async.series()
   }) // end of it()
+
+  it('batch splits the results of each statement and attributes an error', async function handler () {
+    const promises = env.theConnection.promises
+    const results = await promises.batch([
+      { sql: 'select ? as a, ? as b', params: [1, 'one'] },
+      'declare @t table (v int)\ninsert into @t values (1), (2)\nselect v from @t order by v',
+      { sql: 'select ? as c', params: [3] },
+      'select 1 / 0 as d',
+      'select 5 as e',
+      'with w (f) as (select 6) select f from w'
+    ])
+    assert.deepStrictEqual(results.length, 6)
+    assert.deepStrictEqual(results[0].first, [{ a: 1, b: 'one' }])
+    assert.deepStrictEqual(results[1].counts, [2])
+    assert.deepStrictEqual(results[1].first, [{ v: 1 }, { v: 2 }])
+    assert.deepStrictEqual(results[2].first, [{ c: 3 }])
+    assert.deepStrictEqual(results[2].errors.length, 0)
+    assert(results[3].errors[0].message.includes('Divide by zero'))
+    assert.deepStrictEqual(results[4].first, [{ e: 5 }])
+    assert.deepStrictEqual(results[5].first, [{ f: 6 }])
+  })
+
+  it('batch runs on after a statement error and refuses a create procedure', async function handler () {
+    const promises = env.theConnection.promises
+    const results = await promises.batch([
+      'create table #batch_after (v int)',
+      'insert into #batch_after values (1 / 0)',
+      { sql: 'insert into #batch_after values (?)', params: [7] },
+      'with w as (select v from #batch_after) select v from w',
+      'drop table #batch_after'
+    ])
+    assert(results[1].errors[0].message.includes('Divide by zero'))
+    assert.isTrue(results[2].executed)
+    assert.deepStrictEqual(results[2].counts, [1])
+    assert.deepStrictEqual(results[3].first, [{ v: 7 }])
+    assert.throws(() => env.theConnection.batch([
+      'select 1',
+      'create procedure batch_proc as select 1'
+    ], () => {}), /must be alone/)
+  })
 })
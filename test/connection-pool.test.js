@@ -84,6 +84,13 @@ describe('pool', function () {
     await expect(pool.promises.query('select @@SPID as spid')).to.be.rejectedWith('closed')
   })
 
+  it('bulkLoad on closed pool - expect reject', async function handler () {
+    const pool = env.pool()
+    await pool.promises.open()
+    await pool.promises.close()
+    await expect(pool.promises.bulkLoad('test_pool_bulk_load', [{ id: 1 }])).to.be.rejectedWith('closed')
+  })
+
   it('submit query to closed pool with callback - expect error on cb', async function handler () {
     const pool = env.pool()
     await pool.promises.open()
@@ -162,6 +169,31 @@ describe('pool', function () {
     await pool.promises.close()
   })
 
+  it('use pool bulkLoad with tabLock - parallel bcp into heap', async function handler () {
+    const pool = env.pool(4)
+    await pool.promises.open()
+    const tableName = 'test_pool_bulk_load'
+    await env.theConnection.promises.query(env.dropTableSql(tableName))
+    await env.theConnection.promises.query(`create table ${tableName} (id int, s1 nvarchar(50))`)
+    const rows = 2000
+    async function * source () {
+      for (let i = 0; i < rows; ++i) {
+        yield { id: i, s1: `row${i}` }
+      }
+    }
+    const summary = await pool.promises.bulkLoad(tableName, source(), {
+      batchSize: 250,
+      concurrency: 4,
+      tabLock: true
+    })
+    expect(summary.rows).to.equal(rows)
+    expect(summary.batches).to.equal(8)
+    expect(summary.errors.length).to.equal(0)
+    const res = await pool.promises.query(`select count(*) as n from ${tableName}`)
+    expect(res.first[0].n).to.equal(rows)
+    await pool.promises.close()
+  })
+
   it('use pool for tvp insert', async function handler () {
     const pool = env.pool(4)
     await pool.promises.open()
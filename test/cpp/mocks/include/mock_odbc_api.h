@@ -180,5 +180,21 @@ namespace mssql
                 (SQLSMALLINT HandleType,
                  SQLHANDLE Handle),
                 (override));
+
+    MOCK_METHOD(SQLRETURN, SQLFreeStmt,
+                (SQLHSTMT StatementHandle,
+                 SQLUSMALLINT Option),
+                (override));
+
+    MOCK_METHOD(SQLRETURN, SQLParamData,
+                (SQLHSTMT StatementHandle,
+                 SQLPOINTER* Value),
+                (override));
+
+    MOCK_METHOD(SQLRETURN, SQLPutData,
+                (SQLHSTMT StatementHandle,
+                 SQLPOINTER Data,
+                 SQLLEN StrLen_or_Ind),
+                (override));
   };
 }
\ No newline at end of file
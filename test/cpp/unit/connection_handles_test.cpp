@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <odbc/connection_handles.h>
+
+#include <memory>
+#include <vector>
+
+#include "mock_odbc_api.h"
+
+using namespace mssql;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+// raw statement handles handed out and freed through the fake handle type
+struct Ledger {
+  size_t next = 0x1000;
+  size_t allocs = 0;
+  size_t frees = 0;
+};
+
+template <typename Interface>
+class FakeHandle final : public Interface {
+ public:
+  explicit FakeHandle(std::shared_ptr<Ledger> ledger) : ledger_(std::move(ledger)) {}
+
+  bool alloc(SQLHANDLE) override {
+    ledger_->allocs++;
+    handle_ = reinterpret_cast<SQLHANDLE>(ledger_->next++);
+    return true;
+  }
+  void free() override {
+    if (handle_ != SQL_NULL_HANDLE) {
+      ledger_->frees++;
+      handle_ = SQL_NULL_HANDLE;
+    }
+  }
+  void read_errors(shared_ptr<IOdbcApi>,
+                   shared_ptr<vector<shared_ptr<OdbcError>>>&) const override {}
+  SQLHANDLE get_handle() const override {
+    return handle_;
+  }
+  SQLHANDLE detach() override {
+    const auto handle = handle_;
+    handle_ = SQL_NULL_HANDLE;
+    return handle;
+  }
+  bool adopt(SQLHANDLE handle) override {
+    handle_ = handle;
+    return handle_ != SQL_NULL_HANDLE;
+  }
+
+ private:
+  std::shared_ptr<Ledger> ledger_;
+  SQLHANDLE handle_ = SQL_NULL_HANDLE;
+};
+
+class ConnectionHandlesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    statements = std::make_shared<Ledger>();
+    connections = std::make_shared<Ledger>();
+    env = std::make_shared<FakeHandle<IOdbcEnvironmentHandle>>(connections);
+    env->alloc(SQL_NULL_HANDLE);
+
+    originalConFactory = create_connection_handle;
+    originalStmtFactory = create_statement_handle;
+    create_connection_handle = [this]() -> std::shared_ptr<IOdbcConnectionHandle> {
+      return std::make_shared<FakeHandle<IOdbcConnectionHandle>>(connections);
+    };
+    create_statement_handle = [this]() -> std::shared_ptr<IOdbcStatementHandle> {
+      return std::make_shared<FakeHandle<IOdbcStatementHandle>>(statements);
+    };
+
+    api = std::make_shared<NiceMock<MockOdbcApi>>();
+    ON_CALL(*api, SQLFreeStmt(_, _)).WillByDefault(Return(SQL_SUCCESS));
+    ON_CALL(*api, SQLSetStmtAttrW(_, _, _, _)).WillByDefault(Return(SQL_SUCCESS));
+  }
+
+  void TearDown() override {
+    create_connection_handle = originalConFactory;
+    create_statement_handle = originalStmtFactory;
+  }
+
+  std::shared_ptr<Ledger> statements;
+  std::shared_ptr<Ledger> connections;
+  std::shared_ptr<IOdbcEnvironmentHandle> env;
+  std::shared_ptr<NiceMock<MockOdbcApi>> api;
+  ConnectionHandleFactory originalConFactory;
+  StatementHandleFactory originalStmtFactory;
+};
+}  // namespace
+
+TEST_F(ConnectionHandlesTest, CheckinResetsHandleForNextCheckout) {
+  ConnectionHandles handles(env, api);
+
+  const auto raw = handles.checkout(1)->get_handle();
+  EXPECT_CALL(*api, SQLFreeStmt(raw, SQL_CLOSE)).WillOnce(Return(SQL_SUCCESS));
+  EXPECT_CALL(*api, SQLFreeStmt(raw, SQL_UNBIND)).WillOnce(Return(SQL_SUCCESS));
+  EXPECT_CALL(*api, SQLFreeStmt(raw, SQL_RESET_PARAMS)).WillOnce(Return(SQL_SUCCESS));
+  handles.checkin(1);
+
+  const auto next = handles.checkout(2);
+  ASSERT_NE(next, nullptr);
+  EXPECT_EQ(next->get_handle(), raw);
+  EXPECT_FALSE(handles.exists(1));
+  EXPECT_TRUE(handles.exists(2));
+
+  const auto stats = handles.statementPoolStats();
+  EXPECT_EQ(stats.allocated, 1u);
+  EXPECT_EQ(stats.recycled, 1u);
+  EXPECT_EQ(stats.reused, 1u);
+  EXPECT_EQ(stats.idle, 0u);
+  EXPECT_EQ(statements->allocs, 1u);
+  EXPECT_EQ(statements->frees, 0u);
+}
+
+TEST_F(ConnectionHandlesTest, PoolSizeCapsIdleHandles) {
+  ConnectionHandles handles(env, api);
+  handles.setStatementPoolSize(2);
+
+  for (long id = 1; id <= 4; ++id) {
+    ASSERT_NE(handles.checkout(id), nullptr);
+  }
+  for (long id = 1; id <= 4; ++id) {
+    handles.checkin(id);
+  }
+
+  auto stats = handles.statementPoolStats();
+  EXPECT_EQ(stats.allocated, 4u);
+  EXPECT_EQ(stats.recycled, 2u);
+  EXPECT_EQ(stats.discarded, 2u);
+  EXPECT_EQ(stats.idle, 2u);
+  EXPECT_EQ(statements->frees, 2u);
+  EXPECT_EQ(handles.size(), 0u);
+
+  // shrinking the pool frees what is idle beyond it
+  handles.setStatementPoolSize(0);
+  EXPECT_EQ(handles.statementPoolStats().idle, 0u);
+  EXPECT_EQ(statements->frees, 4u);
+
+  // and with no pool a released handle is freed, never reset
+  EXPECT_CALL(*api, SQLFreeStmt(_, _)).Times(0);
+  ASSERT_NE(handles.checkout(5), nullptr);
+  handles.checkin(5);
+  stats = handles.statementPoolStats();
+  EXPECT_EQ(stats.allocated, 5u);
+  EXPECT_EQ(stats.reused, 0u);
+  EXPECT_EQ(stats.idle, 0u);
+  EXPECT_EQ(statements->frees, 5u);
+}
+
+TEST_F(ConnectionHandlesTest, FailedResetDiscardsHandle) {
+  ConnectionHandles handles(env, api);
+  ON_CALL(*api, SQLFreeStmt(_, SQL_UNBIND)).WillByDefault(Return(SQL_ERROR));
+
+  const auto raw = handles.checkout(1)->get_handle();
+  handles.checkin(1);
+
+  const auto stats = handles.statementPoolStats();
+  EXPECT_EQ(stats.recycled, 0u);
+  EXPECT_EQ(stats.discarded, 1u);
+  EXPECT_EQ(stats.idle, 0u);
+  EXPECT_EQ(statements->frees, 1u);
+  EXPECT_NE(handles.checkout(2)->get_handle(), raw);
+  EXPECT_EQ(handles.statementPoolStats().allocated, 2u);
+}
+
+TEST_F(ConnectionHandlesTest, DestructionFreesIdleHandles) {
+  {
+    ConnectionHandles handles(env, api);
+    ASSERT_NE(handles.checkout(1), nullptr);
+    ASSERT_NE(handles.checkout(2), nullptr);
+    handles.checkin(1);
+    handles.checkin(2);
+    EXPECT_EQ(handles.statementPoolStats().idle, 2u);
+    EXPECT_EQ(statements->frees, 0u);
+  }
+  EXPECT_EQ(statements->allocs, 2u);
+  EXPECT_EQ(statements->frees, 2u);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <common/executor_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using namespace mssql;
+
+namespace {
+// counts tasks down and lets the test wait for them all
+class Latch {
+ public:
+  explicit Latch(int count) : count_(count) {}
+  void CountDown() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--count_ == 0) {
+      done_.notify_all();
+    }
+  }
+  bool Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return done_.wait_for(lock, std::chrono::seconds(10), [this]() { return count_ == 0; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable done_;
+  int count_;
+};
+}  // namespace
+
+TEST(ExecutorPoolTest, TasksForOneKeyRunInOrderOneAtATime) {
+  ExecutorPool pool(8);
+  const int connection = 0;
+  std::vector<int> order;
+  std::atomic<int> running{0};
+  std::atomic<bool> overlapped{false};
+  Latch latch(100);
+  for (int i = 0; i < 100; ++i) {
+    pool.Submit(&connection, [&, i]() {
+      if (running.fetch_add(1) != 0) {
+        overlapped = true;
+      }
+      order.push_back(i);
+      running.fetch_sub(1);
+      latch.CountDown();
+    });
+  }
+  ASSERT_TRUE(latch.Wait());
+  EXPECT_FALSE(overlapped.load());
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(ExecutorPoolTest, BlockedKeyDoesNotHoldUpOthers) {
+  ExecutorPool pool(4);
+  int slow = 0;
+  int fast = 0;
+  std::mutex gate;
+  std::unique_lock<std::mutex> hold(gate);
+  Latch released(1);
+  Latch others(10);
+  pool.Submit(&slow, [&]() {
+    std::lock_guard<std::mutex> wait(gate);
+    released.CountDown();
+  });
+  for (int i = 0; i < 10; ++i) {
+    pool.Submit(&fast, [&]() { others.CountDown(); });
+  }
+  EXPECT_TRUE(others.Wait());
+  hold.unlock();
+  EXPECT_TRUE(released.Wait());
+}
+
+TEST(ExecutorPoolTest, ThreadsStartOnDemandUpToTheLimit) {
+  ExecutorPool pool(2);
+  EXPECT_EQ(pool.Threads(), 0u);
+  int keys[4];
+  Latch latch(4);
+  for (auto& key : keys) {
+    pool.Submit(&key, [&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      latch.CountDown();
+    });
+  }
+  ASSERT_TRUE(latch.Wait());
+  EXPECT_EQ(pool.Threads(), 2u);
+  EXPECT_EQ(pool.MaxThreads(), 2u);
+}
+
+TEST(ExecutorPoolTest, BusyCountsThreadsRunningATask) {
+  ExecutorPool pool(4);
+  int keys[3];
+  std::mutex gate;
+  std::unique_lock<std::mutex> hold(gate);
+  Latch started(3);
+  Latch finished(3);
+  for (auto& key : keys) {
+    pool.Submit(&key, [&]() {
+      started.CountDown();
+      std::lock_guard<std::mutex> wait(gate);
+      finished.CountDown();
+    });
+  }
+  ASSERT_TRUE(started.Wait());
+  EXPECT_EQ(pool.Busy(), 3u);
+  hold.unlock();
+  ASSERT_TRUE(finished.Wait());
+  // the last task may still be handing its thread back
+  for (int i = 0; i < 1000 && pool.Busy() > 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(pool.Busy(), 0u);
+}
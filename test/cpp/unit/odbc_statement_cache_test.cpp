@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <odbc/odbc_statement_cache.h>
+#include <odbc/odbc_statement_legacy.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mssql;
+
+namespace {
+// statements the cache only keys, sizes and hands back, never executed
+std::shared_ptr<OdbcStatementLegacy> make_statement(const int statementId) {
+  auto params = std::make_shared<QueryOperationParams>();
+  params->query_string = u"select 1";
+  params->numeric_string = false;
+  params->bigint_as_native = false;
+  params->polling = false;
+  return std::make_shared<OdbcStatementLegacy>(
+      nullptr, nullptr, nullptr, nullptr, StatementHandle(1, statementId), params);
+}
+
+class OdbcStatementCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    OdbcStatementCache::statements evicted;
+    cache.Configure(0, 2, 0, evicted);
+  }
+
+  std::shared_ptr<OdbcStatementLegacy> insert(const int statementId) {
+    auto statement = make_statement(statementId);
+    OdbcStatementCache::statements evicted;
+    cache.Insert(statementId, u"sql", CachedStatementKind::Prepared, statement, evicted);
+    for (const auto& victim : evicted) {
+      evictedIds.push_back(victim->GetStatementHandle().getStatementId());
+    }
+    return statement;
+  }
+
+  bool release(const int statementId) {
+    OdbcStatementCache::statements evicted;
+    return cache.Release(statementId, true, evicted);
+  }
+
+  OdbcStatementCache cache;
+  std::vector<int> evictedIds;
+};
+}  // namespace
+
+TEST_F(OdbcStatementCacheTest, IdleStatementEvictedBeforeBusyOneIsMarked) {
+  insert(1);  // stays checked out
+  insert(2);
+  ASSERT_TRUE(release(2));
+
+  // over capacity with the busy statement at the least recently used end
+  insert(3);
+  EXPECT_EQ(evictedIds, std::vector<int>{2});
+  EXPECT_TRUE(release(1));
+  EXPECT_TRUE(release(3));
+  EXPECT_EQ(cache.Stats().size, 2u);
+  EXPECT_EQ(cache.Stats().evictions, 1u);
+}
+
+TEST_F(OdbcStatementCacheTest, BusyStatementMarkedOnlyWhenNoneIdle) {
+  insert(1);
+  insert(2);
+  insert(3);
+  EXPECT_TRUE(evictedIds.empty());
+
+  // the least recently used busy statement is dropped when released
+  EXPECT_FALSE(release(1));
+  EXPECT_TRUE(release(2));
+  EXPECT_TRUE(release(3));
+  EXPECT_EQ(cache.Stats().size, 2u);
+}
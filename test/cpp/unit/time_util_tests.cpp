@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "time_utils.h"
+#include <limits>
 using namespace mssql;
 
 TEST(TimeUtilsTest, EpochAndNearbyDates) {
@@ -532,4 +533,56 @@ TEST(TimeUtilsTest, RobustnessTests) {
     EXPECT_LE(inf.month, 12);
     EXPECT_GE(inf.day, 1);
     EXPECT_LE(inf.day, 31);
-}
\ No newline at end of file
+}
+
+TEST(TimeUtilsTest, BatchConversionMatchesScalar) {
+    // the column binders convert whole arrays in one pass, each entry must
+    // match the scalar conversion and NaN entries are left for the caller
+    const double column[] = {
+        0.0, -1.0, 1613399445123.0, 1613347200000.0, -1613399445123.0,
+        951782400000.0, 4102444800000.0, std::numeric_limits<double>::quiet_NaN()};
+    constexpr size_t len = sizeof(column) / sizeof(column[0]);
+
+    for (const int32_t offset : {0, 60, -300}) {
+        SQL_TIMESTAMP_STRUCT ts[len] = {};
+        SQL_DATE_STRUCT dates[len] = {};
+        SQL_SS_TIME2_STRUCT times[len] = {};
+        SQL_SS_TIMESTAMPOFFSET_STRUCT tso[len] = {};
+        TimeUtils::toTimestampStructs(column, len, offset, ts);
+        TimeUtils::toDateStructs(column, len, offset, dates);
+        TimeUtils::toTimeStructs(column, len, offset, times);
+        TimeUtils::toTimestampOffsetStructs(column, len, offset, tso);
+
+        for (size_t i = 0; i + 1 < len; ++i) {
+            const auto expected = TimeUtils::createTimestampStruct(column[i], offset);
+            EXPECT_EQ(ts[i].year, expected.year);
+            EXPECT_EQ(ts[i].month, expected.month);
+            EXPECT_EQ(ts[i].day, expected.day);
+            EXPECT_EQ(ts[i].hour, expected.hour);
+            EXPECT_EQ(ts[i].minute, expected.minute);
+            EXPECT_EQ(ts[i].second, expected.second);
+            EXPECT_EQ(ts[i].fraction, expected.fraction);
+
+            const auto date = TimeUtils::createDateStruct(column[i], offset);
+            EXPECT_EQ(dates[i].year, date.year);
+            EXPECT_EQ(dates[i].month, date.month);
+            EXPECT_EQ(dates[i].day, date.day);
+
+            const auto time = TimeUtils::createTimeStruct(column[i], offset);
+            EXPECT_EQ(times[i].hour, time.hour);
+            EXPECT_EQ(times[i].minute, time.minute);
+            EXPECT_EQ(times[i].second, time.second);
+            EXPECT_EQ(times[i].fraction, time.fraction);
+
+            SQL_SS_TIMESTAMPOFFSET_STRUCT offsetExpected;
+            TimeUtils::createTimestampOffsetStruct(column[i], 0, offset, offsetExpected);
+            EXPECT_EQ(tso[i].year, offsetExpected.year);
+            EXPECT_EQ(tso[i].day, offsetExpected.day);
+            EXPECT_EQ(tso[i].hour, offsetExpected.hour);
+            EXPECT_EQ(tso[i].fraction, offsetExpected.fraction);
+            EXPECT_EQ(tso[i].timezone_hour, offsetExpected.timezone_hour);
+            EXPECT_EQ(tso[i].timezone_minute, offsetExpected.timezone_minute);
+        }
+        EXPECT_EQ(ts[len - 1].year, 0);
+    }
+}
@@ -292,6 +292,35 @@ END`
     return waitsql
   }
 
+  polledQuery (c, sqlText) {
+    return new Promise((resolve, reject) => {
+      c.query(this.sql.PollingQuery(sqlText), (err, res) => {
+        if (err) reject(err)
+        else resolve(res)
+      })
+    })
+  }
+
+  // run one query on each of count new connections at once, sampling the
+  // executor pool and poller while they are in flight.
+  async concurrentQueries (count, run) {
+    const connections = await Promise.all(Array.from({ length: count }, () => this.sql.promises.open(this.connectionString)))
+    const peak = { busy: 0, polling: 0 }
+    const sample = () => {
+      const stats = this.sql.getExecutorStats()
+      peak.busy = Math.max(peak.busy, stats.busy)
+      peak.polling = Math.max(peak.polling, stats.polling)
+    }
+    const timer = setInterval(sample, 20)
+    try {
+      const results = await Promise.all(connections.map(c => run(c)))
+      return { results, peak }
+    } finally {
+      clearInterval(timer)
+      await Promise.all(connections.map(c => c.promises.close()))
+    }
+  }
+
   isEncryptedConnection () {
     return (this.connectionString.includes('ColumnEncryption=Enabled'))
   }
@@ -434,6 +434,26 @@ describe('bulk', function () {
         }
       )
     })
+
+    it('should bind string and BigInt decimals exactly', async function () {
+      const exact = '12345678901234567890.123456789012345678'
+      const res = await env.theConnection.promises.query(
+        'select cast(? as varchar(50)) as s, cast(? as varchar(50)) as b, cast(? as varchar(50)) as r',
+        [sql.Decimal(exact, 38, 18), sql.Numeric(-12345678901234567890123n, 38, 4), sql.Numeric('2.345', 10, 2)]
+      )
+      assert.strictEqual(res.first[0].s, exact)
+      assert.strictEqual(res.first[0].b, '-1234567890123456789.0123')
+      assert.strictEqual(res.first[0].r, '2.35')
+    })
+
+    it('should round string decimals to a declared scale of 0', async function () {
+      const res = await env.theConnection.promises.query(
+        'select cast(? as varchar(50)) as z, cast(? as varchar(50)) as u',
+        [sql.Numeric('2.5', 10, 0), sql.Numeric('2.5')]
+      )
+      assert.strictEqual(res.first[0].z, '3')
+      assert.strictEqual(res.first[0].u, '2.5')
+    })
   })
 
   // ========================================
@@ -676,6 +696,37 @@ describe('bulk', function () {
         }
       )
     })
+
+    it('should stream a large value with sql.Stream', async function () {
+      const { Readable } = require('stream')
+      const chunk = Buffer.alloc(64 * 1024, 7)
+      const chunks = 32
+      const binary = await env.theConnection.promises.query(
+        'declare @b varbinary(max) = ?; select datalength(@b) as len, substring(@b, 1, 4) as head',
+        [sql.Stream(Readable.from(Array(chunks).fill(chunk)))]
+      )
+      assert.strictEqual(binary.first[0].len, chunk.length * chunks)
+      assert.deepStrictEqual(binary.first[0].head, chunk.subarray(0, 4))
+
+      const text = 'é'.repeat(5000)
+      const wide = await env.theConnection.promises.query(
+        'declare @s nvarchar(max) = ?; select @s as s',
+        [sql.Stream(Readable.from([Buffer.from(text, 'utf8')]), { type: 'nvarchar' })]
+      )
+      assert.strictEqual(wide.first[0].s, text)
+    })
+
+    it('should fail a query when its parameter stream errors', async function () {
+      const { Readable } = require('stream')
+      const source = Readable.from((async function * () {
+        yield Buffer.alloc(1024)
+        throw new Error('source failed')
+      })())
+      await expect(
+        env.theConnection.promises.query('declare @b varbinary(max) = ?; select datalength(@b) as len',
+          [sql.Stream(source)])
+      ).to.be.rejectedWith('source failed')
+    })
   })
 
   // ========================================
@@ -943,6 +994,41 @@ describe('bulk', function () {
 
       sql.logger.info('TEST END: bind via a declare and insert', 'params.test')
     })
+
+    it('should bucket string parameter sizes into a stable signature', async function () {
+      const conn = env.theConnection
+      const promises = conn.promises
+      const lengths = Array.from({ length: 20 }, (_, i) => i + 1)
+
+      const sent = async (query) => {
+        const before = conn.getParamSignatureCount()
+        for (const len of lengths) {
+          const res = await promises.query(query, ['x'.repeat(len)])
+          assert.deepStrictEqual(res.first[0].v, 'x'.repeat(len))
+        }
+        return conn.getParamSignatureCount() - before
+      }
+
+      try {
+        assert.deepStrictEqual(await sent('select ? as v'), lengths.length)
+        conn.setParamSizeBuckets(true)
+        assert.deepStrictEqual(conn.getParamSizeBuckets(), [32, 128, 512, 4000])
+        assert.deepStrictEqual(await sent('select ? as v -- bucketed'), 1)
+      } finally {
+        conn.setParamSizeBuckets(false)
+      }
+    })
+
+    it('should bind user typed parameters through packed descriptors', async function () {
+      const { packParams } = require('../lib/param-descriptor')
+      const params = [sql.Decimal(12.34, 10, 2), sql.NVarChar('typed'), sql.Int(null), 7, sql.Money(1.5)]
+      const packed = packParams(params)
+      assert.instanceOf(packed.descriptors, Int32Array)
+      assert.deepStrictEqual(packed[3], 7)
+      const res = await env.theConnection.promises.query(
+        'select ? as d, ? as s, ? as n, ? as i, ? as m', params)
+      assert.deepStrictEqual(res.first[0], { d: 12.34, s: 'typed', n: null, i: 7, m: 1.5 })
+    })
   })
 
   // ========================================
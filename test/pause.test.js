@@ -436,6 +436,47 @@ describe('pause', function () {
     })
   })
 
+  describe('abandon', () => {
+    it('should stop a readable part way through a large result and free the statement', async function () {
+      const q = env.theConnection.query('select top 1000000 a.id, a.name from syscolumns a cross join syscolumns b')
+      const freed = new Promise(resolve => q.on('free', resolve))
+      let rows = 0
+      for await (const row of q.toReadable({ highWaterMark: 10 })) {
+        assert.isDefined(row.id)
+        if (++rows === 25) {
+          break
+        }
+      }
+      await freed
+      assert.strictEqual(rows, 25)
+      const after = await env.theConnection.promises.query(QUERIES.simple)
+      assert.strictEqual(after.first.length, 1)
+    })
+
+    it('should abandon a paused query and skip its remaining result sets', function (done) {
+      const q = env.theConnection.query(`${QUERIES.large}; ${QUERIES.large}`)
+      let rows = 0
+      let metas = 0
+      q.on('meta', () => metas++)
+      q.on('error', (e) => { assert.ifError(e) })
+      q.on('row', () => {
+        if (++rows === PAUSE_INTERVAL) {
+          q.pauseQuery()
+          setTimeout(() => {
+            q.abandonQuery(() => {
+              assert.strictEqual(rows, PAUSE_INTERVAL)
+              assert.strictEqual(metas, 1)
+              countQueryRows(env.theConnection, QUERIES.simple).then(count => {
+                assert.strictEqual(count, 1)
+                done()
+              }).catch(done)
+            })
+          }, PAUSE_CHECK_DELAY)
+        }
+      })
+    })
+  })
+
   describe('performance', () => {
     it('should handle large query without pause', function (done) {
       const q = env.theConnection.query(QUERIES.all)
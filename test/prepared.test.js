@@ -233,4 +233,98 @@ describe('prepared', function () {
     expect(res1.first[0]).to.deep.equal(o1)
     expect(res2.first[0]).to.deep.equal(o2)
   })
+
+  it('auto prepare re-executes ad hoc sql with varying params', async function handler () {
+    const max = parsedJSON.length
+    const text = `select * from ${tableName} where BusinessEntityID = ?`
+    theConnection.setAutoPrepare(2, 4)
+    assert.deepStrictEqual(theConnection.getAutoPrepare(), { threshold: 2, capacity: 4 })
+    assert.deepStrictEqual(theConnection.getStatementCache().autoPrepareThreshold, 2)
+    try {
+      for (let i = 0; i < 50; ++i) {
+        const businessId = i % max + 1
+        const res = await theConnection.promises.query(text, [businessId])
+        expect(res.first[0]).to.deep.equal(parsedJSON[businessId - 1])
+      }
+      const none = await theConnection.promises.query(text, [max + 100])
+      assert.deepStrictEqual(none.first.length, 0)
+    } finally {
+      theConnection.setAutoPrepare(0)
+    }
+  })
+
+  it('prepared re-execute with shorter, null and longer values', async function handler () {
+    const pq = await theConnection.promises.prepare('select ? as s, ? as n')
+    try {
+      const inputs = [['a longer string', 1], ['short', 2], [null, 3], ['', 4], ['longer than all before', 5], ['ab', 6]]
+      for (const [s, n] of inputs) {
+        const res = await pq.promises.query([s, n])
+        assert.deepStrictEqual(res.first[0], { s, n })
+      }
+    } finally {
+      await pq.promises.free()
+    }
+  })
+
+  it('executeMany runs every parameter set in one call', async function handler () {
+    const pq = await theConnection.promises.prepare(`select * from ${tableName} where BusinessEntityID = ?`)
+    try {
+      const sets = [[1], [2], [-1], ['not a number'], [3]]
+      const results = await pq.promises.executeMany(sets)
+      assert.deepStrictEqual(results.length, sets.length)
+      expect(results[0].rows[0]).to.deep.equal(parsedJSON[0])
+      expect(results[1].rows[0]).to.deep.equal(parsedJSON[1])
+      assert.deepStrictEqual(results[2].rows.length, 0)
+      assert.isTrue(results[3].errors.length > 0)
+      expect(results[4].rows[0]).to.deep.equal(parsedJSON[2])
+
+      const stopped = await pq.promises.executeMany(sets, { stopOnError: true })
+      assert.deepStrictEqual(stopped.length, 4)
+    } finally {
+      await pq.promises.free()
+    }
+  })
+
+  it('executeMany keeps string and binary values of every fetch and set', async function handler () {
+    const pq = await theConnection.promises.prepare(`select v.n,
+      concat(?, N'-', v.n) as s,
+      cast(concat(?, v.n) as varbinary(64)) as b
+      from (values (1), (2), (3), (4), (5)) v(n) order by v.n`)
+    try {
+      const sets = [['alpha', 'x'], ['beta', 'yy']]
+      // fewer rows per fetch than the result so each set takes several fetches
+      const results = await pq.promises.executeMany(sets, { batchSize: 2 })
+      assert.deepStrictEqual(results.length, sets.length)
+      results.forEach((r, i) => {
+        const [text, bin] = sets[i]
+        assert.deepStrictEqual(r.rows.length, 5)
+        r.rows.forEach((row, j) => {
+          const n = j + 1
+          assert.deepStrictEqual(row.s, `${text}-${n}`)
+          assert.deepStrictEqual(row.b, Buffer.from(`${bin}${n}`, 'utf16le'))
+        })
+      })
+    } finally {
+      await pq.promises.free()
+    }
+  })
+
+  it('statement cache re-uses a freed prepared statement', async function handler () {
+    const text = `select * from ${tableName} where BusinessEntityID = ?`
+    theConnection.setStatementCache({ capacity: 4 })
+    try {
+      const before = theConnection.getStatementCacheStats()
+      for (let i = 1; i <= 3; ++i) {
+        const pq = await theConnection.promises.prepare(text)
+        const res = await pq.promises.query([i])
+        expect(res.first[0]).to.deep.equal(parsedJSON[i - 1])
+        await pq.promises.free()
+      }
+      const after = theConnection.getStatementCacheStats()
+      assert.deepStrictEqual(after.hits - before.hits, 2)
+      assert.deepStrictEqual(after.size, 1)
+    } finally {
+      theConnection.setStatementCache({ capacity: 0 })
+    }
+  })
 })
@@ -286,6 +286,26 @@ describe('promises', function () {
     assert.deepStrictEqual(res.counts, expectedCounts)
   })
 
+  it('query aggregator: drained results match streamed ones, and past the cap', async function handler () {
+    const testSql = `with n as (select 1 as v union all select v + 1 from n where v < 2500)
+      select v, replicate('x', v % 50) as s from n option (maxrecursion 3000);
+      print 'between';
+      declare @t table (id int); insert into @t values (1), (2);
+      select 7 as w`
+    const streamed = await env.theConnection.promises.query(testSql, [], { drainMaxBytes: 0 })
+    expect(streamed.results[0].length).to.equal(2500)
+    for (const drainMaxBytes of [undefined, 1]) {
+      const opt = drainMaxBytes === undefined ? {} : { drainMaxBytes }
+      const res = await env.theConnection.promises.query(testSql, [], opt)
+      assert.deepStrictEqual(res.meta, streamed.meta)
+      assert.deepStrictEqual(res.results, streamed.results)
+      assert.deepStrictEqual(res.counts, streamed.counts)
+      assert.deepStrictEqual(res.info, streamed.info)
+    }
+    const after = await env.theConnection.promises.query('select 1 as n')
+    assert.deepStrictEqual(after.first, [{ n: 1 }])
+  })
+
   it('query aggregator: insert into invalid table', async function handler () {
     async function f0 () {
       const tableName = 'invalidTable'
@@ -133,6 +133,74 @@ describe('query', function () {
     return null
   })
 
+  it('records sampled handle lifecycle events only while diagnostics are enabled', async function handler () {
+    const logger = env.sql.logger
+    logger.setHandleDiagnostics({ enabled: true, sampleEvery: 1, capacity: 64 })
+    try {
+      await env.sql.promises.query(env.connectionString, 'select 1 as n')
+      const events = logger.getHandleEvents()
+      assert(events.some(e => e.name === 'Connection' && e.kind === 'alloc'))
+      assert(events.length <= 64)
+      assert(events.every(e => typeof e.stack === 'string' && e.sequence > 0))
+    } finally {
+      logger.setHandleDiagnostics({ enabled: false })
+    }
+    await env.sql.promises.query(env.connectionString, 'select 1 as n')
+    assert.strictEqual(logger.getHandleEvents().length, 0)
+  })
+
+  it('runs more blocking queries at once than the libuv pool has threads', async function handler () {
+    assert.strictEqual(env.sql.setExecutorThreads(32), 32)
+    // more waits than the default libuv pool of 4 threads, each holding an executor thread
+    const count = 6
+    const { results, peak } = await env.concurrentQueries(count, c => c.promises.query(`${env.waitForSql(2)} select 1 as v`))
+    results.forEach(res => assert.deepStrictEqual(res.first, [{ v: 1 }]))
+    assert.isAtLeast(peak.busy, count)
+    assert.strictEqual(peak.polling, 0)
+  })
+
+  it('polled queries completing at once are each delivered once', async function handler () {
+    // the poller can finish before the worker has returned from deferring
+    for (let i = 0; i < 20; ++i) {
+      const results = await Promise.all(Array.from({ length: 10 }, (_, j) => env.polledQuery(env.theConnection, `select ${i * 10 + j} as v`)))
+      results.forEach((res, j) => assert.deepStrictEqual(res, [{ v: i * 10 + j }]))
+    }
+  })
+
+  it('reads several result sets and frees the statement through the native pipeline', testDone => {
+    const results = []
+    let freed = false
+    const q = env.theConnection.query('select 1 as a; select 2 as b', (err, res, more) => {
+      assert.ifError(err)
+      if (res) results.push(res)
+      if (!more) {
+        q.on('free', () => {
+          freed = true
+          assert.deepStrictEqual(results, [[{ a: 1 }], [{ b: 2 }]])
+          env.theConnection.query('select 3 as c', (err, res) => {
+            assert.ifError(err)
+            assert.deepStrictEqual(res, [{ c: 3 }])
+            assert(freed)
+            testDone()
+          })
+        })
+      }
+    })
+  })
+
+  it('returns the same rows with and without a first batch read alongside the metadata', async function handler () {
+    const sql = 'with n as (select 1 as v union all select v + 1 from n where v < 120) select v from n option (maxrecursion 200); select 7 as w'
+    const expected = Array.from({ length: 120 }, (_, i) => ({ v: i + 1 }))
+    const promises = env.theConnection.promises
+    for (const firstBatchSize of [0, 10, 50, 500]) {
+      const res = await promises.query({ query_str: sql, first_batch_size: firstBatchSize })
+      assert.deepStrictEqual(res.results[0], expected, `first_batch_size ${firstBatchSize}`)
+      assert.deepStrictEqual(res.results[1], [{ w: 7 }], `first_batch_size ${firstBatchSize}`)
+    }
+    const single = await promises.query('select 1 as n')
+    assert.deepStrictEqual(single.first, [{ n: 1 }])
+  })
+
   it('test retrieving a string with null embedded', async function handler () {
     const embeddedNull = String.fromCharCode(65, 66, 67, 68, 0, 69, 70)
     const tableName = 'null_in_string_test'
@@ -706,4 +774,60 @@ describe('query', function () {
     expect(res.meta[0]).to.deep.equal(expectedMeta)
     expect(res.first).to.deep.equal(expectedData)
   })
+
+  it('exportQuery writes csv and ndjson to a file descriptor', async function handler () {
+    const fs = require('fs')
+    const os = require('os')
+    const path = require('path')
+    const sql = 'select v.id, v.s from (values (1, N\'a,b\'), (2, N\'say "hi"\'), (3, NULL)) as v(id, s) order by v.id'
+    const fileName = path.join(os.tmpdir(), `msnodesqlv8-export-${process.pid}.txt`)
+    const promises = env.theConnection.promises
+    const exportTo = async (options) => {
+      const fd = fs.openSync(fileName, 'w')
+      try {
+        const summary = await promises.exportQuery(sql, fd, options)
+        return { summary, text: fs.readFileSync(fileName, 'utf8') }
+      } finally {
+        fs.closeSync(fd)
+        fs.unlinkSync(fileName)
+      }
+    }
+
+    const csv = await exportTo({ format: 'csv', batchSize: 2 })
+    expect(csv.summary.rows).to.equal(3)
+    expect(csv.summary.bytes).to.equal(Buffer.byteLength(csv.text))
+    expect(csv.text).to.equal('id,s\n1,"a,b"\n2,"say ""hi"""\n3,\n')
+
+    const json = await exportTo({ format: 'ndjson' })
+    const rows = json.text.trim().split('\n').map(l => JSON.parse(l))
+    expect(rows).to.deep.equal([
+      { id: 1, s: 'a,b' },
+      { id: 2, s: 'say "hi"' },
+      { id: 3, s: null }
+    ])
+  })
+
+  it('exportQuery reports progress at most once per interval', async function handler () {
+    const fs = require('fs')
+    const os = require('os')
+    const path = require('path')
+    const sql = 'select top 10000 a.object_id as id from sys.all_objects a cross join sys.all_objects b'
+    const fileName = path.join(os.tmpdir(), `msnodesqlv8-export-progress-${process.pid}.txt`)
+    const fd = fs.openSync(fileName, 'w')
+    const calls = []
+    try {
+      const summary = await env.theConnection.promises.exportQuery(sql, fd, {
+        batchSize: 10,
+        progress: (rows, bytes) => calls.push({ rows, bytes })
+      })
+      expect(summary.rows).to.equal(10000)
+    } finally {
+      fs.closeSync(fd)
+      fs.unlinkSync(fileName)
+    }
+    // 1000 batches, the first reported at once and later ones throttled
+    expect(calls.length).to.be.greaterThan(0)
+    expect(calls.length).to.be.lessThan(1000)
+    expect(calls[0].rows).to.equal(10)
+  })
 })
@@ -203,6 +203,17 @@ it('cancel a call to proc that waits for delay of input param.', testDone => {
     })
   })
 
+  it('polled queries do not hold a worker thread while waiting', async function handler () {
+    // the waits are left on the poller, no executor thread is held for one
+    const count = 6
+    const { results, peak } = await env.concurrentQueries(count, c => env.polledQuery(c, `${env.waitForSql(2)} select 1 as v`))
+    results.forEach(res => assert.deepStrictEqual(res, [{ v: 1 }]))
+    assert.isAtLeast(peak.polling, count)
+    assert.isBelow(peak.busy, count)
+    const plain = await env.theConnection.promises.query('select 2 as v')
+    assert.deepStrictEqual(plain.first, [{ v: 2 }])
+  })
+
   it('cancel single query from notifier using tmp connection - expect Operation canceled', testDone => {
     const q = env.sql.query(env.connectionString, env.sql.PollingQuery(env.waitForSql(59)), err => {
       assert(err)
@@ -54,6 +54,32 @@ describe('tvp', function () {
     await checkTxt(tableName, vec)
   })
 
+  it('use tvp stream to insert rows in batches from an async iterable', async function handler () {
+    const tableName = 'TestTvp'
+    const helper = env.tvpHelper(tableName)
+    const promises = env.theConnection.promises
+    const table = await helper.create(tableName)
+    const count = 2500
+    async function * rows () {
+      for (let i = 0; i < count; ++i) {
+        yield {
+          description: `row ${i}`,
+          username: `user${i}`,
+          age: i,
+          salary: 100,
+          code: 12345.678,
+          start_date: new Date(2010, 1, 10)
+        }
+      }
+    }
+    const tp = env.sql.TvpStream(table, rows(), { batchSize: 1000 })
+    await promises.query('exec insertTestTvp @tvp = ?;', [tp])
+    const res = await promises.query(`select count(*) as n, sum(age) as ages, max(description) as last from ${tableName} where description like 'row %'`)
+    expect(res.first[0].n).to.equal(count)
+    expect(res.first[0].ages).to.equal(count * (count - 1) / 2)
+    expect(res.first[0].last).to.equal('row 999')
+  })
+
   async function namedtvp (tableName) {
     const helper = env.tvpHelper(tableName)
     const vec = helper.getVec(100)
@@ -255,4 +255,63 @@ describe('txn', function () {
     expect(res.meta[0]).to.deep.equal(expectedMeta)
     expect(res.first).to.deep.equal(expected)
   })
+
+  it('transaction batch commits every statement and returns each result', async function handler () {
+    const helper = env.bulkTableTest(activityTableDef)
+    await helper.create()
+    const promises = env.theConnection.promises
+    const res = await promises.transaction([
+      { sql: helper.insertParamsSql, params: [1, 'jogging'] },
+      { sql: helper.insertParamsSql, params: [2, 'sprinting'] },
+      { sql: helper.insertParamsSql, params: [3, 'walking'] },
+      helper.selectSql
+    ])
+    assert.isTrue(res.committed)
+    assert.deepStrictEqual(res.statements.length, 4)
+    assert.deepStrictEqual(res.statements[0].counts, [1])
+    expect(res.statements[3].first).to.deep.equal(expectedThreeActivity)
+    const results = await promises.query(helper.selectSql)
+    expect(results.first).to.deep.equal(expectedThreeActivity)
+  })
+
+  it('transaction batch rolls back at the first error and skips the rest', async function handler () {
+    const helper = env.bulkTableTest(activityTableDef)
+    await helper.create()
+    const promises = env.theConnection.promises
+    try {
+      await promises.transaction([
+        { sql: helper.insertParamsSql, params: [1, 'jogging'] },
+        { sql: helper.insertParamsSql, params: [1, 'sprinting'] },
+        { sql: helper.insertParamsSql, params: [3, 'walking'] }
+      ])
+      assert.fail('expected a constraint violation')
+    } catch (err) {
+      assert(err.message.includes('Violation of PRIMARY KEY'))
+      const res = err._results
+      assert.isFalse(res.committed)
+      assert.isTrue(res.rolledBack)
+      assert.isTrue(res.statements[0].executed)
+      assert.isFalse(res.statements[2].executed)
+    }
+    const results = await promises.query(helper.selectSql)
+    expect(results.first).to.deep.equal([])
+  })
+
+  it('transaction batch is refused inside an open transaction', async function handler () {
+    const helper = env.bulkTableTest(activityTableDef)
+    await helper.create()
+    const promises = env.theConnection.promises
+    await promises.beginTransaction()
+    try {
+      await expect(promises.transaction([
+        { sql: helper.insertParamsSql, params: [1, 'jogging'] }
+      ])).to.be.rejectedWith('commit or roll back first')
+    } finally {
+      await promises.rollback()
+    }
+    const res = await promises.transaction([
+      { sql: helper.insertParamsSql, params: [1, 'jogging'] }
+    ])
+    assert.isTrue(res.committed)
+  })
 })